@@ -0,0 +1,688 @@
+///////////////////////////////////////////////////////////////////////////////
+// assetcooker.cpp
+// ============
+// convert the source assets into runtime-ready files for the cook tool
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AssetCooker.h"
+#include "CookedAssets.h"
+#include "SceneFile.h"
+#include "TransformBatch.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// must be raised whenever the cooking of an asset changes,
+	// so every asset is cooked again
+	const uint32_t g_CookerVersion = 1;
+
+	// file listing the hash every cooked file was made from
+	const char* g_ManifestFilename = "cooked/manifest.txt";
+
+	// source folders and the extensions cooked from each
+	const char* g_TextureFolder = "textures";
+	const char* g_ShaderFolder = "shaders";
+	const char* g_SceneFolder = "scenes";
+	const char* const g_TextureExtensions[] = { ".jpg", ".jpeg", ".png", ".bmp", ".tga" };
+
+	// read a whole file, false when it cannot be read
+	bool ReadSourceFile(const std::string& filename, std::vector<unsigned char>& data)
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (false == file.is_open())
+		{
+			return(false);
+		}
+
+		std::streamoff size = file.tellg();
+		data.resize((size_t)size);
+		file.seekg(0);
+		file.read((char*)data.data(), size);
+
+		return(true == file.good());
+	}
+
+	// the files of a source folder with one of the extensions,
+	// sorted so the jobs come in the same order every time
+	std::vector<std::string> ListFolder(const char* folder, const char* const* extensions, int extensionCount)
+	{
+		std::vector<std::string> filenames;
+		std::error_code error;
+
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(folder, error))
+		{
+			if (false == entry.is_regular_file())
+			{
+				continue;
+			}
+
+			std::string extension = entry.path().extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return((char)tolower(c)); });
+			for (int i = 0; i < extensionCount; i++)
+			{
+				if (extension == extensions[i])
+				{
+					filenames.push_back(std::string(folder) + "/" + entry.path().filename().string());
+					break;
+				}
+			}
+		}
+
+		std::sort(filenames.begin(), filenames.end());
+		return(filenames);
+	}
+
+	// read the numbers of a scene record into the values
+	bool ReadFloats(std::istringstream& record, float* pValues, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (!(record >> pValues[i]))
+			{
+				return(false);
+			}
+		}
+		return(true);
+	}
+
+	// index of a tag in the scene tag table, adding it when
+	// new, -1 for "-", and -2 for a name too long for a tag
+	int FindSceneTag(
+		const std::string& name,
+		std::map<std::string, int>& tagIndices,
+		std::vector<SceneFile::SCENE_TAG>& tags)
+	{
+		if ("-" == name)
+		{
+			return(-1);
+		}
+		if (name.size() >= sizeof(SceneFile::SCENE_TAG::name))
+		{
+			return(-2);
+		}
+
+		std::map<std::string, int>::const_iterator found = tagIndices.find(name);
+		if (tagIndices.end() != found)
+		{
+			return(found->second);
+		}
+
+		SceneFile::SCENE_TAG tag = {};
+		memcpy(tag.name, name.data(), name.size());
+		tags.push_back(tag);
+		tagIndices[name] = (int)tags.size() - 1;
+
+		return((int)tags.size() - 1);
+	}
+}
+
+/***********************************************************
+ *  AssetCooker()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+AssetCooker::AssetCooker()
+{
+	m_bForce = false;
+	m_cookedCount = 0;
+	m_skippedCount = 0;
+	m_failedCount = 0;
+}
+
+/***********************************************************
+ *  AddJob()
+ *
+ *  This method is used for adding the job that cooks the
+ *  passed in source file. The mesh pack has no source file.
+ ***********************************************************/
+void AssetCooker::AddJob(ASSET_KIND kind, const std::string& sourceFilename)
+{
+	COOK_JOB job;
+	job.kind = kind;
+	job.sourceFilename = sourceFilename;
+	job.hash = 0;
+	job.result = COOK_PENDING;
+
+	switch (kind)
+	{
+	case ASSET_TEXTURE:
+		job.cookedFilename = CookedAssets::GetCookedFilename(sourceFilename, ".tex");
+		break;
+	case ASSET_MESH_PACK:
+		job.cookedFilename = CookedAssets::GetMeshPackFilename();
+		break;
+	case ASSET_SHADER:
+		job.cookedFilename = CookedAssets::GetCookedFilename(sourceFilename, NULL);
+		break;
+	case ASSET_SCENE:
+		job.cookedFilename = CookedAssets::GetCookedFilename(sourceFilename, ".scnb");
+		break;
+	}
+
+	m_jobs.push_back(job);
+}
+
+/***********************************************************
+ *  FindAssets()
+ *
+ *  This method is used for adding a job for every source
+ *  asset found in the source folders below the current
+ *  folder, and one for the mesh pack.
+ ***********************************************************/
+void AssetCooker::FindAssets()
+{
+	const char* const shaderExtensions[] = { ".glsl" };
+	const char* const sceneExtensions[] = { ".scene" };
+	const int textureExtensionCount = sizeof(g_TextureExtensions) / sizeof(g_TextureExtensions[0]);
+
+	m_jobs.clear();
+
+	for (const std::string& filename : ListFolder(g_TextureFolder, g_TextureExtensions, textureExtensionCount))
+	{
+		AddJob(ASSET_TEXTURE, filename);
+	}
+	AddJob(ASSET_MESH_PACK, "");
+	for (const std::string& filename : ListFolder(g_ShaderFolder, shaderExtensions, 1))
+	{
+		AddJob(ASSET_SHADER, filename);
+	}
+	for (const std::string& filename : ListFolder(g_SceneFolder, sceneExtensions, 1))
+	{
+		AddJob(ASSET_SCENE, filename);
+	}
+}
+
+/***********************************************************
+ *  LoadManifest()
+ *
+ *  This method is used for reading the hash every cooked
+ *  file was last cooked from. A missing manifest leaves
+ *  every asset to be cooked.
+ ***********************************************************/
+void AssetCooker::LoadManifest()
+{
+	m_manifest.clear();
+
+	std::ifstream file(g_ManifestFilename);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream record(line);
+		std::string hash;
+		std::string cookedFilename;
+		// the filename is the rest of the line, spaces and all
+		if ((record >> hash) && (std::getline(record >> std::ws, cookedFilename)))
+		{
+			m_manifest[cookedFilename] = strtoull(hash.c_str(), NULL, 16);
+		}
+	}
+}
+
+/***********************************************************
+ *  SaveManifest()
+ *
+ *  This method is used for writing the hash of every cooked
+ *  file that is up to date. A failed asset is left out, so
+ *  it is cooked again next time.
+ ***********************************************************/
+bool AssetCooker::SaveManifest() const
+{
+	std::ofstream file(g_ManifestFilename, std::ios::trunc);
+	if (false == file.is_open())
+	{
+		return(false);
+	}
+
+	for (const COOK_JOB& job : m_jobs)
+	{
+		if ((COOK_DONE == job.result) || (COOK_SKIPPED == job.result))
+		{
+			char hash[17];
+			snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)job.hash);
+			file << hash << " " << job.cookedFilename << "\n";
+		}
+	}
+
+	return(true == file.good());
+}
+
+/***********************************************************
+ *  Cook()
+ *
+ *  This method is used for cooking every found asset on the
+ *  worker pool, one job per chunk, and printing what became
+ *  of each of them. The manifest is only written once every
+ *  job is done.
+ ***********************************************************/
+bool AssetCooker::Cook(WorkerPool& workerPool)
+{
+	LoadManifest();
+
+	// the folders are made up front so the jobs never race
+	// to create the same folder
+	std::error_code error;
+	for (const COOK_JOB& job : m_jobs)
+	{
+		std::filesystem::create_directories(std::filesystem::path(job.cookedFilename).parent_path(), error);
+	}
+
+	// the images are flipped the way the application always
+	// loaded them, set once as the setting is shared
+	stbi_set_flip_vertically_on_load(true);
+
+	workerPool.ParallelFor((int)m_jobs.size(), 1, [this](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			RunJob(m_jobs[i]);
+		}
+	});
+
+	m_cookedCount = 0;
+	m_skippedCount = 0;
+	m_failedCount = 0;
+	for (const COOK_JOB& job : m_jobs)
+	{
+		const std::string& name = (true == job.sourceFilename.empty()) ? std::string("basic shapes") : job.sourceFilename;
+		switch (job.result)
+		{
+		case COOK_DONE:
+			printf("cooked   %s -> %s\n", name.c_str(), job.cookedFilename.c_str());
+			m_cookedCount++;
+			break;
+		case COOK_SKIPPED:
+			printf("skipped  %s\n", name.c_str());
+			m_skippedCount++;
+			break;
+		default:
+			printf("FAILED   %s: %s\n", name.c_str(), job.message.c_str());
+			m_failedCount++;
+			break;
+		}
+	}
+
+	if (false == SaveManifest())
+	{
+		printf("FAILED   could not write %s\n", g_ManifestFilename);
+		return(false);
+	}
+
+	return(0 == m_failedCount);
+}
+
+/***********************************************************
+ *  RunJob()
+ *
+ *  This method is used for hashing the source data of a job
+ *  and cooking it when the hash differs from the manifest or
+ *  the cooked file is gone. It runs on the worker threads,
+ *  so it only reads the manifest and writes its own job.
+ ***********************************************************/
+void AssetCooker::RunJob(COOK_JOB& job) const
+{
+	std::vector<unsigned char> source;
+	std::vector<MeshGeometry::MESH_DATA> meshes;
+
+	if (ASSET_MESH_PACK == job.kind)
+	{
+		// the shapes are built in code, so the built data
+		// stands in for the source file
+		meshes.resize(MeshGeometry::SHAPE_COUNT);
+		for (int shapeID = 0; shapeID < MeshGeometry::SHAPE_COUNT; shapeID++)
+		{
+			MeshGeometry::BuildShapeMesh(shapeID, meshes[shapeID]);
+		}
+	}
+	else if (false == ReadSourceFile(job.sourceFilename, source))
+	{
+		job.message = "could not read the source file";
+		job.result = COOK_FAILED;
+		return;
+	}
+
+	uint32_t kind = (uint32_t)job.kind;
+	uint32_t formatVersion = CookedAssets::FORMAT_VERSION;
+	uint64_t hash = CookedAssets::HashBytes(&kind, sizeof(kind));
+	hash = CookedAssets::HashBytes(&g_CookerVersion, sizeof(g_CookerVersion), hash);
+	hash = CookedAssets::HashBytes(&formatVersion, sizeof(formatVersion), hash);
+	hash = CookedAssets::HashBytes(source.data(), source.size(), hash);
+	for (const MeshGeometry::MESH_DATA& mesh : meshes)
+	{
+		hash = CookedAssets::HashBytes(mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshGeometry::VERTEX), hash);
+		hash = CookedAssets::HashBytes(mesh.indices.data(), mesh.indices.size() * sizeof(GLuint), hash);
+	}
+	job.hash = hash;
+
+	std::map<std::string, uint64_t>::const_iterator cooked = m_manifest.find(job.cookedFilename);
+	std::error_code error;
+	if ((false == m_bForce) &&
+		(m_manifest.end() != cooked) &&
+		(hash == cooked->second) &&
+		(true == std::filesystem::exists(job.cookedFilename, error)))
+	{
+		job.result = COOK_SKIPPED;
+		return;
+	}
+
+	bool bCooked = false;
+	switch (job.kind)
+	{
+	case ASSET_TEXTURE:
+		bCooked = CookTexture(job, source);
+		break;
+	case ASSET_MESH_PACK:
+		bCooked = CookMeshPack(job, meshes);
+		break;
+	case ASSET_SHADER:
+		bCooked = CookShader(job, source);
+		break;
+	case ASSET_SCENE:
+		bCooked = CookScene(job, source);
+		break;
+	}
+
+	job.result = (true == bCooked) ? COOK_DONE : COOK_FAILED;
+}
+
+/***********************************************************
+ *  CookTexture()
+ *
+ *  This method is used for decoding an image, building its
+ *  mipmap chain and writing the cooked texture. Gray images
+ *  are widened to RGB and RGBA, since the texture arrays
+ *  only hold three and four channel images.
+ ***********************************************************/
+bool AssetCooker::CookTexture(COOK_JOB& job, const std::vector<unsigned char>& source) const
+{
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+
+	if (0 == stbi_info_from_memory(source.data(), (int)source.size(), &width, &height, &colorChannels))
+	{
+		job.message = stbi_failure_reason();
+		return(false);
+	}
+
+	int cookedChannels = ((2 == colorChannels) || (4 == colorChannels)) ? 4 : 3;
+	unsigned char* image = stbi_load_from_memory(
+		source.data(),
+		(int)source.size(),
+		&width,
+		&height,
+		&colorChannels,
+		cookedChannels);
+	if (NULL == image)
+	{
+		job.message = stbi_failure_reason();
+		return(false);
+	}
+
+	std::vector<unsigned char> levels(image, image + (size_t)width * height * cookedChannels);
+	stbi_image_free(image);
+	CookedAssets::BuildMipChain(width, height, cookedChannels, levels);
+
+	if (false == CookedAssets::WriteTexture(job.cookedFilename.c_str(), width, height, cookedChannels, levels))
+	{
+		job.message = "could not write the cooked texture";
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CookMeshPack()
+ *
+ *  This method is used for writing the meshes of the basic
+ *  shapes, in shape ID order, into the mesh pack.
+ ***********************************************************/
+bool AssetCooker::CookMeshPack(COOK_JOB& job, const std::vector<MeshGeometry::MESH_DATA>& meshes) const
+{
+	if (false == CookedAssets::WriteMeshPack(job.cookedFilename.c_str(), meshes))
+	{
+		job.message = "could not write the mesh pack";
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CookShader()
+ *
+ *  This method is used for stripping the comments and the
+ *  indentation out of a shader and checking that it starts
+ *  with its #version line and that its brackets pair up.
+ *  The line breaks are kept, so the line numbers in the
+ *  driver's compile errors still match the source file. The
+ *  driver compiles the shader at startup either way - GLSL
+ *  has no format every driver loads precompiled.
+ ***********************************************************/
+bool AssetCooker::CookShader(COOK_JOB& job, const std::vector<unsigned char>& source) const
+{
+	std::string cooked;
+	std::string line;
+	int braceDepth = 0;
+	int parenthesisDepth = 0;
+	bool bLineComment = false;
+	bool bBlockComment = false;
+	bool bFirstCode = true;
+
+	cooked.reserve(source.size());
+	for (size_t i = 0; i <= source.size(); i++)
+	{
+		char c = (i < source.size()) ? (char)source[i] : '\n';
+		char next = (i + 1 < source.size()) ? (char)source[i + 1] : '\0';
+
+		if ('\n' == c)
+		{
+			// trailing spaces and a carriage return go with the
+			// rest of the line's whitespace
+			size_t last = line.find_last_not_of(" \t\r");
+			line.erase((std::string::npos == last) ? 0 : last + 1);
+			if ((true == bFirstCode) && (false == line.empty()))
+			{
+				if (0 != line.compare(0, 8, "#version"))
+				{
+					job.message = "the shader does not start with #version";
+					return(false);
+				}
+				bFirstCode = false;
+			}
+
+			if (i < source.size())
+			{
+				cooked += line;
+				cooked += '\n';
+			}
+			line.clear();
+			bLineComment = false;
+			continue;
+		}
+
+		if (true == bLineComment)
+		{
+			continue;
+		}
+		if (true == bBlockComment)
+		{
+			if (('*' == c) && ('/' == next))
+			{
+				bBlockComment = false;
+				i++;
+			}
+			continue;
+		}
+		if (('/' == c) && ('/' == next))
+		{
+			bLineComment = true;
+			continue;
+		}
+		if (('/' == c) && ('*' == next))
+		{
+			bBlockComment = true;
+			i++;
+			// keep the tokens on both sides of the comment apart
+			line += ' ';
+			continue;
+		}
+
+		if ((true == line.empty()) && ((' ' == c) || ('\t' == c)))
+		{
+			continue;
+		}
+
+		braceDepth += ('{' == c) ? 1 : (('}' == c) ? -1 : 0);
+		parenthesisDepth += ('(' == c) ? 1 : ((')' == c) ? -1 : 0);
+		if ((braceDepth < 0) || (parenthesisDepth < 0))
+		{
+			job.message = "unmatched closing bracket";
+			return(false);
+		}
+		line += c;
+	}
+
+	if ((true == bBlockComment) || (0 != braceDepth) || (0 != parenthesisDepth) || (true == bFirstCode))
+	{
+		job.message = (true == bFirstCode) ? "the shader is empty" : "unterminated comment or bracket";
+		return(false);
+	}
+
+	std::ofstream file(job.cookedFilename, std::ios::binary | std::ios::trunc);
+	file.write(cooked.data(), cooked.size());
+	if (false == file.good())
+	{
+		job.message = "could not write the cooked shader";
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CookScene()
+ *
+ *  This method is used for parsing a scene description into
+ *  the tables of a binary scene file. Every line is checked,
+ *  and the first bad one fails the scene with its line
+ *  number.
+ ***********************************************************/
+bool AssetCooker::CookScene(COOK_JOB& job, const std::vector<unsigned char>& source) const
+{
+	std::vector<SceneFile::SCENE_NODE> nodes;
+	std::vector<SceneFile::SCENE_OBJECT> objects;
+	std::vector<SceneFile::SCENE_TAG> tags;
+	std::map<std::string, int> tagIndices;
+
+	std::istringstream text(std::string(source.begin(), source.end()));
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(text, line))
+	{
+		lineNumber++;
+
+		size_t comment = line.find('#');
+		if (std::string::npos != comment)
+		{
+			line.erase(comment);
+		}
+
+		std::istringstream record(line);
+		std::string type;
+		if (!(record >> type))
+		{
+			continue;
+		}
+
+		bool bValid = false;
+		if ("node" == type)
+		{
+			SceneFile::SCENE_NODE node = {};
+			bValid = (record >> node.parent) &&
+				(node.parent >= -1) && (node.parent < (int)nodes.size()) &&
+				(true == ReadFloats(record, node.scaleXYZ, 3)) &&
+				(true == ReadFloats(record, node.rotationDegrees, 3)) &&
+				(true == ReadFloats(record, node.positionXYZ, 3));
+			if (true == bValid)
+			{
+				nodes.push_back(node);
+			}
+		}
+		else if ("object" == type)
+		{
+			SceneFile::SCENE_OBJECT object = {};
+			std::string shape;
+			std::string material;
+			std::string texture;
+			float transform[9];
+			bValid = (record >> object.node) && (record >> shape) && (record >> material) && (record >> texture) &&
+				(object.node >= -1) && (object.node < (int)nodes.size()) &&
+				(true == ReadFloats(record, object.color, 4)) &&
+				(true == ReadFloats(record, object.UVscale, 2)) &&
+				(true == ReadFloats(record, transform, 9));
+
+			int shapeID = -1;
+			if (true == bValid)
+			{
+				shapeID = MeshGeometry::FindShape(shape.c_str());
+				object.materialTag = FindSceneTag(material, tagIndices, tags);
+				object.textureTag = FindSceneTag(texture, tagIndices, tags);
+				bValid = (shapeID >= 0) && (object.materialTag >= -1) && (object.textureTag >= -1);
+			}
+
+			std::string flag;
+			if (record >> flag)
+			{
+				bValid = bValid && ("dynamic" == flag);
+				object.flags = SceneFile::OBJECT_DYNAMIC;
+			}
+
+			if (true == bValid)
+			{
+				glm::mat4 model = TransformBatch::ComposeMatrix(
+					glm::vec3(transform[0], transform[1], transform[2]),
+					glm::vec3(transform[3], transform[4], transform[5]),
+					glm::vec3(transform[6], transform[7], transform[8]));
+				for (int column = 0; column < 4; column++)
+				{
+					object.localModel[column][0] = model[column][0];
+					object.localModel[column][1] = model[column][1];
+					object.localModel[column][2] = model[column][2];
+				}
+				object.meshID = (uint32_t)shapeID;
+				objects.push_back(object);
+			}
+		}
+
+		std::string extra;
+		if ((false == bValid) || (record >> extra))
+		{
+			job.message = "bad record on line " + std::to_string(lineNumber);
+			return(false);
+		}
+	}
+
+	if (false == SceneFile::Write(job.cookedFilename.c_str(), nodes, objects, tags))
+	{
+		job.message = "could not write the scene file";
+		return(false);
+	}
+
+	return(true);
+}
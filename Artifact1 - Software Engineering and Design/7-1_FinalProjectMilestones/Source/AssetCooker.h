@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+// assetcooker.h
+// ============
+// convert the source assets into runtime-ready files for the cook tool
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+#include "WorkerPool.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  AssetCooker
+ *
+ *  This class converts the source assets of the application
+ *  into the files it loads at startup:
+ *
+ *    images in textures   decoded, flipped and mipmapped
+ *                         into cooked/textures as .tex
+ *    basic shapes         built into cooked/meshes.mpk
+ *    .glsl in shaders     stripped of comments and checked
+ *                         into cooked/shaders
+ *    .scene in scenes     parsed into binary scene files in
+ *                         cooked/scenes as .scnb
+ *
+ *  Every cooked file is keyed by a hash of its source data
+ *  and the cooker version, kept in cooked/manifest.txt, so
+ *  a cooked file whose source has not changed is skipped.
+ *  The assets are cooked in parallel on a worker pool.
+ *
+ *  A scene description holds one record per line, numbers
+ *  separated by spaces and '#' starting a comment:
+ *
+ *    node <parent> <scale xyz> <rotation xyz> <position xyz>
+ *    object <node> <shape> <material> <texture> <color rgba>
+ *        <UV scale uv> <scale xyz> <rotation xyz>
+ *        <position xyz> [dynamic]
+ *
+ *  A node refers to an earlier node as its parent, or -1
+ *  for none, and an object to a node, or -1 for world
+ *  space. The shape is a basic shape name such as "box",
+ *  and a material or texture of "-" is none.
+ ***********************************************************/
+class AssetCooker
+{
+public:
+	// constructor
+	AssetCooker();
+
+	// find every source asset below the current folder
+	void FindAssets();
+	// cook the assets even when the manifest says they are
+	// up to date
+	void SetForce(bool bForce) { m_bForce = bForce; }
+	// cook every found asset that changed, false on any error
+	bool Cook(WorkerPool& workerPool);
+
+	// outcome counts of the last Cook()
+	int GetCookedCount() const { return(m_cookedCount); }
+	int GetSkippedCount() const { return(m_skippedCount); }
+	int GetFailedCount() const { return(m_failedCount); }
+
+private:
+	enum ASSET_KIND
+	{
+		ASSET_TEXTURE = 0,
+		ASSET_MESH_PACK,
+		ASSET_SHADER,
+		ASSET_SCENE
+	};
+
+	enum COOK_RESULT
+	{
+		COOK_PENDING = 0,
+		COOK_DONE,
+		COOK_SKIPPED,
+		COOK_FAILED
+	};
+
+	// one asset to cook, filled in by the worker cooking it
+	struct COOK_JOB
+	{
+		ASSET_KIND kind;
+		std::string sourceFilename;
+		std::string cookedFilename;
+		// hash of the source data, the kind and the cooker
+		// version
+		uint64_t hash;
+		COOK_RESULT result;
+		// reason the cooking failed
+		std::string message;
+	};
+
+	std::vector<COOK_JOB> m_jobs;
+	// hash of every cooked file when it was last cooked,
+	// read before cooking and only changed after it
+	std::map<std::string, uint64_t> m_manifest;
+	bool m_bForce;
+	int m_cookedCount;
+	int m_skippedCount;
+	int m_failedCount;
+
+	// add the job for a source file
+	void AddJob(ASSET_KIND kind, const std::string& sourceFilename);
+	// read and write the hashes of the cooked files
+	void LoadManifest();
+	bool SaveManifest() const;
+
+	// hash, then cook a job unless it is up to date
+	void RunJob(COOK_JOB& job) const;
+	bool CookTexture(COOK_JOB& job, const std::vector<unsigned char>& source) const;
+	bool CookMeshPack(COOK_JOB& job, const std::vector<MeshGeometry::MESH_DATA>& meshes) const;
+	bool CookShader(COOK_JOB& job, const std::vector<unsigned char>& source) const;
+	bool CookScene(COOK_JOB& job, const std::vector<unsigned char>& source) const;
+};
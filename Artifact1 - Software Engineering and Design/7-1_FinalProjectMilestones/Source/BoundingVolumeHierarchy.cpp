@@ -0,0 +1,577 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.cpp
+// ============
+// tree of boxes over the world bounds of the scene objects for spatial queries
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cfloat>
+
+// the nodes are read in place, so their size must not change
+static_assert(sizeof(BoundingVolumeHierarchy::BVH_NODE) == 32, "bvh node must be 32 bytes");
+
+// declaration of global variables
+namespace
+{
+	// bins the centers are sorted into along each axis, the
+	// split is only tried on their borders
+	const int g_BinCount = 12;
+	// cost of visiting a node against testing one item
+	const float g_TraversalCost = 1.0f;
+	// a node keeps being split while it holds more items than
+	// this, even when the split costs more
+	const int g_MaxLeafItems = 8;
+	// deepest node, which bounds the traversal stacks - a node
+	// this deep is a leaf whatever its item count
+	const int g_MaxDepth = 64;
+
+	// an empty box, which any merged box replaces
+	MeshGeometry::MESH_BOUNDS EmptyBounds()
+	{
+		MeshGeometry::MESH_BOUNDS bounds;
+		bounds.minPoint = glm::vec3(FLT_MAX);
+		bounds.maxPoint = glm::vec3(-FLT_MAX);
+		return(bounds);
+	}
+
+	// half the surface area of a box, 0 for an empty box
+	float HalfArea(const MeshGeometry::MESH_BOUNDS& bounds)
+	{
+		glm::vec3 size = bounds.maxPoint - bounds.minPoint;
+		if ((size.x < 0.0f) || (size.y < 0.0f) || (size.z < 0.0f))
+		{
+			return(0.0f);
+		}
+		return(size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	// check whether a box reaches into a sphere
+	bool IsBoundsInSphere(glm::vec3 minPoint, glm::vec3 maxPoint, glm::vec3 center, float radius)
+	{
+		glm::vec3 offset = glm::clamp(center, minPoint, maxPoint) - center;
+		return(glm::dot(offset, offset) <= radius * radius);
+	}
+
+	// distance along a ray to where it enters a box, FLT_MAX
+	// when it misses
+	float IntersectRay(glm::vec3 minPoint, glm::vec3 maxPoint, glm::vec3 origin, glm::vec3 inverseDirection)
+	{
+		glm::vec3 t0 = (minPoint - origin) * inverseDirection;
+		glm::vec3 t1 = (maxPoint - origin) * inverseDirection;
+		glm::vec3 tNear = glm::min(t0, t1);
+		glm::vec3 tFar = glm::max(t0, t1);
+		float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		float exit = std::min(std::min(tFar.x, tFar.y), tFar.z);
+
+		return((enter <= exit) ? enter : FLT_MAX);
+	}
+}
+
+/***********************************************************
+ *  BoundingVolumeHierarchy()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+{
+	m_stats = { 0, 0, 0, 0 };
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every item and node.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Clear()
+{
+	m_nodes.clear();
+	m_parents.clear();
+	m_itemOrder.clear();
+	m_itemBounds.clear();
+	m_itemLeaves.clear();
+	m_movedLeaves.clear();
+	m_leafMoved.clear();
+	m_stats = { 0, 0, 0, 0 };
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the tree over the
+ *  passed in item boxes, replacing the last tree. The boxes
+ *  are copied, so the tree can be refit on its own.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Build(const std::vector<MeshGeometry::MESH_BOUNDS>& itemBounds)
+{
+	Clear();
+
+	int itemCount = (int)itemBounds.size();
+	m_itemBounds = itemBounds;
+	m_itemLeaves.assign(itemCount, -1);
+	m_itemOrder.resize(itemCount);
+
+	std::vector<glm::vec3> centers(itemCount);
+	for (int item = 0; item < itemCount; item++)
+	{
+		m_itemOrder[item] = item;
+		centers[item] = 0.5f * (itemBounds[item].minPoint + itemBounds[item].maxPoint);
+	}
+
+	if (0 == itemCount)
+	{
+		return;
+	}
+
+	// a binary tree with leaves of one or more items has
+	// fewer than twice as many nodes as items
+	m_nodes.reserve(2 * itemCount);
+	m_parents.reserve(2 * itemCount);
+	BuildNode(0, itemCount, -1, 1, centers);
+
+	m_leafMoved.assign(m_nodes.size(), 0);
+	m_stats.nodes = (int)m_nodes.size();
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for adding the node around a run of
+ *  the item order and splitting it. The centers of the items
+ *  are sorted into bins along each axis, and the cost of
+ *  splitting at every bin border is the area of each side
+ *  times its item count. The run is split at the cheapest
+ *  border when that beats testing every item, or when the
+ *  run holds too many items for a leaf.
+ ***********************************************************/
+int BoundingVolumeHierarchy::BuildNode(int first, int count, int parent, int depth, const std::vector<glm::vec3>& centers)
+{
+	int node = (int)m_nodes.size();
+	m_nodes.push_back(BVH_NODE());
+	m_parents.push_back(parent);
+	if (depth > m_stats.depth)
+	{
+		m_stats.depth = depth;
+	}
+
+	MeshGeometry::MESH_BOUNDS bounds = EmptyBounds();
+	MeshGeometry::MESH_BOUNDS centerBounds = EmptyBounds();
+	for (int i = first; i < first + count; i++)
+	{
+		int item = m_itemOrder[i];
+		MeshGeometry::MergeBounds(bounds, m_itemBounds[item]);
+		centerBounds.minPoint = glm::min(centerBounds.minPoint, centers[item]);
+		centerBounds.maxPoint = glm::max(centerBounds.maxPoint, centers[item]);
+	}
+	m_nodes[node].minPoint = bounds.minPoint;
+	m_nodes[node].maxPoint = bounds.maxPoint;
+
+	int bestAxis = -1;
+	int bestBin = 0;
+	float bestCost = FLT_MAX;
+	glm::vec3 centerExtent = centerBounds.maxPoint - centerBounds.minPoint;
+
+	for (int axis = 0; (count > 1) && (axis < 3); axis++)
+	{
+		// the items all have the same center along this axis
+		if (centerExtent[axis] <= 0.0f)
+		{
+			continue;
+		}
+
+		MeshGeometry::MESH_BOUNDS binBounds[g_BinCount];
+		int binCounts[g_BinCount] = {};
+		for (int bin = 0; bin < g_BinCount; bin++)
+		{
+			binBounds[bin] = EmptyBounds();
+		}
+
+		float binScale = g_BinCount / centerExtent[axis];
+		for (int i = first; i < first + count; i++)
+		{
+			int item = m_itemOrder[i];
+			int bin = std::min(g_BinCount - 1, (int)((centers[item][axis] - centerBounds.minPoint[axis]) * binScale));
+			binCounts[bin]++;
+			MeshGeometry::MergeBounds(binBounds[bin], m_itemBounds[item]);
+		}
+
+		// sweep from the right to find the area and count on the
+		// right of each border, then from the left to price them
+		float rightAreas[g_BinCount];
+		int rightCounts[g_BinCount];
+		MeshGeometry::MESH_BOUNDS rightBounds = EmptyBounds();
+		int rightCount = 0;
+		for (int bin = g_BinCount - 1; bin > 0; bin--)
+		{
+			MeshGeometry::MergeBounds(rightBounds, binBounds[bin]);
+			rightCount += binCounts[bin];
+			rightAreas[bin] = HalfArea(rightBounds);
+			rightCounts[bin] = rightCount;
+		}
+
+		MeshGeometry::MESH_BOUNDS leftBounds = EmptyBounds();
+		int leftCount = 0;
+		for (int bin = 0; bin < g_BinCount - 1; bin++)
+		{
+			MeshGeometry::MergeBounds(leftBounds, binBounds[bin]);
+			leftCount += binCounts[bin];
+			if ((0 == leftCount) || (0 == rightCounts[bin + 1]))
+			{
+				continue;
+			}
+
+			float cost = HalfArea(leftBounds) * leftCount + rightAreas[bin + 1] * rightCounts[bin + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = bin;
+			}
+		}
+	}
+
+	// the split cost is relative to the area of the node
+	float nodeArea = HalfArea(bounds);
+	float splitCost = (nodeArea > 0.0f) ? g_TraversalCost + bestCost / nodeArea : g_TraversalCost;
+	bool bSplit = (count > 1) && (depth < g_MaxDepth) &&
+		((count > g_MaxLeafItems) || ((bestAxis >= 0) && (splitCost < (float)count)));
+
+	int leftCount = 0;
+	if ((true == bSplit) && (bestAxis >= 0))
+	{
+		float binScale = g_BinCount / centerExtent[bestAxis];
+		float minCenter = centerBounds.minPoint[bestAxis];
+		std::vector<int>::iterator middle = std::partition(
+			m_itemOrder.begin() + first,
+			m_itemOrder.begin() + first + count,
+			[&centers, bestAxis, bestBin, binScale, minCenter](int item)
+			{
+				int bin = std::min(g_BinCount - 1, (int)((centers[item][bestAxis] - minCenter) * binScale));
+				return(bin <= bestBin);
+			});
+		leftCount = (int)(middle - (m_itemOrder.begin() + first));
+	}
+	else if (true == bSplit)
+	{
+		// every center is the same, so any split is as good -
+		// the run is halved to keep the leaves small
+		leftCount = count / 2;
+	}
+
+	if ((false == bSplit) || (leftCount <= 0) || (leftCount >= count))
+	{
+		m_nodes[node].firstOrChild = first;
+		m_nodes[node].itemCount = count;
+		for (int i = first; i < first + count; i++)
+		{
+			m_itemLeaves[m_itemOrder[i]] = node;
+		}
+		m_stats.leaves++;
+		return(node);
+	}
+
+	// the first child is added right after the node, so only
+	// the second child needs to be stored
+	BuildNode(first, leftCount, node, depth + 1, centers);
+	int secondChild = BuildNode(first + leftCount, count - leftCount, node, depth + 1, centers);
+	m_nodes[node].firstOrChild = secondChild;
+	m_nodes[node].itemCount = 0;
+
+	return(node);
+}
+
+/***********************************************************
+ *  SetItemBounds()
+ *
+ *  This method is used for changing the box of a moved
+ *  item. The leaf holding the item is listed for the next
+ *  refit.
+ ***********************************************************/
+void BoundingVolumeHierarchy::SetItemBounds(int item, const MeshGeometry::MESH_BOUNDS& bounds)
+{
+	if ((item < 0) || (item >= (int)m_itemBounds.size()))
+	{
+		return;
+	}
+
+	m_itemBounds[item] = bounds;
+
+	int leaf = m_itemLeaves[item];
+	if (0 == m_leafMoved[leaf])
+	{
+		m_leafMoved[leaf] = 1;
+		m_movedLeaves.push_back(leaf);
+	}
+}
+
+/***********************************************************
+ *  FitNode()
+ *
+ *  This method is used for fitting the box of a node around
+ *  its items, for a leaf, or around its two children.
+ ***********************************************************/
+bool BoundingVolumeHierarchy::FitNode(int node)
+{
+	BVH_NODE& bvhNode = m_nodes[node];
+	MeshGeometry::MESH_BOUNDS bounds = EmptyBounds();
+
+	if (bvhNode.itemCount > 0)
+	{
+		for (int i = bvhNode.firstOrChild; i < bvhNode.firstOrChild + bvhNode.itemCount; i++)
+		{
+			MeshGeometry::MergeBounds(bounds, m_itemBounds[m_itemOrder[i]]);
+		}
+	}
+	else
+	{
+		const BVH_NODE& firstChild = m_nodes[node + 1];
+		const BVH_NODE& secondChild = m_nodes[bvhNode.firstOrChild];
+		bounds.minPoint = glm::min(firstChild.minPoint, secondChild.minPoint);
+		bounds.maxPoint = glm::max(firstChild.maxPoint, secondChild.maxPoint);
+	}
+
+	if ((bounds.minPoint == bvhNode.minPoint) && (bounds.maxPoint == bvhNode.maxPoint))
+	{
+		return(false);
+	}
+
+	bvhNode.minPoint = bounds.minPoint;
+	bvhNode.maxPoint = bounds.maxPoint;
+	return(true);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for fitting the nodes to the moved
+ *  items. Each listed leaf is fit around its items, then its
+ *  parents are fit around their children up to the first
+ *  parent whose box stays the same, so only the nodes above
+ *  the moved items are visited.
+ ***********************************************************/
+int BoundingVolumeHierarchy::Refit()
+{
+	m_stats.nodesRefit = 0;
+
+	for (int leaf : m_movedLeaves)
+	{
+		m_leafMoved[leaf] = 0;
+		for (int node = leaf; (node >= 0) && (true == FitNode(node)); node = m_parents[node])
+		{
+			m_stats.nodesRefit++;
+		}
+	}
+	m_movedLeaves.clear();
+
+	return(m_stats.nodesRefit);
+}
+
+/***********************************************************
+ *  QueryFrustum()
+ *
+ *  This method is used for finding the items whose boxes are
+ *  at least partly inside the frustum planes, with the same
+ *  test as MeshGeometry::IsBoundsInFrustum(). A node fully
+ *  in front of a plane passes that plane on to its children
+ *  as already tested, so the items of a node fully inside
+ *  the frustum are taken without testing them.
+ ***********************************************************/
+void BoundingVolumeHierarchy::QueryFrustum(const glm::vec4 planes[6], std::vector<int>& items) const
+{
+	items.clear();
+	if (true == m_nodes.empty())
+	{
+		return;
+	}
+
+	// every stack entry keeps the planes still to be tested
+	int nodeStack[g_MaxDepth + 1];
+	int maskStack[g_MaxDepth + 1];
+	int stackSize = 0;
+	nodeStack[stackSize] = 0;
+	maskStack[stackSize] = 0x3F;
+	stackSize++;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+		int node = nodeStack[stackSize];
+		int planeMask = maskStack[stackSize];
+
+		while (true)
+		{
+			const BVH_NODE& bvhNode = m_nodes[node];
+
+			bool bOutside = false;
+			for (int i = 0; (i < 6) && (false == bOutside); i++)
+			{
+				if (0 == (planeMask & (1 << i)))
+				{
+					continue;
+				}
+
+				const glm::vec4& plane = planes[i];
+				glm::vec3 farCorner(
+					(plane.x >= 0.0f) ? bvhNode.maxPoint.x : bvhNode.minPoint.x,
+					(plane.y >= 0.0f) ? bvhNode.maxPoint.y : bvhNode.minPoint.y,
+					(plane.z >= 0.0f) ? bvhNode.maxPoint.z : bvhNode.minPoint.z);
+				glm::vec3 nearCorner(
+					(plane.x >= 0.0f) ? bvhNode.minPoint.x : bvhNode.maxPoint.x,
+					(plane.y >= 0.0f) ? bvhNode.minPoint.y : bvhNode.maxPoint.y,
+					(plane.z >= 0.0f) ? bvhNode.minPoint.z : bvhNode.maxPoint.z);
+
+				if (glm::dot(glm::vec3(plane), farCorner) + plane.w < 0.0f)
+				{
+					bOutside = true;
+				}
+				else if (glm::dot(glm::vec3(plane), nearCorner) + plane.w >= 0.0f)
+				{
+					planeMask &= ~(1 << i);
+				}
+			}
+
+			if (true == bOutside)
+			{
+				break;
+			}
+
+			if (bvhNode.itemCount > 0)
+			{
+				for (int i = bvhNode.firstOrChild; i < bvhNode.firstOrChild + bvhNode.itemCount; i++)
+				{
+					int item = m_itemOrder[i];
+					if ((0 == planeMask) || (true == MeshGeometry::IsBoundsInFrustum(m_itemBounds[item], planes)))
+					{
+						items.push_back(item);
+					}
+				}
+				break;
+			}
+
+			// go on with the first child, the second waits
+			nodeStack[stackSize] = bvhNode.firstOrChild;
+			maskStack[stackSize] = planeMask;
+			stackSize++;
+			node = node + 1;
+		}
+	}
+}
+
+/***********************************************************
+ *  QuerySphere()
+ *
+ *  This method is used for finding the items whose boxes
+ *  reach into a sphere - the point of each box closest to
+ *  the center is inside the radius - such as the range of
+ *  a point light.
+ ***********************************************************/
+void BoundingVolumeHierarchy::QuerySphere(glm::vec3 center, float radius, std::vector<int>& items) const
+{
+	items.clear();
+	if (true == m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[g_MaxDepth + 1];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		int node = nodeStack[--stackSize];
+		const BVH_NODE& bvhNode = m_nodes[node];
+		if (false == IsBoundsInSphere(bvhNode.minPoint, bvhNode.maxPoint, center, radius))
+		{
+			continue;
+		}
+
+		if (bvhNode.itemCount > 0)
+		{
+			for (int i = bvhNode.firstOrChild; i < bvhNode.firstOrChild + bvhNode.itemCount; i++)
+			{
+				int item = m_itemOrder[i];
+				if (true == IsBoundsInSphere(m_itemBounds[item].minPoint, m_itemBounds[item].maxPoint, center, radius))
+				{
+					items.push_back(item);
+				}
+			}
+			continue;
+		}
+
+		nodeStack[stackSize++] = bvhNode.firstOrChild;
+		nodeStack[stackSize++] = node + 1;
+	}
+}
+
+/***********************************************************
+ *  Raycast()
+ *
+ *  This method is used for finding the item whose box a ray
+ *  enters first. The nearer child of a node is visited
+ *  first, and a node is skipped once the ray enters it past
+ *  the nearest hit found so far. A ray starting inside a
+ *  box hits it at distance 0.
+ ***********************************************************/
+int BoundingVolumeHierarchy::Raycast(glm::vec3 origin, glm::vec3 direction, float& hitDistance) const
+{
+	hitDistance = FLT_MAX;
+	if (true == m_nodes.empty())
+	{
+		return(-1);
+	}
+
+	// a zero direction component gives an infinite inverse,
+	// which the slab test handles
+	glm::vec3 inverseDirection = 1.0f / direction;
+	int hitItem = -1;
+
+	int nodeStack[g_MaxDepth + 1];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		int node = nodeStack[--stackSize];
+		const BVH_NODE& bvhNode = m_nodes[node];
+		if (IntersectRay(bvhNode.minPoint, bvhNode.maxPoint, origin, inverseDirection) >= hitDistance)
+		{
+			continue;
+		}
+
+		if (bvhNode.itemCount > 0)
+		{
+			for (int i = bvhNode.firstOrChild; i < bvhNode.firstOrChild + bvhNode.itemCount; i++)
+			{
+				int item = m_itemOrder[i];
+				float distance = IntersectRay(m_itemBounds[item].minPoint, m_itemBounds[item].maxPoint, origin, inverseDirection);
+				if (distance < hitDistance)
+				{
+					hitDistance = distance;
+					hitItem = item;
+				}
+			}
+			continue;
+		}
+
+		// the nearer child goes on top of the stack
+		int firstChild = node + 1;
+		int secondChild = bvhNode.firstOrChild;
+		float firstDistance = IntersectRay(m_nodes[firstChild].minPoint, m_nodes[firstChild].maxPoint, origin, inverseDirection);
+		float secondDistance = IntersectRay(m_nodes[secondChild].minPoint, m_nodes[secondChild].maxPoint, origin, inverseDirection);
+		if (firstDistance < secondDistance)
+		{
+			nodeStack[stackSize++] = secondChild;
+			nodeStack[stackSize++] = firstChild;
+		}
+		else
+		{
+			nodeStack[stackSize++] = firstChild;
+			nodeStack[stackSize++] = secondChild;
+		}
+	}
+
+	return(hitItem);
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.h
+// ============
+// tree of boxes over the world bounds of the scene objects for spatial queries
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  BoundingVolumeHierarchy
+ *
+ *  This class builds a binary tree of axis aligned boxes
+ *  over a set of items, each item being the world space box
+ *  of a scene object, so a query only visits the items in
+ *  the branches it reaches instead of every object.
+ *
+ *  The tree is built top down. Each node is split where the
+ *  surface area heuristic finds it cheapest, trying the
+ *  borders of a handful of bins along each axis, and becomes
+ *  a leaf when no split is cheaper than testing its items.
+ *
+ *  The nodes are kept in one array in depth first order, so
+ *  the first child of a node always follows it and only the
+ *  second child needs an index, and the items of a leaf are
+ *  one run of the item order. A node takes 32 bytes, which
+ *  puts two nodes on a cache line.
+ *
+ *  Moved items get their new boxes through SetItemBounds(),
+ *  and Refit() then grows or shrinks only the nodes above
+ *  them. A refit keeps the tree shape, so the tree should be
+ *  built again once the items are added, removed or
+ *  reordered.
+ ***********************************************************/
+class BoundingVolumeHierarchy
+{
+public:
+	// one node of the tree, 32 bytes
+	struct BVH_NODE
+	{
+		glm::vec3 minPoint;
+		// first entry of the item order for a leaf, or the
+		// index of the second child, the first child being the
+		// next node
+		int firstOrChild;
+		glm::vec3 maxPoint;
+		// items of a leaf, 0 for an inner node
+		int itemCount;
+	};
+
+	// counters of the last build and refit
+	struct BVH_STATS
+	{
+		int nodes;
+		int leaves;
+		int depth;
+		int nodesRefit;
+	};
+
+	// constructor
+	BoundingVolumeHierarchy();
+
+	// remove every item and node
+	void Clear();
+	// build the tree over the passed in item boxes, an item
+	// being the index of its box
+	void Build(const std::vector<MeshGeometry::MESH_BOUNDS>& itemBounds);
+	// change the box of a moved item, the nodes are updated
+	// by the next Refit()
+	void SetItemBounds(int item, const MeshGeometry::MESH_BOUNDS& bounds);
+	// fit the nodes above the moved items to their new boxes,
+	// and get the number of nodes changed
+	int Refit();
+
+	// get the items whose boxes are at least partly inside the
+	// frustum planes
+	void QueryFrustum(const glm::vec4 planes[6], std::vector<int>& items) const;
+	// get the items whose boxes reach into a sphere
+	void QuerySphere(glm::vec3 center, float radius, std::vector<int>& items) const;
+	// get the item whose box the ray enters first, and the
+	// distance along the ray, -1 when no box is hit
+	int Raycast(glm::vec3 origin, glm::vec3 direction, float& hitDistance) const;
+
+	int GetItemCount() const { return((int)m_itemBounds.size()); }
+	const std::vector<BVH_NODE>& GetNodes() const { return(m_nodes); }
+	const BVH_STATS& GetStats() const { return(m_stats); }
+
+private:
+	std::vector<BVH_NODE> m_nodes;
+	// parent of every node, -1 for the root
+	std::vector<int> m_parents;
+	// the items in leaf order
+	std::vector<int> m_itemOrder;
+	// box of every item
+	std::vector<MeshGeometry::MESH_BOUNDS> m_itemBounds;
+	// leaf holding every item
+	std::vector<int> m_itemLeaves;
+	// leaves holding a moved item, each listed once
+	std::vector<int> m_movedLeaves;
+	std::vector<unsigned char> m_leafMoved;
+	BVH_STATS m_stats;
+
+	// add the node for a run of the item order and the nodes
+	// below it, and get its index
+	int BuildNode(int first, int count, int parent, int depth, const std::vector<glm::vec3>& centers);
+	// fit a node around its items or its children, false when
+	// its box did not change
+	bool FitNode(int node);
+};
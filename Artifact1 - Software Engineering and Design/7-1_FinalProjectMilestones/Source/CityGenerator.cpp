@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////
+// citygenerator.cpp
+// ============
+// lay out a seeded grid of city blocks for large stress scenes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CityGenerator.h"
+
+// declaration of global variables
+namespace
+{
+	// height and thickness of the walls around the city
+	const float g_WallHeight = 2.0f;
+	const float g_WallThickness = 0.5f;
+	// height of the street lights above the ground
+	const float g_LightHeight = 1.0f;
+	// houses are moved off their lot center by up to this
+	// part of the lot spacing
+	const float g_LotJitter = 0.1f;
+
+	// next value of a splitmix64 sequence
+	uint64_t NextRandom(uint64_t& state)
+	{
+		state += 0x9E3779B97F4A7C15ULL;
+		uint64_t value = state;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return(value ^ (value >> 31));
+	}
+
+	// next value of the sequence from 0 up to, not including, 1
+	float NextRandomFloat(uint64_t& state)
+	{
+		return((float)(NextRandom(state) >> 40) * (1.0f / 16777216.0f));
+	}
+}
+
+/***********************************************************
+ *  CityGenerator()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CityGenerator::CityGenerator()
+{
+	m_minPoint = glm::vec3(0.0f);
+	m_maxPoint = glm::vec3(0.0f);
+}
+
+/***********************************************************
+ *  GetDefaultParameters()
+ *
+ *  This method is used for getting the parameters of a
+ *  small city of 4x4 blocks with eight lots each.
+ ***********************************************************/
+CityGenerator::CITY_PARAMETERS CityGenerator::GetDefaultParameters()
+{
+	CITY_PARAMETERS parameters;
+	parameters.seed = 1;
+	parameters.blocksX = 4;
+	parameters.blocksZ = 4;
+	parameters.lotsX = 4;
+	parameters.lotsZ = 2;
+	parameters.lotSpacing = 2.5f;
+	parameters.streetWidth = 3.0f;
+	parameters.emptyLotChance = 0.1f;
+	parameters.windmillChance = 0.25f;
+	parameters.bWalls = true;
+	parameters.maxLights = 1024;
+
+	return(parameters);
+}
+
+/***********************************************************
+ *  Generate()
+ *
+ *  This method is used for laying out a city from the
+ *  passed in parameters. The city is centered on the origin
+ *  of the XZ plane.
+ ***********************************************************/
+void CityGenerator::Generate(const CITY_PARAMETERS& parameters)
+{
+	m_placements.clear();
+	m_lightPositions.clear();
+
+	int blocksX = (parameters.blocksX > 0) ? parameters.blocksX : 0;
+	int blocksZ = (parameters.blocksZ > 0) ? parameters.blocksZ : 0;
+	int lotsX = (parameters.lotsX > 0) ? parameters.lotsX : 1;
+	int lotsZ = (parameters.lotsZ > 0) ? parameters.lotsZ : 1;
+
+	float blockSizeX = lotsX * parameters.lotSpacing;
+	float blockSizeZ = lotsZ * parameters.lotSpacing;
+	float cityWidth = blocksX * (blockSizeX + parameters.streetWidth) - parameters.streetWidth;
+	float cityDepth = blocksZ * (blockSizeZ + parameters.streetWidth) - parameters.streetWidth;
+	glm::vec3 cityCorner(-0.5f * cityWidth, 0.0f, -0.5f * cityDepth);
+
+	m_minPoint = cityCorner - glm::vec3(parameters.streetWidth, 0.0f, parameters.streetWidth);
+	m_maxPoint = cityCorner + glm::vec3(cityWidth + parameters.streetWidth, 0.0f, cityDepth + parameters.streetWidth);
+
+	m_placements.reserve((size_t)blocksX * blocksZ * lotsX * lotsZ + 2 * (blocksX + blocksZ));
+	for (int blockZ = 0; blockZ < blocksZ; blockZ++)
+	{
+		for (int blockX = 0; blockX < blocksX; blockX++)
+		{
+			glm::vec3 blockCorner = cityCorner + glm::vec3(
+				blockX * (blockSizeX + parameters.streetWidth),
+				0.0f,
+				blockZ * (blockSizeZ + parameters.streetWidth));
+			GenerateBlock(parameters, blockX, blockZ, blockCorner);
+		}
+	}
+
+	if (true == parameters.bWalls)
+	{
+		GenerateWalls(parameters, blockSizeX, blockSizeZ);
+	}
+}
+
+/***********************************************************
+ *  GenerateBlock()
+ *
+ *  This method is used for filling the lots of one block.
+ *  Every lot takes the same number of values from the
+ *  sequence of the block, used or not, so changing a chance
+ *  only changes the lots it decides.
+ ***********************************************************/
+void CityGenerator::GenerateBlock(const CITY_PARAMETERS& parameters, int blockX, int blockZ, glm::vec3 blockCorner)
+{
+	int lotsX = (parameters.lotsX > 0) ? parameters.lotsX : 1;
+	int lotsZ = (parameters.lotsZ > 0) ? parameters.lotsZ : 1;
+
+	// the sequence of the block only depends on the seed and
+	// the block coordinates
+	uint64_t state = ((uint64_t)parameters.seed << 32) ^
+		((uint64_t)(uint32_t)blockX * 0x9E3779B1ULL) ^
+		((uint64_t)(uint32_t)blockZ * 0x85EBCA77ULL << 16);
+	NextRandom(state);
+
+	int windmillLot = -1;
+	if (NextRandomFloat(state) < parameters.windmillChance)
+	{
+		windmillLot = (int)(NextRandom(state) % (uint64_t)(lotsX * lotsZ));
+	}
+	else
+	{
+		NextRandom(state);
+	}
+
+	for (int lotZ = 0; lotZ < lotsZ; lotZ++)
+	{
+		for (int lotX = 0; lotX < lotsX; lotX++)
+		{
+			float emptyValue = NextRandomFloat(state);
+			int variant = 1 + (int)(NextRandom(state) % 3);
+			float jitterX = (NextRandomFloat(state) * 2.0f - 1.0f) * g_LotJitter * parameters.lotSpacing;
+			float jitterZ = (NextRandomFloat(state) * 2.0f - 1.0f) * g_LotJitter * parameters.lotSpacing;
+			int turns = (int)(NextRandom(state) % 4);
+
+			CITY_PLACEMENT placement;
+			placement.sizeXYZ = glm::vec3(0.0f);
+			placement.positionXYZ = blockCorner + glm::vec3(
+				(lotX + 0.5f) * parameters.lotSpacing,
+				0.0f,
+				(lotZ + 0.5f) * parameters.lotSpacing);
+
+			if (lotZ * lotsX + lotX == windmillLot)
+			{
+				placement.kind = PLACE_WINDMILL;
+				placement.rotationDegrees = glm::vec3(0.0f, 90.0f * turns, 0.0f);
+			}
+			else if (emptyValue < parameters.emptyLotChance)
+			{
+				continue;
+			}
+			else
+			{
+				// the houses of the back half of a block face the
+				// street behind it
+				placement.kind = variant;
+				placement.rotationDegrees = glm::vec3(0.0f, (2 * lotZ < lotsZ) ? 180.0f : 0.0f, 0.0f);
+				placement.positionXYZ += glm::vec3(jitterX, 0.0f, jitterZ);
+			}
+
+			m_placements.push_back(placement);
+		}
+	}
+
+	// the street light stands on the street crossing in front
+	// of the block corner
+	if ((int)m_lightPositions.size() < parameters.maxLights)
+	{
+		m_lightPositions.push_back(blockCorner + glm::vec3(
+			-0.5f * parameters.streetWidth,
+			g_LightHeight,
+			-0.5f * parameters.streetWidth));
+	}
+}
+
+/***********************************************************
+ *  GenerateWalls()
+ *
+ *  This method is used for running a wall along every block
+ *  on the four edges of the city, out in the middle of the
+ *  outer streets.
+ ***********************************************************/
+void CityGenerator::GenerateWalls(const CITY_PARAMETERS& parameters, float blockSizeX, float blockSizeZ)
+{
+	int blocksX = (parameters.blocksX > 0) ? parameters.blocksX : 0;
+	int blocksZ = (parameters.blocksZ > 0) ? parameters.blocksZ : 0;
+	float pitchX = blockSizeX + parameters.streetWidth;
+	float pitchZ = blockSizeZ + parameters.streetWidth;
+	float edgeOffset = 0.5f * parameters.streetWidth;
+
+	CITY_PLACEMENT wall;
+	wall.kind = PLACE_WALL;
+
+	// the walls along X, behind and in front of the city
+	wall.sizeXYZ = glm::vec3(pitchX, g_WallHeight, g_WallThickness);
+	wall.rotationDegrees = glm::vec3(0.0f);
+	for (int blockX = 0; blockX < blocksX; blockX++)
+	{
+		float centerX = m_minPoint.x + parameters.streetWidth + blockX * pitchX + 0.5f * blockSizeX;
+		wall.positionXYZ = glm::vec3(centerX, 0.0f, m_minPoint.z + edgeOffset);
+		m_placements.push_back(wall);
+		wall.positionXYZ = glm::vec3(centerX, 0.0f, m_maxPoint.z - edgeOffset);
+		m_placements.push_back(wall);
+	}
+
+	// the walls along Z, turned to run down the sides
+	wall.sizeXYZ = glm::vec3(pitchZ, g_WallHeight, g_WallThickness);
+	wall.rotationDegrees = glm::vec3(0.0f, 90.0f, 0.0f);
+	for (int blockZ = 0; blockZ < blocksZ; blockZ++)
+	{
+		float centerZ = m_minPoint.z + parameters.streetWidth + blockZ * pitchZ + 0.5f * blockSizeZ;
+		wall.positionXYZ = glm::vec3(m_minPoint.x + edgeOffset, 0.0f, centerZ);
+		m_placements.push_back(wall);
+		wall.positionXYZ = glm::vec3(m_maxPoint.x - edgeOffset, 0.0f, centerZ);
+		m_placements.push_back(wall);
+	}
+}
+
+/***********************************************************
+ *  GetPlacementCount()
+ *
+ *  This method is used for counting the placements of the
+ *  passed in kind.
+ ***********************************************************/
+int CityGenerator::GetPlacementCount(int kind) const
+{
+	int count = 0;
+	for (const CITY_PLACEMENT& placement : m_placements)
+	{
+		if (placement.kind == kind)
+		{
+			count++;
+		}
+	}
+
+	return(count);
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// citygenerator.h
+// ============
+// lay out a seeded grid of city blocks for large stress scenes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+#include <vector>
+
+/***********************************************************
+ *  CityGenerator
+ *
+ *  This class lays out a city of blocksX by blocksZ blocks
+ *  separated by streets. Every block is a grid of lots, and
+ *  each lot holds one of the three house variants, a
+ *  windmill, or nothing. Walls can run around the edge of
+ *  the city, and every block gets a street light on its
+ *  corner.
+ *
+ *  The random choices of a block come from its own random
+ *  sequence, seeded from the city seed and the block
+ *  coordinates, so the same seed always gives the same city
+ *  and a block does not change when the grid grows. The
+ *  sequence is computed here rather than taken from the
+ *  standard library, whose distributions differ between
+ *  compilers.
+ ***********************************************************/
+class CityGenerator
+{
+public:
+	// what a placement puts down, the house kinds are the
+	// variants of the scene manager's house placements
+	enum PLACEMENT_KIND
+	{
+		PLACE_HOUSE = 1,
+		PLACE_HOUSE2 = 2,
+		PLACE_HOUSE3 = 3,
+		PLACE_WINDMILL,
+		PLACE_WALL
+	};
+
+	struct CITY_PARAMETERS
+	{
+		uint32_t seed;
+		// blocks along X and along Z
+		int blocksX;
+		int blocksZ;
+		// lots of a block along X and along Z
+		int lotsX;
+		int lotsZ;
+		// distance between the lot centers of a block
+		float lotSpacing;
+		// gap between neighboring blocks
+		float streetWidth;
+		// chance of a lot being left empty
+		float emptyLotChance;
+		// chance of a block having a windmill on one lot
+		float windmillChance;
+		// run walls around the edge of the city
+		bool bWalls;
+		// most street lights, one per block up to this count
+		int maxLights;
+	};
+
+	// one thing put down in the city
+	struct CITY_PLACEMENT
+	{
+		int kind;
+		// length, height and thickness of a wall, which is
+		// stretched along a block, unused by the other kinds
+		glm::vec3 sizeXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+	};
+
+	// constructor
+	CityGenerator();
+
+	// parameters of a small city, changed from the command line
+	static CITY_PARAMETERS GetDefaultParameters();
+
+	// lay out a city, replacing the last one
+	void Generate(const CITY_PARAMETERS& parameters);
+
+	// the placements, in block order, then the walls
+	const std::vector<CITY_PLACEMENT>& GetPlacements() const { return(m_placements); }
+	// positions of the street lights
+	const std::vector<glm::vec3>& GetLightPositions() const { return(m_lightPositions); }
+	// corners of the ground covered by the city and its streets
+	glm::vec3 GetMinPoint() const { return(m_minPoint); }
+	glm::vec3 GetMaxPoint() const { return(m_maxPoint); }
+	// number of placements of a kind
+	int GetPlacementCount(int kind) const;
+
+private:
+	std::vector<CITY_PLACEMENT> m_placements;
+	std::vector<glm::vec3> m_lightPositions;
+	glm::vec3 m_minPoint;
+	glm::vec3 m_maxPoint;
+
+	// lay out the lots of one block
+	void GenerateBlock(const CITY_PARAMETERS& parameters, int blockX, int blockZ, glm::vec3 blockCorner);
+	// lay out the walls along the edge of the city
+	void GenerateWalls(const CITY_PARAMETERS& parameters, float blockSizeX, float blockSizeZ);
+};
@@ -0,0 +1,460 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlighting.cpp
+// ============
+// assign the point lights to the clusters of a froxel grid over the view
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ClusteredLighting.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// size of the cluster grid - must match the CLUSTER_GRID_*
+	// defines in the fragment shader
+	const int g_ClusterGridX = 16;
+	const int g_ClusterGridY = 9;
+	const int g_ClusterGridZ = 24;
+	const int g_ClusterCount = g_ClusterGridX * g_ClusterGridY * g_ClusterGridZ;
+
+	// texture units of the clustered lighting texture buffers,
+	// above the slots used by the scene textures
+	const int g_LightDataTextureUnit = 16;
+	const int g_ClusterGridTextureUnit = 17;
+	const int g_ClusterIndexTextureUnit = 18;
+
+	const char* g_UseClusteredLightingName = "bUseClusteredLighting";
+	const char* g_PointLightDataName = "pointLightData";
+	const char* g_ClusterGridName = "clusterGrid";
+	const char* g_ClusterLightIndicesName = "clusterLightIndices";
+	const char* g_ClusterTileSizeName = "clusterTileSize";
+	const char* g_ClusterDepthScaleBiasName = "clusterDepthScaleBias";
+
+	/***********************************************************
+	 *  UnprojectPoint()
+	 *
+	 *  This function is used for converting a point in
+	 *  normalized device coordinates into view space.
+	 ***********************************************************/
+	glm::vec3 UnprojectPoint(const glm::mat4& inverseProjection, float x, float y, float z)
+	{
+		glm::vec4 point = inverseProjection * glm::vec4(x, y, z, 1.0f);
+		return(glm::vec3(point.x, point.y, point.z) * (1.0f / point.w));
+	}
+
+	/***********************************************************
+	 *  SphereIntersectsBox()
+	 *
+	 *  This function is used for testing whether a sphere
+	 *  reaches into an axis aligned box.
+	 ***********************************************************/
+	bool SphereIntersectsBox(
+		const glm::vec3& center,
+		float radius,
+		const glm::vec3& boxMin,
+		const glm::vec3& boxMax)
+	{
+		glm::vec3 closest = glm::clamp(center, boxMin, boxMax);
+		glm::vec3 offset = closest - center;
+
+		return(glm::dot(offset, offset) <= radius * radius);
+	}
+}
+
+/***********************************************************
+ *  ClusteredLighting()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ClusteredLighting::ClusteredLighting()
+{
+	m_pShaderUniforms = NULL;
+	m_bEnabled = true;
+	m_lightDataTexture = 0;
+	m_gridBuffer = 0;
+	m_gridTexture = 0;
+	m_indexBuffer = 0;
+	m_indexTexture = 0;
+	m_maxLightIndices = 0;
+	m_boundsProjection = glm::mat4(0.0f);
+	m_boundsNearPlane = 0.0f;
+	m_boundsFarPlane = 0.0f;
+	m_stats = { 0, 0, 0 };
+}
+
+/***********************************************************
+ *  ~ClusteredLighting()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ClusteredLighting::~ClusteredLighting()
+{
+	Destroy();
+	m_pShaderUniforms = NULL;
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the texture buffers that
+ *  pass the light list, the cluster grid and the cluster
+ *  light indices to the shaders. It must be called after the
+ *  shader uniform locations have been resolved.
+ ***********************************************************/
+void ClusteredLighting::Create(ShaderUniforms* pShaderUniforms, GLuint lightBufferID)
+{
+	GLint maxTextureBufferSize = 0;
+
+	Destroy();
+
+	m_pShaderUniforms = pShaderUniforms;
+
+	// the index list is the only buffer that can grow past
+	// the texture buffer limit, so it is capped to it
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferSize);
+	m_maxLightIndices = (int)maxTextureBufferSize;
+
+	// the light list is read as four RGBA texels per light
+	// straight out of the light uniform buffer
+	glGenTextures(1, &m_lightDataTexture);
+	glActiveTexture(GL_TEXTURE0 + g_LightDataTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_lightDataTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBufferID);
+
+	// every cluster has an offset into the index list and a
+	// light count, both start out as zero
+	m_gridData.assign(g_ClusterCount * 2, 0);
+	glGenBuffers(1, &m_gridBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_gridBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_gridData.size() * sizeof(GLuint), m_gridData.data(), GL_STREAM_DRAW);
+	glGenTextures(1, &m_gridTexture);
+	glActiveTexture(GL_TEXTURE0 + g_ClusterGridTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_gridTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_gridBuffer);
+
+	m_indexData.assign(1, 0);
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_indexData.size() * sizeof(GLuint), m_indexData.data(), GL_STREAM_DRAW);
+	glGenTextures(1, &m_indexTexture);
+	glActiveTexture(GL_TEXTURE0 + g_ClusterIndexTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_indexBuffer);
+
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_uniforms.useClusteredLighting = m_pShaderUniforms->Register<bool>(g_UseClusteredLightingName);
+		m_uniforms.pointLightData = m_pShaderUniforms->Register<int>(g_PointLightDataName);
+		m_uniforms.clusterGrid = m_pShaderUniforms->Register<int>(g_ClusterGridName);
+		m_uniforms.clusterLightIndices = m_pShaderUniforms->Register<int>(g_ClusterLightIndicesName);
+		m_uniforms.clusterTileSize = m_pShaderUniforms->Register<glm::vec2>(g_ClusterTileSizeName);
+		m_uniforms.clusterDepthScaleBias = m_pShaderUniforms->Register<glm::vec2>(g_ClusterDepthScaleBiasName);
+
+		m_pShaderUniforms->Set(m_uniforms.pointLightData, g_LightDataTextureUnit);
+		m_pShaderUniforms->Set(m_uniforms.clusterGrid, g_ClusterGridTextureUnit);
+		m_pShaderUniforms->Set(m_uniforms.clusterLightIndices, g_ClusterIndexTextureUnit);
+		m_pShaderUniforms->Set(m_uniforms.useClusteredLighting, m_bEnabled);
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the texture buffers.
+ ***********************************************************/
+void ClusteredLighting::Destroy()
+{
+	if (0 != m_lightDataTexture)
+	{
+		glDeleteTextures(1, &m_lightDataTexture);
+		m_lightDataTexture = 0;
+	}
+	if (0 != m_gridTexture)
+	{
+		glDeleteTextures(1, &m_gridTexture);
+		m_gridTexture = 0;
+	}
+	if (0 != m_gridBuffer)
+	{
+		glDeleteBuffers(1, &m_gridBuffer);
+		m_gridBuffer = 0;
+	}
+	if (0 != m_indexTexture)
+	{
+		glDeleteTextures(1, &m_indexTexture);
+		m_indexTexture = 0;
+	}
+	if (0 != m_indexBuffer)
+	{
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = 0;
+	}
+	m_clusterBounds.clear();
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for switching the shaders between the
+ *  clustered light lookup and the loop over the whole list.
+ ***********************************************************/
+void ClusteredLighting::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.useClusteredLighting, m_bEnabled);
+	}
+}
+
+/***********************************************************
+ *  FindDepthSlice()
+ *
+ *  This method is used for finding the depth slice that
+ *  holds the passed in view space distance. The slices are
+ *  spaced exponentially between the near and far planes.
+ ***********************************************************/
+int ClusteredLighting::FindDepthSlice(float depth, float nearPlane, float farPlane) const
+{
+	if (depth <= nearPlane)
+	{
+		return(0);
+	}
+
+	int slice = (int)(std::log(depth / nearPlane) / std::log(farPlane / nearPlane) * g_ClusterGridZ);
+
+	return(glm::clamp(slice, 0, g_ClusterGridZ - 1));
+}
+
+/***********************************************************
+ *  BuildClusterBounds()
+ *
+ *  This method is used for building the view space bounding
+ *  box of every cluster. The bounds only depend on the
+ *  projection, so they are rebuilt when it changes.
+ ***********************************************************/
+void ClusteredLighting::BuildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane)
+{
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	m_clusterBounds.resize(g_ClusterCount);
+
+	for (int z = 0; z < g_ClusterGridZ; z++)
+	{
+		float sliceDepths[2];
+		sliceDepths[0] = nearPlane * std::pow(farPlane / nearPlane, (float)z / g_ClusterGridZ);
+		sliceDepths[1] = nearPlane * std::pow(farPlane / nearPlane, (float)(z + 1) / g_ClusterGridZ);
+
+		for (int y = 0; y < g_ClusterGridY; y++)
+		{
+			for (int x = 0; x < g_ClusterGridX; x++)
+			{
+				CLUSTER_BOUNDS& bounds = m_clusterBounds[x + g_ClusterGridX * (y + g_ClusterGridY * z)];
+				bounds.minPoint = glm::vec3(FLT_MAX);
+				bounds.maxPoint = glm::vec3(-FLT_MAX);
+
+				for (int corner = 0; corner < 4; corner++)
+				{
+					float ndcX = -1.0f + 2.0f * (float)(x + (corner & 1)) / g_ClusterGridX;
+					float ndcY = -1.0f + 2.0f * (float)(y + (corner >> 1)) / g_ClusterGridY;
+
+					// the line through the tile corner, from the near
+					// plane to the far plane of the projection
+					glm::vec3 nearPoint = UnprojectPoint(inverseProjection, ndcX, ndcY, -1.0f);
+					glm::vec3 farPoint = UnprojectPoint(inverseProjection, ndcX, ndcY, 1.0f);
+
+					for (int i = 0; i < 2; i++)
+					{
+						float t = (sliceDepths[i] + nearPoint.z) / (nearPoint.z - farPoint.z);
+						glm::vec3 point = nearPoint + (farPoint - nearPoint) * t;
+
+						bounds.minPoint = glm::min(bounds.minPoint, point);
+						bounds.maxPoint = glm::max(bounds.maxPoint, point);
+					}
+				}
+			}
+		}
+	}
+
+	m_boundsProjection = projection;
+	m_boundsNearPlane = nearPlane;
+	m_boundsFarPlane = farPlane;
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for assigning the lights to the
+ *  clusters of the current view and uploading the result.
+ *  Each light only visits the clusters inside the screen
+ *  rectangle and depth slices covered by its range.
+ ***********************************************************/
+void ClusteredLighting::Update(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane,
+	glm::ivec2 viewportSize,
+	const LightBuffer& lights)
+{
+	if ((false == m_bEnabled) || (0 == m_gridBuffer))
+	{
+		return;
+	}
+
+	if ((m_clusterBounds.size() != (size_t)g_ClusterCount) ||
+		(memcmp(&m_boundsProjection, &projection, sizeof(glm::mat4)) != 0) ||
+		(m_boundsNearPlane != nearPlane) ||
+		(m_boundsFarPlane != farPlane))
+	{
+		BuildClusterBounds(projection, nearPlane, farPlane);
+	}
+
+	m_clusterLights.clear();
+	m_stats = { 0, 0, 0 };
+
+	for (int i = 0; i < lights.GetLightCount(); i++)
+	{
+		const LightBuffer::POINT_LIGHT& light = lights.GetLight(i);
+		if (light.range <= 0.0f)
+		{
+			continue;
+		}
+
+		glm::vec4 viewPosition = view * glm::vec4(light.position, 1.0f);
+		glm::vec3 center = glm::vec3(viewPosition.x, viewPosition.y, viewPosition.z);
+		float depth = -center.z;
+
+		if ((depth + light.range < nearPlane) || (depth - light.range > farPlane))
+		{
+			continue;
+		}
+
+		// screen rectangle of the box around the light range,
+		// with the corners kept in front of the near plane
+		glm::vec2 ndcMin = glm::vec2(FLT_MAX, FLT_MAX);
+		glm::vec2 ndcMax = glm::vec2(-FLT_MAX, -FLT_MAX);
+		for (int corner = 0; corner < 8; corner++)
+		{
+			glm::vec4 point = glm::vec4(
+				center.x + ((corner & 1) ? light.range : -light.range),
+				center.y + ((corner & 2) ? light.range : -light.range),
+				std::min(center.z + ((corner & 4) ? light.range : -light.range), -nearPlane),
+				1.0f);
+			glm::vec4 clip = projection * point;
+
+			ndcMin.x = std::min(ndcMin.x, clip.x / clip.w);
+			ndcMin.y = std::min(ndcMin.y, clip.y / clip.w);
+			ndcMax.x = std::max(ndcMax.x, clip.x / clip.w);
+			ndcMax.y = std::max(ndcMax.y, clip.y / clip.w);
+		}
+
+		if ((ndcMax.x < -1.0f) || (ndcMin.x > 1.0f) || (ndcMax.y < -1.0f) || (ndcMin.y > 1.0f))
+		{
+			continue;
+		}
+
+		int x0 = glm::clamp((int)((ndcMin.x * 0.5f + 0.5f) * g_ClusterGridX), 0, g_ClusterGridX - 1);
+		int x1 = glm::clamp((int)((ndcMax.x * 0.5f + 0.5f) * g_ClusterGridX), 0, g_ClusterGridX - 1);
+		int y0 = glm::clamp((int)((ndcMin.y * 0.5f + 0.5f) * g_ClusterGridY), 0, g_ClusterGridY - 1);
+		int y1 = glm::clamp((int)((ndcMax.y * 0.5f + 0.5f) * g_ClusterGridY), 0, g_ClusterGridY - 1);
+		int z0 = FindDepthSlice(depth - light.range, nearPlane, farPlane);
+		int z1 = FindDepthSlice(depth + light.range, nearPlane, farPlane);
+
+		m_stats.visibleLights++;
+
+		for (int z = z0; z <= z1; z++)
+		{
+			for (int y = y0; y <= y1; y++)
+			{
+				for (int x = x0; x <= x1; x++)
+				{
+					GLuint cluster = x + g_ClusterGridX * (y + g_ClusterGridY * z);
+					const CLUSTER_BOUNDS& bounds = m_clusterBounds[cluster];
+
+					if (true == SphereIntersectsBox(center, light.range, bounds.minPoint, bounds.maxPoint))
+					{
+						m_clusterLights.push_back({ cluster, (GLuint)i });
+					}
+				}
+			}
+		}
+	}
+
+	PackClusterLights();
+
+	// upload the new lists - the old storage is orphaned so
+	// the driver does not wait for the previous frame
+	glBindBuffer(GL_TEXTURE_BUFFER, m_gridBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_gridData.size() * sizeof(GLuint), m_gridData.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_indexData.size() * sizeof(GLuint), m_indexData.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	if (NULL != m_pShaderUniforms)
+	{
+		float depthScale = g_ClusterGridZ / std::log(farPlane / nearPlane);
+
+		m_pShaderUniforms->Set(m_uniforms.clusterTileSize, glm::vec2(
+			(float)viewportSize.x / g_ClusterGridX,
+			(float)viewportSize.y / g_ClusterGridY));
+		m_pShaderUniforms->Set(m_uniforms.clusterDepthScaleBias, glm::vec2(
+			depthScale,
+			-depthScale * std::log(nearPlane)));
+	}
+}
+
+/***********************************************************
+ *  PackClusterLights()
+ *
+ *  This method is used for sorting the cluster light pairs
+ *  by cluster into one index list, and writing the offset
+ *  and light count of every cluster into the grid list.
+ ***********************************************************/
+void ClusteredLighting::PackClusterLights()
+{
+	int indexCount = std::min((int)m_clusterLights.size(), m_maxLightIndices);
+
+	// count the lights of every cluster
+	m_gridData.assign(g_ClusterCount * 2, 0);
+	for (int i = 0; i < indexCount; i++)
+	{
+		m_gridData[m_clusterLights[i].cluster * 2 + 1]++;
+	}
+
+	// turn the counts into offsets into the index list
+	GLuint offset = 0;
+	for (int cluster = 0; cluster < g_ClusterCount; cluster++)
+	{
+		GLuint count = m_gridData[cluster * 2 + 1];
+		m_gridData[cluster * 2] = offset;
+		m_stats.maxClusterLights = std::max(m_stats.maxClusterLights, (int)count);
+		offset += count;
+	}
+
+	// write the light indices into the slots of their clusters,
+	// the grid counts are rebuilt along the way
+	m_indexData.assign(std::max(indexCount, 1), 0);
+	for (int cluster = 0; cluster < g_ClusterCount; cluster++)
+	{
+		m_gridData[cluster * 2 + 1] = 0;
+	}
+	for (int i = 0; i < indexCount; i++)
+	{
+		const CLUSTER_LIGHT& pair = m_clusterLights[i];
+		GLuint& count = m_gridData[pair.cluster * 2 + 1];
+
+		m_indexData[m_gridData[pair.cluster * 2] + count] = pair.light;
+		count++;
+	}
+
+	m_stats.lightIndices = indexCount;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlighting.h
+// ============
+// assign the point lights to the clusters of a froxel grid over the view
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "LightBuffer.h"
+#include "ShaderUniforms.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ClusteredLighting
+ *
+ *  This class divides the view frustum into a grid of
+ *  clusters - screen tiles split into depth slices that grow
+ *  exponentially with the distance - and finds the point
+ *  lights whose range reaches into each cluster. The result
+ *  is uploaded into texture buffers, so every fragment only
+ *  evaluates the lights of its own cluster.
+ *
+ *  The grid size must match the CLUSTER_GRID_* defines in
+ *  the fragment shader.
+ ***********************************************************/
+class ClusteredLighting
+{
+public:
+	// counters of the last light assignment
+	struct CLUSTER_STATS
+	{
+		int visibleLights;
+		int lightIndices;
+		int maxClusterLights;
+	};
+
+	// constructor
+	ClusteredLighting();
+	// destructor
+	~ClusteredLighting();
+
+	// create the texture buffers, lightBufferID holds the light list
+	void Create(ShaderUniforms* pShaderUniforms, GLuint lightBufferID);
+	// free the texture buffers
+	void Destroy();
+
+	// assign the lights to the clusters of the current view
+	void Update(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane,
+		glm::ivec2 viewportSize,
+		const LightBuffer& lights);
+
+	// turn the clustered light lookup in the shaders on or off
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const { return(m_bEnabled); }
+
+	// get the counters of the last light assignment
+	const CLUSTER_STATS& GetStats() const { return(m_stats); }
+
+private:
+	// view space bounding box of one cluster
+	struct CLUSTER_BOUNDS
+	{
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+	};
+
+	// one light reaching into one cluster
+	struct CLUSTER_LIGHT
+	{
+		GLuint cluster;
+		GLuint light;
+	};
+
+	// handles of the uniforms set for the clustered lookup
+	struct CLUSTER_UNIFORMS
+	{
+		UniformHandle<bool> useClusteredLighting;
+		UniformHandle<int> pointLightData;
+		UniformHandle<int> clusterGrid;
+		UniformHandle<int> clusterLightIndices;
+		UniformHandle<glm::vec2> clusterTileSize;
+		UniformHandle<glm::vec2> clusterDepthScaleBias;
+	};
+
+	// pointer to the uniform location table of the shader program
+	ShaderUniforms* m_pShaderUniforms;
+	// handles of the uniforms set for the clustered lookup
+	CLUSTER_UNIFORMS m_uniforms;
+	// true when the shaders use the clustered light lookup
+	bool m_bEnabled;
+
+	// buffers and texture views - light list, the offset and
+	// count of every cluster, and the packed light indices
+	GLuint m_lightDataTexture;
+	GLuint m_gridBuffer;
+	GLuint m_gridTexture;
+	GLuint m_indexBuffer;
+	GLuint m_indexTexture;
+	// most light indices a texture buffer can hold
+	int m_maxLightIndices;
+
+	// view setup the cluster bounds were built for
+	glm::mat4 m_boundsProjection;
+	float m_boundsNearPlane;
+	float m_boundsFarPlane;
+	// view space bounds of every cluster
+	std::vector<CLUSTER_BOUNDS> m_clusterBounds;
+
+	// scratch lists reused every frame
+	std::vector<CLUSTER_LIGHT> m_clusterLights;
+	std::vector<GLuint> m_gridData;
+	std::vector<GLuint> m_indexData;
+
+	// counters of the last light assignment
+	CLUSTER_STATS m_stats;
+
+	// build the view space bounds of every cluster
+	void BuildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+	// find the depth slice of a view space distance
+	int FindDepthSlice(float depth, float nearPlane, float farPlane) const;
+	// pack the cluster light pairs into the grid and index lists
+	void PackClusterLights();
+};
\ No newline at end of file
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// cookmain.cpp
+// ============
+// gets called when the cook tool is launched - cooks the source assets
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>           // cooking time
+#include <cstdio>           // console output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+#include <filesystem>       // source folder
+
+#include "AssetCooker.h"
+#include "WorkerPool.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// cook every asset, even the ones that are up to date
+	bool g_bForce = false;
+	// threads for the cooking, 0 for one per core
+	int g_WorkerThreads = 0;
+	// folder holding the source asset folders, the current
+	// folder when not set
+	const char* g_SourceFolder = NULL;
+}
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the cook tool has been
+ *  launched. It cooks the assets found below the source
+ *  folder into its cooked folder and fails when any asset
+ *  could not be cooked.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// process the command line options
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--force") == 0)
+		{
+			g_bForce = true;
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			g_WorkerThreads = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--source") == 0) && (i + 1 < argc))
+		{
+			g_SourceFolder = argv[++i];
+		}
+		else
+		{
+			printf("usage: cook [--force] [--threads N] [--source folder]\n");
+			return(EXIT_FAILURE);
+		}
+	}
+
+	// the assets are found and cooked relative to the source
+	// folder, the same way the application loads them
+	if (NULL != g_SourceFolder)
+	{
+		std::error_code error;
+		std::filesystem::current_path(g_SourceFolder, error);
+		if (error)
+		{
+			printf("could not open the source folder %s\n", g_SourceFolder);
+			return(EXIT_FAILURE);
+		}
+	}
+
+	WorkerPool workerPool;
+	workerPool.Start(g_WorkerThreads);
+
+	AssetCooker cooker;
+	cooker.SetForce(g_bForce);
+	cooker.FindAssets();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool bCooked = cooker.Cook(workerPool);
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	int threadCount = workerPool.GetThreadCount();
+
+	workerPool.Stop();
+
+	printf("%d cooked, %d up to date, %d failed on %d threads in %.1f ms\n",
+		cooker.GetCookedCount(),
+		cooker.GetSkippedCount(),
+		cooker.GetFailedCount(),
+		threadCount,
+		milliseconds);
+
+	return((true == bCooked) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,487 @@
+///////////////////////////////////////////////////////////////////////////////
+// cookedassets.cpp
+// ============
+// read and write the runtime-ready files made by the asset cooker
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CookedAssets.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+
+// the headers are read straight into these structures, so
+// their layout must never depend on the compiler
+static_assert(sizeof(CookedAssets::TEXTURE_HEADER) == 32, "cooked texture header must be 32 bytes");
+static_assert(sizeof(CookedAssets::MESH_PACK_HEADER) == 32, "mesh pack header must be 32 bytes");
+static_assert(sizeof(CookedAssets::MESH_PACK_ENTRY) == 8, "mesh pack entry must be 8 bytes");
+static_assert(sizeof(MeshGeometry::VERTEX) == 32, "mesh pack vertex must be 32 bytes");
+
+// declaration of global variables
+namespace
+{
+	// folder the cooked files are written into
+	const char* g_CookedFolder = "cooked/";
+	// mesh pack inside the cooked folder
+	const char* g_MeshPackName = "meshes.mpk";
+	// FNV-1a multiplier
+	const uint64_t g_HashPrime = 0x100000001B3ULL;
+
+	// read a whole file, false when it cannot be read
+	bool ReadFile(const char* filename, std::vector<unsigned char>& data)
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (false == file.is_open())
+		{
+			return(false);
+		}
+
+		std::streamoff size = file.tellg();
+		if (size <= 0)
+		{
+			return(false);
+		}
+
+		data.resize((size_t)size);
+		file.seekg(0);
+		file.read((char*)data.data(), size);
+
+		return(true == file.good());
+	}
+}
+
+/***********************************************************
+ *  HashBytes()
+ *
+ *  This method is used for adding the passed in bytes to a
+ *  64-bit FNV-1a hash. Passing the result of one call as the
+ *  starting hash of the next hashes the data of both.
+ ***********************************************************/
+uint64_t CookedAssets::HashBytes(const void* pData, size_t size, uint64_t hash)
+{
+	const unsigned char* pBytes = (const unsigned char*)pData;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= pBytes[i];
+		hash *= g_HashPrime;
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  GetCookedFilename()
+ *
+ *  This method is used for getting the name of the cooked
+ *  file made from a source file, "textures/Wood.jpg" giving
+ *  "cooked/textures/Wood.tex" for the ".tex" extension. A
+ *  null extension keeps the extension of the source file.
+ ***********************************************************/
+std::string CookedAssets::GetCookedFilename(const std::string& sourceFilename, const char* extension)
+{
+	std::string filename = sourceFilename;
+
+	if (NULL != extension)
+	{
+		size_t dot = filename.find_last_of('.');
+		size_t slash = filename.find_last_of("/\\");
+		if ((std::string::npos != dot) && ((std::string::npos == slash) || (dot > slash)))
+		{
+			filename.erase(dot);
+		}
+		filename += extension;
+	}
+
+	return(g_CookedFolder + filename);
+}
+
+/***********************************************************
+ *  SelectFilename()
+ *
+ *  This method is used for choosing between a source file
+ *  and the file cooked from it, for loaders that read both
+ *  formats. The cooked file is chosen when it is current.
+ ***********************************************************/
+std::string CookedAssets::SelectFilename(const std::string& sourceFilename, const char* extension)
+{
+	std::string cookedFilename = GetCookedFilename(sourceFilename, extension);
+
+	return((true == IsCookedCurrent(sourceFilename, cookedFilename)) ? cookedFilename : sourceFilename);
+}
+
+/***********************************************************
+ *  IsCookedCurrent()
+ *
+ *  This method is used for telling whether a cooked file
+ *  still holds its source file. A source file saved after
+ *  the last cook makes the cooked file stale, so the source
+ *  is loaded until the cook tool runs again. A cooked file
+ *  without its source file is current, as it is all there
+ *  is to load.
+ ***********************************************************/
+bool CookedAssets::IsCookedCurrent(const std::string& sourceFilename, const std::string& cookedFilename)
+{
+	FILE_STAMP cookedStamp = GetFileStamp(cookedFilename.c_str());
+	if (0 == cookedStamp.writeTime)
+	{
+		return(false);
+	}
+
+	FILE_STAMP sourceStamp = GetFileStamp(sourceFilename.c_str());
+
+	return(sourceStamp.writeTime <= cookedStamp.writeTime);
+}
+
+/***********************************************************
+ *  GetFileStamp()
+ *
+ *  This method is used for getting the time a file was last
+ *  written, to the resolution of the file system, and its
+ *  size, so a loader can tell that the file changed since
+ *  it was read even when it was saved twice in one second.
+ *  The write time is 0 when the file does not exist.
+ ***********************************************************/
+CookedAssets::FILE_STAMP CookedAssets::GetFileStamp(const char* filename)
+{
+	FILE_STAMP stamp = { 0, 0 };
+
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (0 == GetFileAttributesExA(filename, GetFileExInfoStandard, &fileData))
+	{
+		return(stamp);
+	}
+
+	// the write time counts 100 nanosecond ticks
+	uint64_t ticks = ((uint64_t)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+	stamp.writeTime = (int64_t)ticks * 100;
+	stamp.size = ((int64_t)fileData.nFileSizeHigh << 32) | fileData.nFileSizeLow;
+#else
+	struct stat fileStat;
+	if (0 != stat(filename, &fileStat))
+	{
+		return(stamp);
+	}
+
+#ifdef __APPLE__
+	stamp.writeTime = (int64_t)fileStat.st_mtimespec.tv_sec * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#else
+	stamp.writeTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif
+	stamp.size = (int64_t)fileStat.st_size;
+#endif
+
+	return(stamp);
+}
+
+/***********************************************************
+ *  GetMeshPackFilename()
+ *
+ *  This method is used for getting the name of the mesh pack
+ *  holding every basic shape, which has no source file.
+ ***********************************************************/
+std::string CookedAssets::GetMeshPackFilename()
+{
+	return(std::string(g_CookedFolder) + g_MeshPackName);
+}
+
+/***********************************************************
+ *  GetLevelCount()
+ *
+ *  This method is used for getting the number of mipmap
+ *  levels of an image, halving down to 1x1.
+ ***********************************************************/
+int CookedAssets::GetLevelCount(int width, int height)
+{
+	int size = (width > height) ? width : height;
+	int levelCount = 1;
+	while (size > 1)
+	{
+		size >>= 1;
+		levelCount++;
+	}
+
+	return(levelCount);
+}
+
+/***********************************************************
+ *  GetLevelSize()
+ *
+ *  This method is used for getting the bytes in one mipmap
+ *  level. The rows are packed without padding.
+ ***********************************************************/
+size_t CookedAssets::GetLevelSize(int width, int height, int colorChannels, int level)
+{
+	int levelWidth = width >> level;
+	int levelHeight = height >> level;
+	if (levelWidth < 1)
+	{
+		levelWidth = 1;
+	}
+	if (levelHeight < 1)
+	{
+		levelHeight = 1;
+	}
+
+	return((size_t)levelWidth * levelHeight * colorChannels);
+}
+
+/***********************************************************
+ *  BuildMipChain()
+ *
+ *  This method is used for appending every mipmap level
+ *  below the image in the passed in vector. Each pixel of a
+ *  level is the rounded average of the 2x2 pixels above it,
+ *  repeating the last row or column of an odd sized level.
+ ***********************************************************/
+void CookedAssets::BuildMipChain(int width, int height, int colorChannels, std::vector<unsigned char>& levels)
+{
+	int levelCount = GetLevelCount(width, height);
+
+	size_t totalSize = 0;
+	for (int level = 0; level < levelCount; level++)
+	{
+		totalSize += GetLevelSize(width, height, colorChannels, level);
+	}
+	levels.resize(totalSize);
+
+	size_t sourceOffset = 0;
+	int sourceWidth = width;
+	int sourceHeight = height;
+	for (int level = 1; level < levelCount; level++)
+	{
+		int levelWidth = (sourceWidth > 1) ? (sourceWidth >> 1) : 1;
+		int levelHeight = (sourceHeight > 1) ? (sourceHeight >> 1) : 1;
+		size_t levelOffset = sourceOffset + (size_t)sourceWidth * sourceHeight * colorChannels;
+
+		const unsigned char* pSource = levels.data() + sourceOffset;
+		unsigned char* pLevel = levels.data() + levelOffset;
+		for (int y = 0; y < levelHeight; y++)
+		{
+			int y0 = y * 2;
+			int y1 = (y0 + 1 < sourceHeight) ? (y0 + 1) : y0;
+			for (int x = 0; x < levelWidth; x++)
+			{
+				int x0 = x * 2;
+				int x1 = (x0 + 1 < sourceWidth) ? (x0 + 1) : x0;
+				for (int channel = 0; channel < colorChannels; channel++)
+				{
+					int sum =
+						pSource[((size_t)y0 * sourceWidth + x0) * colorChannels + channel] +
+						pSource[((size_t)y0 * sourceWidth + x1) * colorChannels + channel] +
+						pSource[((size_t)y1 * sourceWidth + x0) * colorChannels + channel] +
+						pSource[((size_t)y1 * sourceWidth + x1) * colorChannels + channel];
+					pLevel[((size_t)y * levelWidth + x) * colorChannels + channel] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+
+		sourceOffset = levelOffset;
+		sourceWidth = levelWidth;
+		sourceHeight = levelHeight;
+	}
+}
+
+/***********************************************************
+ *  WriteTexture()
+ *
+ *  This method is used for writing an image and its mipmap
+ *  chain into a cooked texture file.
+ ***********************************************************/
+bool CookedAssets::WriteTexture(
+	const char* filename,
+	int width,
+	int height,
+	int colorChannels,
+	const std::vector<unsigned char>& levels)
+{
+	TEXTURE_HEADER header = {};
+	header.magic = TEXTURE_MAGIC;
+	header.version = FORMAT_VERSION;
+	header.width = (uint32_t)width;
+	header.height = (uint32_t)height;
+	header.colorChannels = (uint32_t)colorChannels;
+	header.levelCount = (uint32_t)GetLevelCount(width, height);
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (false == file.is_open())
+	{
+		return(false);
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)levels.data(), levels.size());
+
+	return(true == file.good());
+}
+
+/***********************************************************
+ *  ReadTexture()
+ *
+ *  This method is used for reading a cooked texture file.
+ *  The levels are copied out as they are, and false is
+ *  returned when the file is missing, from another format
+ *  version, or does not hold exactly the whole mipmap chain.
+ ***********************************************************/
+bool CookedAssets::ReadTexture(
+	const char* filename,
+	int& width,
+	int& height,
+	int& colorChannels,
+	std::vector<unsigned char>& levels)
+{
+	std::vector<unsigned char> data;
+	if ((false == ReadFile(filename, data)) || (data.size() < sizeof(TEXTURE_HEADER)))
+	{
+		return(false);
+	}
+
+	const TEXTURE_HEADER* pHeader = (const TEXTURE_HEADER*)data.data();
+	if ((TEXTURE_MAGIC != pHeader->magic) ||
+		(FORMAT_VERSION != pHeader->version) ||
+		(0 == pHeader->width) || (pHeader->width > 0x8000) ||
+		(0 == pHeader->height) || (pHeader->height > 0x8000) ||
+		((3 != pHeader->colorChannels) && (4 != pHeader->colorChannels)) ||
+		((int)pHeader->levelCount != GetLevelCount((int)pHeader->width, (int)pHeader->height)))
+	{
+		return(false);
+	}
+
+	size_t levelsSize = 0;
+	for (int level = 0; level < (int)pHeader->levelCount; level++)
+	{
+		levelsSize += GetLevelSize((int)pHeader->width, (int)pHeader->height, (int)pHeader->colorChannels, level);
+	}
+	if (data.size() - sizeof(TEXTURE_HEADER) != levelsSize)
+	{
+		return(false);
+	}
+
+	width = (int)pHeader->width;
+	height = (int)pHeader->height;
+	colorChannels = (int)pHeader->colorChannels;
+	levels.assign(data.begin() + sizeof(TEXTURE_HEADER), data.end());
+
+	return(true);
+}
+
+/***********************************************************
+ *  WriteMeshPack()
+ *
+ *  This method is used for writing the vertex and index
+ *  data of the passed in meshes into a mesh pack file.
+ ***********************************************************/
+bool CookedAssets::WriteMeshPack(const char* filename, const std::vector<MeshGeometry::MESH_DATA>& meshes)
+{
+	MESH_PACK_HEADER header = {};
+	header.magic = MESH_PACK_MAGIC;
+	header.version = FORMAT_VERSION;
+	header.vertexSize = sizeof(MeshGeometry::VERTEX);
+	header.meshCount = (uint32_t)meshes.size();
+
+	std::vector<MESH_PACK_ENTRY> entries(meshes.size());
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		entries[i].vertexCount = (uint32_t)meshes[i].vertices.size();
+		entries[i].indexCount = (uint32_t)meshes[i].indices.size();
+		header.vertexCount += entries[i].vertexCount;
+		header.indexCount += entries[i].indexCount;
+	}
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (false == file.is_open())
+	{
+		return(false);
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)entries.data(), entries.size() * sizeof(MESH_PACK_ENTRY));
+	for (const MeshGeometry::MESH_DATA& mesh : meshes)
+	{
+		file.write((const char*)mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshGeometry::VERTEX));
+	}
+	for (const MeshGeometry::MESH_DATA& mesh : meshes)
+	{
+		file.write((const char*)mesh.indices.data(), mesh.indices.size() * sizeof(GLuint));
+	}
+
+	return(true == file.good());
+}
+
+/***********************************************************
+ *  ReadMeshPack()
+ *
+ *  This method is used for reading the meshes of a mesh pack
+ *  file, in the order they were written. False is returned
+ *  when the file is missing, from another format version,
+ *  or its tables do not add up to the file size.
+ ***********************************************************/
+bool CookedAssets::ReadMeshPack(const char* filename, std::vector<MeshGeometry::MESH_DATA>& meshes)
+{
+	std::vector<unsigned char> data;
+	if ((false == ReadFile(filename, data)) || (data.size() < sizeof(MESH_PACK_HEADER)))
+	{
+		return(false);
+	}
+
+	const MESH_PACK_HEADER* pHeader = (const MESH_PACK_HEADER*)data.data();
+	if ((MESH_PACK_MAGIC != pHeader->magic) ||
+		(FORMAT_VERSION != pHeader->version) ||
+		(sizeof(MeshGeometry::VERTEX) != pHeader->vertexSize))
+	{
+		return(false);
+	}
+
+	// the counts are at most 32 bits, so the sizes cannot overflow
+	uint64_t expectedSize = sizeof(MESH_PACK_HEADER) +
+		(uint64_t)pHeader->meshCount * sizeof(MESH_PACK_ENTRY) +
+		(uint64_t)pHeader->vertexCount * sizeof(MeshGeometry::VERTEX) +
+		(uint64_t)pHeader->indexCount * sizeof(GLuint);
+	if (data.size() != expectedSize)
+	{
+		return(false);
+	}
+
+	const MESH_PACK_ENTRY* pEntries = (const MESH_PACK_ENTRY*)(data.data() + sizeof(MESH_PACK_HEADER));
+	const unsigned char* pVertexData = (const unsigned char*)(pEntries + pHeader->meshCount);
+	const unsigned char* pIndexData = pVertexData + (size_t)pHeader->vertexCount * sizeof(MeshGeometry::VERTEX);
+
+	uint64_t vertexTotal = 0;
+	uint64_t indexTotal = 0;
+	for (uint32_t i = 0; i < pHeader->meshCount; i++)
+	{
+		vertexTotal += pEntries[i].vertexCount;
+		indexTotal += pEntries[i].indexCount;
+	}
+	if ((vertexTotal != pHeader->vertexCount) || (indexTotal != pHeader->indexCount))
+	{
+		return(false);
+	}
+
+	// the mesh data is copied out, the file is only read once
+	meshes.resize(pHeader->meshCount);
+	for (uint32_t i = 0; i < pHeader->meshCount; i++)
+	{
+		MeshGeometry::MESH_DATA& mesh = meshes[i];
+		mesh.vertices.resize(pEntries[i].vertexCount);
+		mesh.indices.resize(pEntries[i].indexCount);
+		memcpy(mesh.vertices.data(), pVertexData, mesh.vertices.size() * sizeof(MeshGeometry::VERTEX));
+		memcpy(mesh.indices.data(), pIndexData, mesh.indices.size() * sizeof(GLuint));
+		pVertexData += mesh.vertices.size() * sizeof(MeshGeometry::VERTEX);
+		pIndexData += mesh.indices.size() * sizeof(GLuint);
+	}
+
+	return(true);
+}
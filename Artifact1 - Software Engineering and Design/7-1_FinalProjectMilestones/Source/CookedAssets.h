@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// cookedassets.h
+// ============
+// read and write the runtime-ready files made by the asset cooker
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  CookedAssets
+ *
+ *  This class holds the file formats shared by the cook
+ *  tool, which writes them, and the application, which only
+ *  reads them. A cooked texture is the decoded, flipped
+ *  image with its whole mipmap chain, and the mesh pack is
+ *  the vertex and index data of every basic shape, so both
+ *  are copied straight into memory at startup.
+ *
+ *  The cooked files mirror the source folders under the
+ *  cooked folder, and the application falls back to the
+ *  source files when a cooked file is missing or older than
+ *  its source file.
+ ***********************************************************/
+class CookedAssets
+{
+public:
+	// "CTEX" and "CMSH" read as little-endian 32-bit values
+	static const uint32_t TEXTURE_MAGIC = 0x58455443;
+	static const uint32_t MESH_PACK_MAGIC = 0x48534D43;
+	// must be raised whenever a cooked format changes
+	static const uint32_t FORMAT_VERSION = 1;
+
+	// start of a cooked texture, 32 bytes, followed by the
+	// levels from the largest to 1x1
+	struct TEXTURE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		uint32_t colorChannels;
+		uint32_t levelCount;
+		uint32_t reserved[2];
+	};
+
+	// start of the mesh pack, 32 bytes, followed by one entry
+	// per mesh, then every vertex, then every index
+	struct MESH_PACK_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t vertexSize;
+		uint32_t meshCount;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t reserved[2];
+	};
+
+	// counts of one mesh in the mesh pack, 8 bytes - the
+	// meshes follow each other in the order they were added
+	struct MESH_PACK_ENTRY
+	{
+		uint32_t vertexCount;
+		uint32_t indexCount;
+	};
+
+	// last write time and size of a file, which together tell
+	// that a file was written again even within one second
+	struct FILE_STAMP
+	{
+		// in nanoseconds, 0 when the file does not exist
+		int64_t writeTime;
+		int64_t size;
+	};
+
+	// FNV-1a starting value, hashes are chained through it
+	static const uint64_t HASH_SEED = 0xCBF29CE484222325ULL;
+
+	// add bytes to a 64-bit FNV-1a hash
+	static uint64_t HashBytes(const void* pData, size_t size, uint64_t hash = HASH_SEED);
+
+	// name of the cooked file for a source file - the cooked
+	// folder, the source path, and the cooked extension
+	static std::string GetCookedFilename(const std::string& sourceFilename, const char* extension);
+	// name of the cooked file when it is current, and of the
+	// source file otherwise
+	static std::string SelectFilename(const std::string& sourceFilename, const char* extension);
+	// true when the cooked file exists and was written after
+	// the source file was last saved
+	static bool IsCookedCurrent(const std::string& sourceFilename, const std::string& cookedFilename);
+	// name of the cooked mesh pack of the basic shapes
+	static std::string GetMeshPackFilename();
+	// last write time and size of a file
+	static FILE_STAMP GetFileStamp(const char* filename);
+	// true when the stamps are of the same version of a file
+	static bool IsSameStamp(const FILE_STAMP& stamp, const FILE_STAMP& otherStamp)
+	{
+		return((stamp.writeTime == otherStamp.writeTime) && (stamp.size == otherStamp.size));
+	}
+
+	// number of levels down to 1x1 and the bytes in one level
+	static int GetLevelCount(int width, int height);
+	static size_t GetLevelSize(int width, int height, int colorChannels, int level);
+	// append the levels below the image, which must be the
+	// only data in the passed in vector
+	static void BuildMipChain(int width, int height, int colorChannels, std::vector<unsigned char>& levels);
+
+	// cooked texture files
+	static bool WriteTexture(
+		const char* filename,
+		int width,
+		int height,
+		int colorChannels,
+		const std::vector<unsigned char>& levels);
+	static bool ReadTexture(
+		const char* filename,
+		int& width,
+		int& height,
+		int& colorChannels,
+		std::vector<unsigned char>& levels);
+
+	// mesh pack files
+	static bool WriteMeshPack(const char* filename, const std::vector<MeshGeometry::MESH_DATA>& meshes);
+	static bool ReadMeshPack(const char* filename, std::vector<MeshGeometry::MESH_DATA>& meshes);
+};
@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+// entitystore.cpp
+// ============
+// scene objects as entities with dense, packed component arrays
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "EntityStore.h"
+
+// declaration of global variables
+namespace
+{
+	// ID that never matches a live entity
+	const EntityStore::ENTITY g_DeadEntity = 0xFFFFFFFF;
+	// most entities alive at the same time
+	const uint32_t g_MaxEntities = 0x00FFFFFF;
+}
+
+/***********************************************************
+ *  EntityStore()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+EntityStore::EntityStore()
+{
+	m_entityCount = 0;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for destroying every entity together
+ *  with its components.
+ ***********************************************************/
+void EntityStore::Clear()
+{
+	m_liveEntities.clear();
+	m_generations.clear();
+	m_freeIndices.clear();
+	m_entityCount = 0;
+	ForEachArray([](auto& components) { components.Clear(); });
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for a number of
+ *  entities in every component array up front.
+ ***********************************************************/
+void EntityStore::Reserve(size_t entityCount)
+{
+	m_liveEntities.reserve(entityCount);
+	m_generations.reserve(entityCount);
+	ForEachArray([entityCount](auto& components) { components.Reserve(entityCount); });
+}
+
+/***********************************************************
+ *  Swap()
+ *
+ *  This method is used for exchanging every entity and
+ *  component with another store.
+ ***********************************************************/
+void EntityStore::Swap(EntityStore& other)
+{
+	m_liveEntities.swap(other.m_liveEntities);
+	m_generations.swap(other.m_generations);
+	m_freeIndices.swap(other.m_freeIndices);
+	std::swap(m_entityCount, other.m_entityCount);
+	m_components.swap(other.m_components);
+}
+
+/***********************************************************
+ *  CreateEntity()
+ *
+ *  This method is used for creating an entity without any
+ *  components. The index of a destroyed entity is reused
+ *  with the next generation.
+ ***********************************************************/
+EntityStore::ENTITY EntityStore::CreateEntity()
+{
+	uint32_t index = 0;
+
+	if (false == m_freeIndices.empty())
+	{
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+		m_generations[index]++;
+	}
+	else if (m_liveEntities.size() < g_MaxEntities)
+	{
+		index = (uint32_t)m_liveEntities.size();
+		m_liveEntities.push_back(g_DeadEntity);
+		m_generations.push_back(0);
+	}
+	else
+	{
+		return(g_DeadEntity);
+	}
+
+	ENTITY entity = ((ENTITY)m_generations[index] << 24) | index;
+	m_liveEntities[index] = entity;
+	m_entityCount++;
+	return(entity);
+}
+
+/***********************************************************
+ *  DestroyEntities()
+ *
+ *  This method is used for destroying a set of entities
+ *  together with their components. Every array is compacted
+ *  once for the whole set, and the remaining entities keep
+ *  their order, so the arrays still line up afterwards.
+ ***********************************************************/
+void EntityStore::DestroyEntities(const std::vector<ENTITY>& entities)
+{
+	for (ENTITY entity : entities)
+	{
+		if (false == IsAlive(entity))
+		{
+			continue;
+		}
+
+		m_liveEntities[GetIndex(entity)] = g_DeadEntity;
+		m_freeIndices.push_back(GetIndex(entity));
+		m_entityCount--;
+	}
+
+	ForEachArray([this](auto& components) { components.Compact(m_liveEntities); });
+}
+
+/***********************************************************
+ *  IsAlive()
+ *
+ *  This method is used for checking whether an entity has
+ *  not been destroyed.
+ ***********************************************************/
+bool EntityStore::IsAlive(ENTITY entity) const
+{
+	uint32_t index = GetIndex(entity);
+	return((index < m_liveEntities.size()) && (m_liveEntities[index] == entity));
+}
+
+/***********************************************************
+ *  SortEntities()
+ *
+ *  This method is used for moving the components of every
+ *  array into the order of the passed in entities, so the
+ *  systems walk them in that order.
+ ***********************************************************/
+void EntityStore::SortEntities(const std::vector<ENTITY>& order)
+{
+	std::vector<int> ranks(m_liveEntities.size(), 0);
+	for (int rank = 0; rank < (int)order.size(); rank++)
+	{
+		ranks[GetIndex(order[rank])] = rank;
+	}
+
+	ForEachArray([&ranks](auto& components) { components.Sort(ranks); });
+}
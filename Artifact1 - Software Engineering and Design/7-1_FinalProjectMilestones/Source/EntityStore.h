@@ -0,0 +1,389 @@
+///////////////////////////////////////////////////////////////////////////////
+// entitystore.h
+// ============
+// scene objects as entities with dense, packed component arrays
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/***********************************************************
+ *  EntityStore
+ *
+ *  This class keeps the scene objects as entities. An entity
+ *  is only an ID, and its data lives in one array per
+ *  component type. Each array is dense - the components are
+ *  packed one after another with no holes - and keeps the
+ *  entity of every slot plus a table from the entity to its
+ *  slot.
+ *
+ *  Each() walks the array of the first listed component from
+ *  the front and passes every entity that also has the other
+ *  listed components. The arrays are kept in creation order
+ *  or in the order given to SortEntities(), so when the
+ *  entities have the same components every array lines up
+ *  slot for slot and a system streams through each of them
+ *  in order, reading only the components it asks for.
+ *
+ *  An entity ID holds the index of the entity in its low 24
+ *  bits and a generation count in its high 8 bits, so the ID
+ *  of a destroyed entity does not match the entity reusing
+ *  its index.
+ ***********************************************************/
+class EntityStore
+{
+public:
+	typedef uint32_t ENTITY;
+
+	// placement of the entity, kept relative to a scene graph
+	// node when there is one
+	struct TRANSFORM_COMPONENT
+	{
+		glm::mat4 model;
+		glm::mat4 localModel;
+		// scene graph node, or -1 when the model matrix is
+		// already in world space
+		int transformNode;
+	};
+
+	// basic shape mesh drawn for the entity
+	struct MESH_REF
+	{
+		int meshID;
+	};
+
+	// index into the defined materials, or -1 for the material
+	// of the draw before it
+	struct MATERIAL_REF
+	{
+		int materialIndex;
+	};
+
+	// texture layer and how it is mapped, or the color when
+	// there is no texture
+	struct TEXTURE_REF
+	{
+		// slot in the texture table, or -1 when drawn with the color
+		int textureSlot;
+		glm::vec2 UVscale;
+		glm::vec4 color;
+	};
+
+	// world space box around the entity
+	struct BOUNDS_COMPONENT
+	{
+		MeshGeometry::MESH_BOUNDS worldBounds;
+	};
+
+	// offset and count of the point light list of the entity
+	struct LIGHT_LIST_REF
+	{
+		glm::ivec2 lightRange;
+	};
+
+	enum ENTITY_FLAG
+	{
+		// the entity may move, which keeps it out of the static bake
+		ENTITY_DYNAMIC = 0x1
+	};
+
+	struct FLAGS_COMPONENT
+	{
+		uint32_t flags;
+	};
+
+	// key of the scene file object the entity was made from,
+	// 0 for an object built in code
+	struct SOURCE_REF
+	{
+		uint64_t sourceKey;
+	};
+
+	// constructor
+	EntityStore();
+
+	// destroy every entity
+	void Clear();
+	// make room for a number of entities in every array
+	void Reserve(size_t entityCount);
+	// exchange every entity and component with another store
+	void Swap(EntityStore& other);
+
+	// create an entity without any components, or get an ID
+	// that is never alive when the store is full
+	ENTITY CreateEntity();
+	// destroy a set of entities, the remaining entities keep
+	// their order in every array
+	void DestroyEntities(const std::vector<ENTITY>& entities);
+	bool IsAlive(ENTITY entity) const;
+	int GetEntityCount() const { return(m_entityCount); }
+
+	// put the components of every array into the order of the
+	// passed in entities, which must be every live entity
+	void SortEntities(const std::vector<ENTITY>& order);
+
+	// add a component to an entity, or replace the one it has
+	template <typename T>
+	T& Add(ENTITY entity, const T& component)
+	{
+		return(Components<T>().Add(entity, component));
+	}
+
+	// find a component of an entity, NULL when it has none
+	template <typename T>
+	T* Get(ENTITY entity)
+	{
+		return(Components<T>().Find(entity, -1));
+	}
+
+	// slot of an entity in the array of a component, -1 when
+	// it has none
+	template <typename T>
+	int GetSlot(ENTITY entity)
+	{
+		return(Components<T>().FindSlot(entity));
+	}
+	// number of entities with a component
+	template <typename T>
+	int GetCount()
+	{
+		return(Components<T>().GetCount());
+	}
+
+	// entity at a slot of the array of a component
+	template <typename T>
+	ENTITY GetEntity(int slot)
+	{
+		return(Components<T>().GetEntity(slot));
+	}
+
+	// call a function for every entity with all the listed
+	// components, with the slot of the entity in the array of
+	// the first component and a reference to each component
+	template <typename First, typename... Rest, typename Function>
+	void Each(Function fn)
+	{
+		EachRange<First, Rest...>(0, GetCount<First>(), fn);
+	}
+
+	// the same for the slots from begin up to, not including,
+	// end of the array of the first component, so the slots
+	// can be split across worker threads
+	template <typename First, typename... Rest, typename Function>
+	void EachRange(int begin, int end, Function fn)
+	{
+		ComponentArray<First>& first = Components<First>();
+		for (int slot = begin; slot < end; slot++)
+		{
+			// the slot is tried first, which is where the other
+			// component is when the arrays line up
+			std::tuple<Rest*...> others(Components<Rest>().Find(first.GetEntity(slot), slot)...);
+			Invoke(fn, slot, first.GetAt(slot), others, std::index_sequence_for<Rest...>());
+		}
+	}
+
+private:
+	// dense array of one component type
+	template <typename T>
+	class ComponentArray
+	{
+	public:
+		void Clear()
+		{
+			m_data.clear();
+			m_entities.clear();
+			m_slots.clear();
+		}
+
+		void Reserve(size_t count)
+		{
+			m_data.reserve(count);
+			m_entities.reserve(count);
+		}
+
+		int GetCount() const { return((int)m_data.size()); }
+		T& GetAt(int slot) { return(m_data[slot]); }
+		ENTITY GetEntity(int slot) const { return(m_entities[slot]); }
+
+		T& Add(ENTITY entity, const T& component)
+		{
+			uint32_t index = GetIndex(entity);
+			if (index >= m_slots.size())
+			{
+				m_slots.resize(index + 1, -1);
+			}
+
+			int slot = m_slots[index];
+			if ((slot >= 0) && (m_entities[slot] == entity))
+			{
+				m_data[slot] = component;
+				return(m_data[slot]);
+			}
+
+			m_slots[index] = (int)m_data.size();
+			m_data.push_back(component);
+			m_entities.push_back(entity);
+			return(m_data.back());
+		}
+
+		// find the component of an entity, trying the hinted
+		// slot before the slot table
+		T* Find(ENTITY entity, int hintSlot)
+		{
+			if ((hintSlot >= 0) && (hintSlot < (int)m_entities.size()) && (m_entities[hintSlot] == entity))
+			{
+				return(&m_data[hintSlot]);
+			}
+
+			uint32_t index = GetIndex(entity);
+			if (index >= m_slots.size())
+			{
+				return(NULL);
+			}
+
+			int slot = m_slots[index];
+			if ((slot < 0) || (m_entities[slot] != entity))
+			{
+				return(NULL);
+			}
+			return(&m_data[slot]);
+		}
+
+		// find the slot of an entity through the slot table
+		int FindSlot(ENTITY entity) const
+		{
+			uint32_t index = GetIndex(entity);
+			if ((index >= m_slots.size()) || (m_slots[index] < 0) || (m_entities[m_slots[index]] != entity))
+			{
+				return(-1);
+			}
+			return(m_slots[index]);
+		}
+		// drop the components of the entities that are no longer
+		// live, keeping the order of the others
+		void Compact(const std::vector<ENTITY>& liveEntities)
+		{
+			int kept = 0;
+			for (int slot = 0; slot < (int)m_data.size(); slot++)
+			{
+				ENTITY entity = m_entities[slot];
+				uint32_t index = GetIndex(entity);
+				if (liveEntities[index] != entity)
+				{
+					m_slots[index] = -1;
+					continue;
+				}
+
+				if (kept != slot)
+				{
+					m_data[kept] = m_data[slot];
+					m_entities[kept] = entity;
+				}
+				m_slots[index] = kept;
+				kept++;
+			}
+
+			m_data.resize(kept);
+			m_entities.resize(kept);
+		}
+
+		// move the components into the order of the entity ranks
+		void Sort(const std::vector<int>& ranks)
+		{
+			std::vector<std::pair<int, int>> order(m_data.size());
+			for (int slot = 0; slot < (int)m_data.size(); slot++)
+			{
+				order[slot] = std::make_pair(ranks[GetIndex(m_entities[slot])], slot);
+			}
+			std::sort(order.begin(), order.end());
+
+			std::vector<T> data(m_data.size());
+			std::vector<ENTITY> entities(m_entities.size());
+			for (int slot = 0; slot < (int)order.size(); slot++)
+			{
+				data[slot] = m_data[order[slot].second];
+				entities[slot] = m_entities[order[slot].second];
+				m_slots[GetIndex(entities[slot])] = slot;
+			}
+
+			m_data.swap(data);
+			m_entities.swap(entities);
+		}
+
+	private:
+		std::vector<T> m_data;
+		// entity of every slot
+		std::vector<ENTITY> m_entities;
+		// slot of every entity index, -1 when it has none
+		std::vector<int> m_slots;
+	};
+
+	// the entity of every index while it is alive, or an ID
+	// no entity uses
+	std::vector<ENTITY> m_liveEntities;
+	// generation of the entity last using every index
+	std::vector<uint8_t> m_generations;
+	// indices of the destroyed entities, reused first
+	std::vector<uint32_t> m_freeIndices;
+	int m_entityCount;
+	std::tuple<
+		ComponentArray<TRANSFORM_COMPONENT>,
+		ComponentArray<MESH_REF>,
+		ComponentArray<MATERIAL_REF>,
+		ComponentArray<TEXTURE_REF>,
+		ComponentArray<BOUNDS_COMPONENT>,
+		ComponentArray<LIGHT_LIST_REF>,
+		ComponentArray<FLAGS_COMPONENT>,
+		ComponentArray<SOURCE_REF>> m_components;
+
+	static uint32_t GetIndex(ENTITY entity) { return(entity & 0x00FFFFFF); }
+	static uint32_t GetGeneration(ENTITY entity) { return(entity >> 24); }
+
+	template <typename T>
+	ComponentArray<T>& Components()
+	{
+		return(std::get<ComponentArray<T>>(m_components));
+	}
+
+	// call a function for every component array
+	template <typename Function>
+	void ForEachArray(Function fn)
+	{
+		fn(Components<TRANSFORM_COMPONENT>());
+		fn(Components<MESH_REF>());
+		fn(Components<MATERIAL_REF>());
+		fn(Components<TEXTURE_REF>());
+		fn(Components<BOUNDS_COMPONENT>());
+		fn(Components<LIGHT_LIST_REF>());
+		fn(Components<FLAGS_COMPONENT>());
+		fn(Components<SOURCE_REF>());
+	}
+
+	// call the function of Each() when every other component
+	// was found
+	template <typename Function, typename First, typename... Rest, size_t... I>
+	static void Invoke(Function& fn, int slot, First& first, std::tuple<Rest*...>& others, std::index_sequence<I...>)
+	{
+		bool bFound[] = { true, (NULL != std::get<I>(others))... };
+		for (bool bHas : bFound)
+		{
+			if (false == bHas)
+			{
+				return;
+			}
+		}
+
+		fn(slot, first, *std::get<I>(others)...);
+	}
+};
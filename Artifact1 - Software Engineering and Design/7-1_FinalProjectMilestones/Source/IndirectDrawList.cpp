@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectdrawlist.cpp
+// ============
+// submit many meshes of a shared mesh buffer with multi-draw indirect calls
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "IndirectDrawList.h"
+
+// declaration of the vertex attribute locations
+namespace
+{
+	const GLuint g_DrawIDLocation = 9;
+}
+
+/***********************************************************
+ *  IndirectDrawList()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+IndirectDrawList::IndirectDrawList()
+{
+	m_commandBuffer = 0;
+	m_drawIDBuffer = 0;
+	m_submittedCount = 0;
+}
+
+/***********************************************************
+ *  ~IndirectDrawList()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+IndirectDrawList::~IndirectDrawList()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the current
+ *  OpenGL context provides multi-draw indirect, which is
+ *  core from version 4.3.
+ ***********************************************************/
+bool IndirectDrawList::IsSupported()
+{
+	GLint majorVersion = 0;
+	GLint minorVersion = 0;
+
+	glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+	glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+	return((majorVersion > 4) || ((4 == majorVersion) && (minorVersion >= 3)));
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the draws from the
+ *  list waiting to be uploaded.
+ ***********************************************************/
+void IndirectDrawList::Clear()
+{
+	m_commands.clear();
+	m_visibleCommands.clear();
+}
+
+/***********************************************************
+ *  AddDraw()
+ *
+ *  This method is used for appending a draw to the list.
+ ***********************************************************/
+void IndirectDrawList::AddDraw(const MeshBuffer::MESH_RANGE& range)
+{
+	DRAW_ELEMENTS_COMMAND command;
+	command.count = (GLuint)range.indexCount;
+	command.instanceCount = 1;
+	command.firstIndex = range.firstIndex;
+	command.baseVertex = range.baseVertex;
+	// the base instance offsets the draw ID attribute, so the
+	// single instance of the draw reads its own draw ID
+	command.baseInstance = (GLuint)m_commands.size();
+
+	m_commands.push_back(command);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for uploading the commands and for
+ *  attaching the draw ID attribute to the vertex array of
+ *  the mesh buffer.
+ ***********************************************************/
+void IndirectDrawList::Upload(const MeshBuffer& meshBuffer)
+{
+	std::vector<GLuint> drawIDs(m_commands.size());
+
+	if (true == m_commands.empty())
+	{
+		return;
+	}
+
+	if (0 == m_commandBuffer)
+	{
+		glGenBuffers(1, &m_commandBuffer);
+		glGenBuffers(1, &m_drawIDBuffer);
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER,
+		m_commands.size() * sizeof(DRAW_ELEMENTS_COMMAND),
+		m_commands.data(),
+		GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	m_submittedCount = (int)m_commands.size();
+
+	// draw IDs count up from 0 - one per instance, so the
+	// base instance of a command picks out its draw ID
+	for (size_t i = 0; i < drawIDs.size(); i++)
+	{
+		drawIDs[i] = (GLuint)i;
+	}
+
+	glBindVertexArray(meshBuffer.GetVertexArray());
+	glBindBuffer(GL_ARRAY_BUFFER, m_drawIDBuffer);
+	glBufferData(GL_ARRAY_BUFFER, drawIDs.size() * sizeof(GLuint), drawIDs.data(), GL_STATIC_DRAW);
+	glEnableVertexAttribArray(g_DrawIDLocation);
+	glVertexAttribIPointer(g_DrawIDLocation, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+	glVertexAttribDivisor(g_DrawIDLocation, 1);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the buffers.
+ ***********************************************************/
+void IndirectDrawList::Destroy()
+{
+	if (0 != m_commandBuffer)
+	{
+		glDeleteBuffers(1, &m_commandBuffer);
+		glDeleteBuffers(1, &m_drawIDBuffer);
+		m_commandBuffer = 0;
+		m_drawIDBuffer = 0;
+	}
+	m_submittedCount = 0;
+	Clear();
+}
+
+/***********************************************************
+ *  BeginVisibleDraws()
+ *
+ *  This method is used for making room for the commands of
+ *  the visible draws of this frame.
+ ***********************************************************/
+void IndirectDrawList::BeginVisibleDraws(int visibleCount)
+{
+	m_visibleCommands.resize(visibleCount);
+}
+
+/***********************************************************
+ *  SetVisibleDraw()
+ *
+ *  This method is used for copying the command of a visible
+ *  draw into its slot. The base instance is set to the slot,
+ *  so the command reads the per-draw values of the slot.
+ ***********************************************************/
+void IndirectDrawList::SetVisibleDraw(int slot, int draw)
+{
+	DRAW_ELEMENTS_COMMAND command = m_commands[draw];
+	command.baseInstance = (GLuint)slot;
+
+	m_visibleCommands[slot] = command;
+}
+
+/***********************************************************
+ *  UploadVisibleDraws()
+ *
+ *  This method is used for writing the commands of the
+ *  visible draws into the indirect buffer. The buffer is
+ *  orphaned first, so the draws of the last frame may still
+ *  read the old commands.
+ ***********************************************************/
+void IndirectDrawList::UploadVisibleDraws()
+{
+	if (0 == m_commandBuffer)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER,
+		m_commands.size() * sizeof(DRAW_ELEMENTS_COMMAND),
+		NULL,
+		GL_DYNAMIC_DRAW);
+	if (false == m_visibleCommands.empty())
+	{
+		glBufferSubData(GL_DRAW_INDIRECT_BUFFER,
+			0,
+			m_visibleCommands.size() * sizeof(DRAW_ELEMENTS_COMMAND),
+			m_visibleCommands.data());
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	m_submittedCount = (int)m_visibleCommands.size();
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used for drawing every uploaded command
+ *  with a single multi-draw indirect call.
+ ***********************************************************/
+void IndirectDrawList::Draw() const
+{
+	if ((0 == m_commandBuffer) || (0 == m_submittedCount))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+		(void*)0,
+		(GLsizei)m_submittedCount, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
\ No newline at end of file
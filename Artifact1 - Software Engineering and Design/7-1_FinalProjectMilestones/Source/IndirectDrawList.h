@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectdrawlist.h
+// ============
+// submit many meshes of a shared mesh buffer with multi-draw indirect calls
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshBuffer.h"
+
+#include <vector>
+
+/***********************************************************
+ *  IndirectDrawList
+ *
+ *  This class writes a list of draws into an indirect
+ *  command buffer. The vertex shader reads the per-draw
+ *  values of each draw by its draw ID, from a texture buffer
+ *  filled by the caller every frame. The draw ID comes from
+ *  an instanced vertex attribute offset by the base instance
+ *  of each command, since gl_DrawID is not available to
+ *  GLSL 3.30 shaders.
+ *
+ *  The whole list is drawn with one
+ *  glMultiDrawElementsIndirect() call, the texture of each
+ *  draw being picked from the texture arrays by its layer
+ *  reference. Multi-draw indirect needs an OpenGL 4.3
+ *  context.
+ *
+ *  Each frame the list can be narrowed down to the visible
+ *  draws. Their commands are packed to the front, and the
+ *  draw ID of a packed command is its slot, so the per-draw
+ *  values of the frame are packed the same way.
+ ***********************************************************/
+class IndirectDrawList
+{
+public:
+	// constructor
+	IndirectDrawList();
+	// destructor
+	~IndirectDrawList();
+
+	// per-draw values - seven RGBA texels per draw, the layout
+	// must match the draw data read in the vertex shader
+	struct DRAW_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		// UV scale in xy, material index in z, and the texture
+		// layer reference in w, -1 for color draws
+		glm::vec4 UVscaleMaterialLayer;
+		// offset and count of the point light list in xy, zw unused
+		glm::vec4 lightRange;
+	};
+
+	// check whether the current context can draw indirect
+	static bool IsSupported();
+
+	// remove all the draws from the list
+	void Clear();
+	// append a draw of a mesh range to the list
+	void AddDraw(const MeshBuffer::MESH_RANGE& range);
+	// upload the list and attach the draw IDs to the mesh buffer
+	void Upload(const MeshBuffer& meshBuffer);
+	// free the buffers
+	void Destroy();
+
+	// make room for the visible draws of this frame
+	void BeginVisibleDraws(int visibleCount);
+	// put the command of a draw into a slot of this frame -
+	// different slots may be set from different threads
+	void SetVisibleDraw(int slot, int draw);
+	// upload the commands of the visible draws
+	void UploadVisibleDraws();
+
+	// draw the uploaded commands, the mesh buffer must be bound
+	void Draw() const;
+
+	// number of draws in the list
+	int GetDrawCount() const { return((int)m_commands.size()); }
+	// number of draws submitted by Draw()
+	int GetSubmittedCount() const { return(m_submittedCount); }
+
+private:
+	// layout of one command in the indirect buffer
+	struct DRAW_ELEMENTS_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// indirect commands and draw IDs
+	GLuint m_commandBuffer;
+	GLuint m_drawIDBuffer;
+
+	// the list waiting to be uploaded
+	std::vector<DRAW_ELEMENTS_COMMAND> m_commands;
+	// commands of the visible draws of this frame
+	std::vector<DRAW_ELEMENTS_COMMAND> m_visibleCommands;
+	// commands in the indirect buffer
+	int m_submittedCount;
+};
\ No newline at end of file
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmesh.cpp
+// ============
+// draw many copies of one mesh with a single instanced draw call
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "InstancedMesh.h"
+
+#include <cstddef>
+
+// declaration of the vertex attribute locations
+namespace
+{
+	const GLuint g_PositionLocation = 0;
+	const GLuint g_NormalLocation = 1;
+	const GLuint g_TextureCoordinateLocation = 2;
+	// the instance model matrix takes up four locations, one per column
+	const GLuint g_InstanceModelLocation = 3;
+	const GLuint g_InstanceColorLocation = 7;
+	const GLuint g_InstanceUVScaleLocation = 8;
+}
+
+/***********************************************************
+ *  InstancedMesh()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+InstancedMesh::InstancedMesh()
+{
+	m_vao = 0;
+	m_vbos[0] = 0;
+	m_vbos[1] = 0;
+	m_vbos[2] = 0;
+	m_nIndices = 0;
+	m_nInstances = 0;
+	m_nInstanceCapacity = 0;
+}
+
+/***********************************************************
+ *  ~InstancedMesh()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+InstancedMesh::~InstancedMesh()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  CreateMesh()
+ *
+ *  This method is used for uploading the passed in mesh
+ *  data into the vertex buffers and configuring both the
+ *  per-vertex and the per-instance vertex attributes.
+ ***********************************************************/
+void InstancedMesh::CreateMesh(const MeshGeometry::MESH_DATA& mesh)
+{
+	const GLsizei vertexStride = sizeof(MeshGeometry::VERTEX);
+	const GLsizei instanceStride = sizeof(INSTANCE_DATA);
+
+	Destroy();
+
+	glGenVertexArrays(1, &m_vao);
+	glBindVertexArray(m_vao);
+	glGenBuffers(3, m_vbos);
+
+	// per-vertex data
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbos[0]);
+	glBufferData(GL_ARRAY_BUFFER,
+		mesh.vertices.size() * sizeof(MeshGeometry::VERTEX),
+		mesh.vertices.data(),
+		GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(g_PositionLocation);
+	glVertexAttribPointer(g_PositionLocation, 3, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, position));
+	glEnableVertexAttribArray(g_NormalLocation);
+	glVertexAttribPointer(g_NormalLocation, 3, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, normal));
+	glEnableVertexAttribArray(g_TextureCoordinateLocation);
+	glVertexAttribPointer(g_TextureCoordinateLocation, 2, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, textureCoordinate));
+
+	// index data
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vbos[1]);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+		mesh.indices.size() * sizeof(GLuint),
+		mesh.indices.data(),
+		GL_STATIC_DRAW);
+	m_nIndices = (GLsizei)mesh.indices.size();
+
+	// per-instance data - the attribute divisor of 1 advances
+	// these attributes once per instance instead of per vertex
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbos[2]);
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glEnableVertexAttribArray(g_InstanceModelLocation + column);
+		glVertexAttribPointer(g_InstanceModelLocation + column, 4, GL_FLOAT, GL_FALSE, instanceStride,
+			(void*)(offsetof(INSTANCE_DATA, model) + column * sizeof(glm::vec4)));
+		glVertexAttribDivisor(g_InstanceModelLocation + column, 1);
+	}
+	glEnableVertexAttribArray(g_InstanceColorLocation);
+	glVertexAttribPointer(g_InstanceColorLocation, 4, GL_FLOAT, GL_FALSE, instanceStride,
+		(void*)offsetof(INSTANCE_DATA, color));
+	glVertexAttribDivisor(g_InstanceColorLocation, 1);
+	glEnableVertexAttribArray(g_InstanceUVScaleLocation);
+	glVertexAttribPointer(g_InstanceUVScaleLocation, 2, GL_FLOAT, GL_FALSE, instanceStride,
+		(void*)offsetof(INSTANCE_DATA, UVscale));
+	glVertexAttribDivisor(g_InstanceUVScaleLocation, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  SetInstances()
+ *
+ *  This method is used for uploading the passed in instance
+ *  values into the instance buffer. The buffer storage is
+ *  only reallocated when the instance count grows.
+ ***********************************************************/
+void InstancedMesh::SetInstances(const std::vector<INSTANCE_DATA>& instances)
+{
+	if (0 == m_vao)
+	{
+		return;
+	}
+
+	m_nInstances = (GLsizei)instances.size();
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbos[2]);
+	if (m_nInstances > m_nInstanceCapacity)
+	{
+		glBufferData(GL_ARRAY_BUFFER,
+			instances.size() * sizeof(INSTANCE_DATA),
+			instances.data(),
+			GL_STATIC_DRAW);
+		m_nInstanceCapacity = m_nInstances;
+	}
+	else if (m_nInstances > 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0,
+			instances.size() * sizeof(INSTANCE_DATA),
+			instances.data());
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  UpdateInstances()
+ *
+ *  This method is used for writing the passed in instance
+ *  values over a run of the instances already uploaded, so
+ *  moving a few instances leaves the rest of the buffer
+ *  alone.
+ ***********************************************************/
+void InstancedMesh::UpdateInstances(int firstInstance, const INSTANCE_DATA* pInstances, int instanceCount)
+{
+	if ((0 == m_vao) || (firstInstance < 0) || (instanceCount <= 0) ||
+		(firstInstance + instanceCount > m_nInstances))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbos[2]);
+	glBufferSubData(GL_ARRAY_BUFFER,
+		firstInstance * sizeof(INSTANCE_DATA),
+		instanceCount * sizeof(INSTANCE_DATA),
+		pInstances);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used for drawing every instance of the
+ *  mesh with one instanced draw call.
+ ***********************************************************/
+void InstancedMesh::Draw() const
+{
+	if ((0 == m_vao) || (0 == m_nInstances))
+	{
+		return;
+	}
+
+	glBindVertexArray(m_vao);
+	glDrawElementsInstanced(GL_TRIANGLES, m_nIndices, GL_UNSIGNED_INT, (void*)0, m_nInstances);
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the vertex array and
+ *  the buffers from the GPU memory.
+ ***********************************************************/
+void InstancedMesh::Destroy()
+{
+	if (0 != m_vao)
+	{
+		glDeleteVertexArrays(1, &m_vao);
+		glDeleteBuffers(3, m_vbos);
+	}
+	m_vao = 0;
+	m_vbos[0] = 0;
+	m_vbos[1] = 0;
+	m_vbos[2] = 0;
+	m_nIndices = 0;
+	m_nInstances = 0;
+	m_nInstanceCapacity = 0;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmesh.h
+// ============
+// draw many copies of one mesh with a single instanced draw call
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+
+#include <vector>
+
+/***********************************************************
+ *  InstancedMesh
+ *
+ *  This class owns the vertex array of one mesh together
+ *  with a per-instance attribute buffer. Each instance
+ *  carries its own model matrix, color and texture UV scale,
+ *  so every copy of the mesh is drawn by one call to
+ *  glDrawElementsInstanced().
+ ***********************************************************/
+class InstancedMesh
+{
+public:
+	// constructor
+	InstancedMesh();
+	// destructor
+	~InstancedMesh();
+
+	// per-instance values - the layout must match the
+	// instance attributes declared in the vertex shader
+	struct INSTANCE_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		glm::vec2 UVscale;
+	};
+
+	// upload the mesh vertex data into the vertex buffers
+	void CreateMesh(const MeshGeometry::MESH_DATA& mesh);
+	// upload the instance values into the instance buffer
+	void SetInstances(const std::vector<INSTANCE_DATA>& instances);
+	// write a run of instances already in the instance buffer again
+	void UpdateInstances(int firstInstance, const INSTANCE_DATA* pInstances, int instanceCount);
+	// draw all the instances of the mesh
+	void Draw() const;
+	// free the vertex array and the buffers
+	void Destroy();
+
+	// number of instances in the instance buffer
+	GLsizei GetInstanceCount() const { return(m_nInstances); }
+
+private:
+	// vertex array object
+	GLuint m_vao;
+	// vertex buffer, index buffer and instance buffer
+	GLuint m_vbos[3];
+	// number of mesh indices
+	GLsizei m_nIndices;
+	// number of instances
+	GLsizei m_nInstances;
+	// allocated instance buffer capacity
+	GLsizei m_nInstanceCapacity;
+};
\ No newline at end of file
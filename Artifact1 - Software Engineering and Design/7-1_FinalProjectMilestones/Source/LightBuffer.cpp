@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightbuffer.cpp
+// ============
+// manage the list of point lights in a uniform buffer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightBuffer.h"
+
+#include <algorithm>
+#include <climits>
+
+/***********************************************************
+ *  LightBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightBuffer::LightBuffer()
+{
+	m_buffer = 0;
+	m_maxLights = 0;
+	m_dirtyFirst = INT_MAX;
+	m_dirtyLast = -1;
+}
+
+/***********************************************************
+ *  ~LightBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightBuffer::~LightBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the uniform buffer with
+ *  room for the passed in number of lights. The size must
+ *  match the light list declared in the fragment shader.
+ ***********************************************************/
+void LightBuffer::Create(int maxLights)
+{
+	Destroy();
+
+	m_maxLights = maxLights;
+
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+	glBufferData(GL_UNIFORM_BUFFER, m_maxLights * sizeof(LIGHT_BLOCK_ENTRY), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// write any lights added before the buffer existed
+	if (m_lights.size() > 0)
+	{
+		MarkDirty(0);
+		MarkDirty((int)m_lights.size() - 1);
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the uniform buffer.
+ ***********************************************************/
+void LightBuffer::Destroy()
+{
+	if (0 != m_buffer)
+	{
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+	}
+	m_maxLights = 0;
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a light to the end of the
+ *  list. The index of the new light is returned, or -1 when
+ *  the uniform buffer has no room left.
+ ***********************************************************/
+int LightBuffer::AddLight(const POINT_LIGHT& light)
+{
+	if ((int)m_lights.size() >= m_maxLights)
+	{
+		return(-1);
+	}
+
+	m_lights.push_back(light);
+	MarkDirty((int)m_lights.size() - 1);
+
+	return((int)m_lights.size() - 1);
+}
+
+/***********************************************************
+ *  SetLight()
+ *
+ *  This method is used for changing a light already in the
+ *  list. Only the changed lights are written on Upload().
+ ***********************************************************/
+void LightBuffer::SetLight(int index, const POINT_LIGHT& light)
+{
+	if ((index < 0) || (index >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	m_lights[index] = light;
+	MarkDirty(index);
+}
+
+/***********************************************************
+ *  ClearLights()
+ *
+ *  This method is used for removing all the lights. The
+ *  shaders only read the first GetLightCount() entries, so
+ *  the buffer contents do not need to be cleared.
+ ***********************************************************/
+void LightBuffer::ClearLights()
+{
+	m_lights.clear();
+	m_dirtyFirst = INT_MAX;
+	m_dirtyLast = -1;
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for growing the changed range so that
+ *  it includes the passed in light.
+ ***********************************************************/
+void LightBuffer::MarkDirty(int index)
+{
+	m_dirtyFirst = std::min(m_dirtyFirst, index);
+	m_dirtyLast = std::max(m_dirtyLast, index);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for writing the lights changed since
+ *  the last upload into the uniform buffer, with a single
+ *  partial update covering the changed range.
+ ***********************************************************/
+void LightBuffer::Upload()
+{
+	if ((0 == m_buffer) || (m_dirtyFirst > m_dirtyLast))
+	{
+		return;
+	}
+
+	std::vector<LIGHT_BLOCK_ENTRY> entries;
+	entries.reserve(m_dirtyLast - m_dirtyFirst + 1);
+
+	for (int i = m_dirtyFirst; i <= m_dirtyLast; i++)
+	{
+		LIGHT_BLOCK_ENTRY entry;
+		entry.position = glm::vec4(m_lights[i].position, m_lights[i].range);
+		entry.ambient = glm::vec4(m_lights[i].ambient, 0.0f);
+		entry.diffuse = glm::vec4(m_lights[i].diffuse, 0.0f);
+		entry.specular = glm::vec4(m_lights[i].specular, 0.0f);
+		entries.push_back(entry);
+	}
+
+	glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+	glBufferSubData(GL_UNIFORM_BUFFER,
+		m_dirtyFirst * sizeof(LIGHT_BLOCK_ENTRY),
+		entries.size() * sizeof(LIGHT_BLOCK_ENTRY),
+		entries.data());
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	m_dirtyFirst = INT_MAX;
+	m_dirtyLast = -1;
+}
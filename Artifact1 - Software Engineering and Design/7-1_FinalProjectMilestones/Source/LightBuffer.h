@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightbuffer.h
+// ============
+// manage the list of point lights in a uniform buffer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  LightBuffer
+ *
+ *  This class keeps the point lights of the scene in a CPU
+ *  list and mirrors it into a std140 uniform buffer. The
+ *  whole list is uploaded with one call, and lights changed
+ *  afterwards are written back with a partial buffer update
+ *  that only covers the changed range.
+ ***********************************************************/
+class LightBuffer
+{
+public:
+	// constructor
+	LightBuffer();
+	// destructor
+	~LightBuffer();
+
+	struct POINT_LIGHT
+	{
+		glm::vec3 position;
+		glm::vec3 ambient;
+		glm::vec3 diffuse;
+		glm::vec3 specular;
+		// distance at which the light fades out completely
+		float range;
+	};
+
+	// create the uniform buffer with room for the passed in lights
+	void Create(int maxLights);
+	// free the uniform buffer
+	void Destroy();
+
+	// add a light to the end of the list, -1 when the list is full
+	int AddLight(const POINT_LIGHT& light);
+	// change a light already in the list
+	void SetLight(int index, const POINT_LIGHT& light);
+	// remove all the lights from the list
+	void ClearLights();
+
+	// write the changed lights into the uniform buffer
+	void Upload();
+	// buffer object holding the lights, four vec4 texels per light
+	GLuint GetBufferID() const { return(m_buffer); }
+
+	// number of lights in the list
+	int GetLightCount() const { return((int)m_lights.size()); }
+	// maximum number of lights in the list
+	int GetMaxLights() const { return(m_maxLights); }
+	// get a light from the list
+	const POINT_LIGHT& GetLight(int index) const { return(m_lights[index]); }
+
+private:
+	// one std140 light list entry, the range is packed into
+	// the w of the position
+	struct LIGHT_BLOCK_ENTRY
+	{
+		glm::vec4 position;
+		glm::vec4 ambient;
+		glm::vec4 diffuse;
+		glm::vec4 specular;
+	};
+
+	// uniform buffer object
+	GLuint m_buffer;
+	// capacity of the uniform buffer in lights
+	int m_maxLights;
+	// lights of the scene
+	std::vector<POINT_LIGHT> m_lights;
+	// range of the lights changed since the last upload,
+	// empty when m_dirtyFirst > m_dirtyLast
+	int m_dirtyFirst;
+	int m_dirtyLast;
+
+	// grow the changed range to include the light
+	void MarkDirty(int index);
+};
\ No newline at end of file
@@ -1,190 +1,691 @@
-///////////////////////////////////////////////////////////////////////////////
-// maincode.cpp
-// ============
-// gets called when application is launched - initializes GLEW, GLFW
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include <iostream>         // error handling and output
-#include <cstdlib>          // EXIT_FAILURE
-
-#include <GL/glew.h>        // GLEW library
-#include "GLFW/glfw3.h"     // GLFW library
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "SceneManager.h"
-#include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
-
-// Namespace for declaring global variables
-namespace
-{
-	// Macro for window title
-	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
-	// software version number
-	const char* const SW_VERSION = "20241028";
-
-	// Main GLFW window
-	GLFWwindow* g_Window = nullptr;
-
-	// scene manager object for managing the 3D scene prepare and render
-	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
-	// view manager object for managing the 3D view setup and projection to 2D
-	ViewManager* g_ViewManager = nullptr;
-}
-
-// Function declarations - all functions that are called manually
-// need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
-
-
-/***********************************************************
- *  main(int, char*)
- *
- *  This function gets called after the application has been
- *  launched.
- ***********************************************************/
-int main(int argc, char* argv[])
-{
-	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
-	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
-
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-	// print the version to the console
-	std::cout << std::endl << "Version: " << SW_VERSION << std::endl;
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"shaders/vertexShader.glsl",
-		"shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
-	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
-	g_SceneManager->PrepareScene();
-
-	// loop will keep running until the application is closed 
-	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
-	{
-		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
-
-		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
-
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
-
-
-		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
-	}
-
-	// clear the allocated manager objects from memory
-	if (NULL != g_SceneManager)
-	{
-		delete g_SceneManager;
-		g_SceneManager = NULL;
-	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
-
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
-}
-
-/***********************************************************
- *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
- ***********************************************************/
-bool InitializeGLFW()
-{
-	// GLFW: initialize and configure library
-	// --------------------------------------
-	glfwInit();
-
-#ifdef __APPLE__
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#else
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-	// GLFW: end -------------------------------
-
-	return(true);
-}
-
-/***********************************************************
- *	InitializeGLEW()
- *
- *  This function is used to initialize the GLEW library.
- ***********************************************************/
-bool InitializeGLEW()
-{
-	// GLEW: initialize
-	// -----------------------------------------
-	GLenum GLEWInitResult = GLEW_OK;
-
-	// try to initialize the GLEW library
-	GLEWInitResult = glewInit();
-	if (GLEW_OK != GLEWInitResult)
-	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
-		return false;
-	}
-	// GLEW: end -------------------------------
-
-	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
-
-	return(true);
+///////////////////////////////////////////////////////////////////////////////
+// maincode.cpp
+// ============
+// gets called when application is launched - initializes GLEW, GLFW
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+#include <chrono>           // benchmark timing
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "PipelineStateCache.h"
+#include "TransformBatch.h"
+#include "CookedAssets.h"
+#include "CityGenerator.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
+	// software version number
+	const char* const SW_VERSION = "20241028";
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// uniform location table for setting shader values through handles
+	ShaderUniforms* g_ShaderUniforms = nullptr;
+	// cache of the pipeline state currently set in OpenGL
+	PipelineStateCache* g_PipelineState = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+
+	// print the per-frame render counters once per second
+	bool g_bShowRenderStats = false;
+	// evaluate only the lights of each fragment's light cluster
+	bool g_bUseClusteredLighting = true;
+	// evaluate only the lights reaching each object's bounds
+	bool g_bUseObjectLightLists = true;
+	// submit the draw list with multi-draw indirect when supported
+	bool g_bUseIndirectDraw = true;
+	// draw the static objects from merged pre-transformed meshes
+	bool g_bUseStaticBake = true;
+	// draw the scene geometry as lines instead of filled
+	bool g_bWireframe = false;
+	// time the model matrix composition and exit
+	bool g_bBenchTransforms = false;
+	// skip the draws outside the view frustum
+	bool g_bFrustumCulling = true;
+	// threads for the per-frame scene work, 0 for one per core
+	int g_WorkerThreads = 0;
+	// binary scene file drawn instead of the scene built in code
+	const char* g_SceneFilename = NULL;
+	// binary scene file the prepared scene is written into
+	const char* g_ExportSceneFilename = NULL;
+	// reload the scene file and the textures when the build
+	// step cooks them again
+	bool g_bWatchScene = false;
+	// decode the source images of the textures the build step
+	// has not cooked, for development only
+	bool g_bAllowSourceAssets = false;
+	// seconds between the checks for changed files
+	const double g_WatchInterval = 0.5;
+	// degrees per second the first house turns while R is held
+	const float g_HouseTurnSpeed = 45.0f;
+	// draw a generated city instead of the houses placed in code
+	bool g_bGenerateCity = false;
+	// layout of the generated city, any city option turns it on
+	CityGenerator::CITY_PARAMETERS g_CityParameters = CityGenerator::GetDefaultParameters();
+	// load the generated city in chunks around the camera
+	bool g_bStreamCity = false;
+	// chunk size and memory budget of the streamed city
+	WorldStreamer::STREAM_SETTINGS g_StreamSettings = WorldStreamer::GetDefaultSettings();
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+void RunTransformBenchmark();
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the application has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// process the command line options
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--stats") == 0)
+		{
+			g_bShowRenderStats = true;
+		}
+		else if (strcmp(argv[i], "--no-clusters") == 0)
+		{
+			g_bUseClusteredLighting = false;
+		}
+		else if (strcmp(argv[i], "--no-object-lights") == 0)
+		{
+			g_bUseObjectLightLists = false;
+		}
+		else if (strcmp(argv[i], "--no-indirect") == 0)
+		{
+			g_bUseIndirectDraw = false;
+		}
+		else if (strcmp(argv[i], "--no-bake") == 0)
+		{
+			g_bUseStaticBake = false;
+		}
+		else if (strcmp(argv[i], "--wireframe") == 0)
+		{
+			g_bWireframe = true;
+		}
+		else if (strcmp(argv[i], "--bench-transforms") == 0)
+		{
+			g_bBenchTransforms = true;
+		}
+		else if (strcmp(argv[i], "--no-culling") == 0)
+		{
+			g_bFrustumCulling = false;
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			g_WorkerThreads = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--scene") == 0) && (i + 1 < argc))
+		{
+			g_SceneFilename = argv[++i];
+		}
+		else if (strcmp(argv[i], "--watch-scene") == 0)
+		{
+			g_bWatchScene = true;
+		}
+		else if (strcmp(argv[i], "--allow-source-assets") == 0)
+		{
+			g_bAllowSourceAssets = true;
+		}
+		else if ((strcmp(argv[i], "--export-scene") == 0) && (i + 1 < argc))
+		{
+			g_ExportSceneFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--city") == 0) && (i + 2 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.blocksX = atoi(argv[++i]);
+			g_CityParameters.blocksZ = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--city-lots") == 0) && (i + 2 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.lotsX = atoi(argv[++i]);
+			g_CityParameters.lotsZ = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--city-seed") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+		}
+		else if ((strcmp(argv[i], "--city-empty") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.emptyLotChance = (float)atof(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--city-windmills") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.windmillChance = (float)atof(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--city-lights") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.maxLights = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--city-no-walls") == 0)
+		{
+			g_bGenerateCity = true;
+			g_CityParameters.bWalls = false;
+		}
+		else if (strcmp(argv[i], "--stream") == 0)
+		{
+			g_bGenerateCity = true;
+			g_bStreamCity = true;
+		}
+		else if ((strcmp(argv[i], "--stream-chunk") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_bStreamCity = true;
+			float chunkSize = (float)atof(argv[++i]);
+			if (chunkSize > 0.0f)
+			{
+				// the radii stay the same number of chunks
+				WorldStreamer::STREAM_SETTINGS defaults = WorldStreamer::GetDefaultSettings();
+				g_StreamSettings.chunkSize = chunkSize;
+				g_StreamSettings.loadRadius = defaults.loadRadius * chunkSize / defaults.chunkSize;
+				g_StreamSettings.unloadRadius = defaults.unloadRadius * chunkSize / defaults.chunkSize;
+			}
+			else
+			{
+				std::cerr << "ERROR: Invalid chunk size " << argv[i] << ", the default of "
+					<< g_StreamSettings.chunkSize << " is used" << std::endl;
+			}
+		}
+		else if ((strcmp(argv[i], "--stream-budget") == 0) && (i + 1 < argc))
+		{
+			g_bGenerateCity = true;
+			g_bStreamCity = true;
+			int budgetMB = atoi(argv[++i]);
+			if (budgetMB > 0)
+			{
+				g_StreamSettings.budgetBytes = (size_t)budgetMB * 1024 * 1024;
+			}
+			else
+			{
+				std::cerr << "ERROR: Invalid streaming budget " << argv[i] << ", the default of "
+					<< g_StreamSettings.budgetBytes / (1024 * 1024) << " MB is used" << std::endl;
+			}
+		}
+	}
+
+	// the benchmark runs on the CPU only, without a window
+	if (true == g_bBenchTransforms)
+	{
+		RunTransformBenchmark();
+		return(EXIT_SUCCESS);
+	}
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new shader uniforms object
+	g_ShaderUniforms = new ShaderUniforms();
+	// try to create a new pipeline state cache object
+	g_PipelineState = new PipelineStateCache();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager,
+		g_ShaderUniforms);
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	// print the version to the console
+	std::cout << std::endl << "Version: " << SW_VERSION << std::endl;
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// load the shader code from the external GLSL files, the
+	// cooked copies when the cook tool has been run
+	std::string vertexShaderFilename = CookedAssets::SelectFilename("shaders/vertexShader.glsl", NULL);
+	std::string fragmentShaderFilename = CookedAssets::SelectFilename("shaders/fragmentShader.glsl", NULL);
+	g_ShaderManager->LoadShaders(
+		vertexShaderFilename.c_str(),
+		fragmentShaderFilename.c_str());
+	g_ShaderManager->use();
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager, g_ShaderUniforms, g_PipelineState);
+	g_SceneManager->SetAllowSourceAssets(g_bAllowSourceAssets);
+	// look up the locations of all the registered uniforms once
+	g_ShaderUniforms->ResolveLocations();
+	std::string sceneFilename;
+	CookedAssets::FILE_STAMP sceneFileStamp = { 0, 0 };
+	if (NULL != g_SceneFilename)
+	{
+		// a scene description is only read once the build step
+		// has cooked it into a binary scene file, and a cooked
+		// scene older than its description is still used, since
+		// the description is not read at run time. A watched
+		// file is read into memory so it can be written again
+		std::string cookedSceneFilename = CookedAssets::GetCookedFilename(g_SceneFilename, ".scnb");
+		bool bCookedScene = (0 != CookedAssets::GetFileStamp(cookedSceneFilename.c_str()).writeTime);
+		if ((true == bCookedScene) && (false == CookedAssets::IsCookedCurrent(g_SceneFilename, cookedSceneFilename)))
+		{
+			std::cerr << "ERROR: The cooked scene " << cookedSceneFilename << " is older than " << g_SceneFilename
+				<< ", build the project to cook it again - the last cooked scene is used" << std::endl;
+		}
+		sceneFilename = (true == bCookedScene) ? cookedSceneFilename : std::string(g_SceneFilename);
+		sceneFileStamp = CookedAssets::GetFileStamp(sceneFilename.c_str());
+		double openStart = glfwGetTime();
+		if (true == g_SceneManager->OpenSceneFile(sceneFilename.c_str(), g_bWatchScene))
+		{
+			// only the open is timed, the objects are copied into
+			// the draw list when the scene is prepared
+			std::cout << "INFO: Scene file " << sceneFilename << ((true == g_bWatchScene) ? " read in " : " mapped in ")
+				<< (glfwGetTime() - openStart) * 1000.0 << " ms, its objects are recorded when the scene is prepared" << std::endl;
+		}
+		else
+		{
+			std::cerr << "ERROR: Could not open the scene file " << sceneFilename << std::endl;
+		}
+	}
+	else if (true == g_bGenerateCity)
+	{
+		CityGenerator city;
+		double generateStart = glfwGetTime();
+		city.Generate(g_CityParameters);
+		std::cout << "INFO: City of " << g_CityParameters.blocksX << "x" << g_CityParameters.blocksZ
+			<< " blocks generated in " << (glfwGetTime() - generateStart) * 1000.0 << " ms - "
+			<< city.GetPlacementCount(CityGenerator::PLACE_HOUSE) +
+				city.GetPlacementCount(CityGenerator::PLACE_HOUSE2) +
+				city.GetPlacementCount(CityGenerator::PLACE_HOUSE3) << " houses, "
+			<< city.GetPlacementCount(CityGenerator::PLACE_WINDMILL) << " windmills, "
+			<< city.GetPlacementCount(CityGenerator::PLACE_WALL) << " walls, "
+			<< city.GetLightPositions().size() << " lights" << std::endl;
+		g_SceneManager->GenerateCity(city);
+		g_SceneManager->SetWorldStreaming(g_bStreamCity, g_StreamSettings);
+	}
+	g_SceneManager->PrepareScene();
+	if (NULL != g_ExportSceneFilename)
+	{
+		if (true == g_SceneManager->ExportSceneFile(g_ExportSceneFilename))
+		{
+			std::cout << "INFO: Scene written to " << g_ExportSceneFilename << std::endl;
+		}
+		else
+		{
+			std::cerr << "ERROR: Could not write the scene file " << g_ExportSceneFilename << std::endl;
+		}
+	}
+	g_SceneManager->SetClusteredLighting(g_bUseClusteredLighting);
+	g_SceneManager->SetObjectLightLists(g_bUseObjectLightLists);
+	g_SceneManager->SetIndirectDraw(g_bUseIndirectDraw);
+	g_SceneManager->SetStaticBake(g_bUseStaticBake);
+	g_SceneManager->SetWireframe(g_bWireframe);
+	g_SceneManager->SetFrustumCulling(g_bFrustumCulling);
+	g_SceneManager->SetWorkerThreads(g_WorkerThreads);
+
+	// the clear color never changes, so it is only set once
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+	double lastStatsTime = glfwGetTime();
+	double lastWatchTime = glfwGetTime();
+	bool bPickButtonHeld = false;
+	double lastFrameTime = glfwGetTime();
+
+	// loop will keep running until the application is closed 
+	// or until an error has occurred
+	while (!glfwWindowShouldClose(g_Window))
+	{
+		// start counting the uniform uploads and the state
+		// transitions of this frame
+		g_ShaderUniforms->ResetFrameCounters();
+		g_PipelineState->ResetFrameCounters();
+
+		// the depth buffer is only cleared while depth writes
+		// are on, which the opaque state guarantees
+		g_PipelineState->Apply(PipelineStateCache::Opaque());
+
+		// Clear the frame and z buffers
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// apply the changes of the watched files before the frame
+		if ((true == g_bWatchScene) && (glfwGetTime() - lastWatchTime >= g_WatchInterval))
+		{
+			lastWatchTime = glfwGetTime();
+
+			// a saved scene description is picked up once the
+			// build step writes the binary scene file again
+			CookedAssets::FILE_STAMP fileStamp = CookedAssets::GetFileStamp(sceneFilename.c_str());
+			if ((false == sceneFilename.empty()) && (0 != fileStamp.writeTime) && (false == CookedAssets::IsSameStamp(fileStamp, sceneFileStamp)))
+			{
+				SceneManager::RELOAD_STATS reload;
+				double reloadStart = glfwGetTime();
+				// a file still being written fails to load, and is
+				// tried again on the next check
+				if (true == g_SceneManager->ReloadSceneFile(sceneFilename.c_str(), reload))
+				{
+					sceneFileStamp = fileStamp;
+					std::cout << "INFO: Scene reloaded in " << (glfwGetTime() - reloadStart) * 1000.0 << " ms - "
+						<< reload.nodesMoved << " nodes moved, "
+						<< reload.objectsAdded << " objects added, "
+						<< reload.objectsRemoved << " removed"
+						<< ((true == reload.bRebuilt) ? ", nodes changed so the scene was rebuilt" : "") << std::endl;
+				}
+			}
+
+			int texturesReloaded = g_SceneManager->ReloadChangedTextures();
+			if (texturesReloaded > 0)
+			{
+				std::cout << "INFO: " << texturesReloaded << " textures reloaded" << std::endl;
+			}
+		}
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// find the lights that reach into each light cluster
+		g_SceneManager->UpdateLightClusters(
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix(),
+			g_ViewManager->GetNearPlane(),
+			g_ViewManager->GetFarPlane(),
+			g_ViewManager->GetViewportSize());
+
+		// skip the objects outside the view of this frame
+		g_SceneManager->SetCullingView(
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix());
+
+		// load the chunks of a streamed city around the camera
+		if (true == g_bStreamCity)
+		{
+			glm::mat4 cameraMatrix = glm::inverse(g_ViewManager->GetViewMatrix());
+			g_SceneManager->UpdateWorldStreaming(glm::vec3(cameraMatrix[3]));
+		}
+
+		// holding R turns the first house in place, which only
+		// recomputes the nodes and lights of that house
+		double frameTime = glfwGetTime();
+		glm::vec3 houseRotation;
+		glm::vec3 housePosition;
+		if ((GLFW_PRESS == glfwGetKey(g_Window, GLFW_KEY_R)) &&
+			(true == g_SceneManager->GetHouseTransform(0, houseRotation, housePosition)))
+		{
+			houseRotation.y += g_HouseTurnSpeed * (float)(frameTime - lastFrameTime);
+			g_SceneManager->SetHouseTransform(0, houseRotation, housePosition);
+		}
+		lastFrameTime = frameTime;
+
+		// refresh the 3D scene
+		g_SceneManager->RenderScene();
+
+		// the cursor is captured to look around, so a left click
+		// picks the object at the center of the view
+		bool bPickButtonDown = (GLFW_PRESS == glfwGetMouseButton(g_Window, GLFW_MOUSE_BUTTON_LEFT));
+		if ((true == bPickButtonDown) && (false == bPickButtonHeld))
+		{
+			glm::mat4 cameraMatrix = glm::inverse(g_ViewManager->GetViewMatrix());
+			SceneManager::PICK_RESULT pick;
+			if (true == g_SceneManager->PickObject(glm::vec3(cameraMatrix[3]), -glm::vec3(cameraMatrix[2]), pick))
+			{
+				std::cout << "INFO: Picked " << MeshGeometry::GetShapeName(pick.meshID)
+					<< " below node " << pick.transformNode
+					<< " at " << pick.distance << " units" << std::endl;
+			}
+			else
+			{
+				std::cout << "INFO: Nothing picked" << std::endl;
+			}
+		}
+		bPickButtonHeld = bPickButtonDown;
+
+		// report the render counters of the last frame
+		if ((true == g_bShowRenderStats) && (glfwGetTime() - lastStatsTime >= 1.0))
+		{
+			const SceneManager::RENDER_STATS& stats = g_SceneManager->GetRenderStats();
+			const ShaderUniforms::UPLOAD_STATS& uploads = g_ShaderUniforms->GetFrameCounters();
+			const ClusteredLighting::CLUSTER_STATS& clusters = g_SceneManager->GetClusterStats();
+			const ObjectLightLists::LIGHT_LIST_STATS& objectLights = g_SceneManager->GetObjectLightStats();
+			const StreamBuffer::STREAM_STATS& stream = g_SceneManager->GetStreamStats();
+			const PipelineStateCache::STATE_STATS& states = g_PipelineState->GetFrameCounters();
+			std::cout << "INFO: Draw calls: " << stats.drawCalls
+				<< ", state changes: " << stats.stateChanges
+				<< ", avoided: " << stats.stateChangesAvoided
+				<< ", transforms updated: " << stats.transformsUpdated
+				<< ", draws culled: " << stats.drawsCulled
+				<< ", stream fallbacks: " << stats.streamFallbacks
+				<< ", uniform uploads: " << uploads.uploadsIssued
+				<< ", skipped: " << uploads.uploadsSkipped
+				<< ", visible lights: " << clusters.visibleLights
+				<< ", cluster light indices: " << clusters.lightIndices
+				<< ", max per cluster: " << clusters.maxClusterLights
+				<< ", object light indices: " << objectLights.lightIndices
+				<< ", max per object: " << objectLights.maxObjectLights
+				<< ", streamed bytes: " << stream.bytesWritten
+				<< ", fence waits: " << stream.fenceWaits
+				<< ", GL state calls: " << states.transitions
+				<< ", redundant states: " << states.transitionsSkipped << std::endl;
+			if (true == g_bStreamCity)
+			{
+				const WorldStreamer::STREAM_STATS& streaming = g_SceneManager->GetWorldStreamStats();
+				std::cout << "INFO: Chunks loaded: " << streaming.chunksLoaded << " of " << streaming.chunks
+					<< ", loading: " << streaming.chunksLoading
+					<< ", loads: " << streaming.loads
+					<< ", unloads: " << streaming.unloads
+					<< ", evictions: " << streaming.evictions
+					<< ", over budget: " << streaming.chunksOverBudget
+					<< ", resident KB: " << streaming.residentBytes / 1024 << std::endl;
+			}
+			lastStatsTime = glfwGetTime();
+		}
+
+		// Flips the the back buffer with the front buffer every frame.
+		glfwSwapBuffers(g_Window);
+
+		// query the latest GLFW events
+		glfwPollEvents();
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_PipelineState)
+	{
+		delete g_PipelineState;
+		g_PipelineState = NULL;
+	}
+	if (NULL != g_ShaderUniforms)
+	{
+		delete g_ShaderUniforms;
+		g_ShaderUniforms = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS); 
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ * 
+ *  This function is used to initialize the GLFW library.   
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	// Displays a successful OpenGL initialization message
+	std::cout << "INFO: OpenGL Successfully Initialized\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *	RunTransformBenchmark()
+ *
+ *  This function is used to time the model matrix
+ *  composition of the glm calls against the batched
+ *  transform kernel, for 1k, 100k and 1M objects.
+ ***********************************************************/
+void RunTransformBenchmark()
+{
+	const int objectCounts[] = { 1000, 100000, 1000000 };
+
+	for (int objectCount : objectCounts)
+	{
+		std::vector<glm::vec3> scales(objectCount);
+		std::vector<glm::vec3> rotations(objectCount);
+		std::vector<glm::vec3> positions(objectCount);
+		std::vector<glm::mat4> glmMatrices(objectCount);
+		std::vector<glm::mat4> batchMatrices(objectCount);
+		TransformBatch batch;
+
+		// the same pseudo-random values on every run
+		unsigned int seed = 12345;
+		auto nextValue = [&seed](float low, float high)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return(low + (high - low) * (float)(seed >> 8) / 16777216.0f);
+		};
+
+		batch.Reserve(objectCount);
+		for (int i = 0; i < objectCount; i++)
+		{
+			scales[i] = glm::vec3(nextValue(0.1f, 4.0f), nextValue(0.1f, 4.0f), nextValue(0.1f, 4.0f));
+			rotations[i] = glm::vec3(nextValue(-360.0f, 360.0f), nextValue(-360.0f, 360.0f), nextValue(-360.0f, 360.0f));
+			positions[i] = glm::vec3(nextValue(-50.0f, 50.0f), nextValue(-50.0f, 50.0f), nextValue(-50.0f, 50.0f));
+			batch.Add(scales[i], rotations[i], positions[i]);
+		}
+
+		// the small counts are repeated for a steadier time
+		int repeats = (objectCount < 1000000) ? (1000000 / objectCount) : 1;
+
+		auto glmStart = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; r++)
+		{
+			for (int i = 0; i < objectCount; i++)
+			{
+				glm::mat4 scale = glm::scale(scales[i]);
+				glm::mat4 rotationX = glm::rotate(glm::radians(rotations[i].x), glm::vec3(1.0f, 0.0f, 0.0f));
+				glm::mat4 rotationY = glm::rotate(glm::radians(rotations[i].y), glm::vec3(0.0f, 1.0f, 0.0f));
+				glm::mat4 rotationZ = glm::rotate(glm::radians(rotations[i].z), glm::vec3(0.0f, 0.0f, 1.0f));
+				glm::mat4 translation = glm::translate(positions[i]);
+				glmMatrices[i] = translation * rotationZ * rotationY * rotationX * scale;
+			}
+		}
+		auto glmEnd = std::chrono::steady_clock::now();
+
+		for (int r = 0; r < repeats; r++)
+		{
+			batch.ComputeMatrices(batchMatrices.data());
+		}
+		auto batchEnd = std::chrono::steady_clock::now();
+
+		// largest difference between the two results
+		float maxError = 0.0f;
+		for (int i = 0; i < objectCount; i++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					maxError = glm::max(maxError, glm::abs(glmMatrices[i][column][row] - batchMatrices[i][column][row]));
+				}
+			}
+		}
+
+		double glmMs = std::chrono::duration<double, std::milli>(glmEnd - glmStart).count() / repeats;
+		double batchMs = std::chrono::duration<double, std::milli>(batchEnd - glmEnd).count() / repeats;
+		std::cout << "INFO: " << objectCount << " transforms - glm: " << glmMs
+			<< " ms, batched: " << batchMs
+			<< " ms, speedup: " << ((batchMs > 0.0) ? (glmMs / batchMs) : 0.0)
+			<< "x, max difference: " << maxError << std::endl;
+	}
 }
\ No newline at end of file
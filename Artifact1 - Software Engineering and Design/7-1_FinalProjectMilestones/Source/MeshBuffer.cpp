@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshbuffer.cpp
+// ============
+// pack the vertex and index data of many meshes into shared buffers
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshBuffer.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// declaration of the vertex attribute locations
+namespace
+{
+	const GLuint g_PositionLocation = 0;
+	const GLuint g_NormalLocation = 1;
+	const GLuint g_TextureCoordinateLocation = 2;
+}
+
+/***********************************************************
+ *  MeshBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MeshBuffer::MeshBuffer()
+{
+	m_vao = 0;
+	m_vbos[0] = 0;
+	m_vbos[1] = 0;
+}
+
+/***********************************************************
+ *  ~MeshBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MeshBuffer::~MeshBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for appending the passed in mesh data
+ *  to the shared vertex and index data. The mesh indices are
+ *  kept relative to the mesh, and the base vertex of its
+ *  range moves them to the mesh's vertices when drawing.
+ *  The returned mesh ID counts up from 0 in the order the
+ *  meshes are added.
+ ***********************************************************/
+int MeshBuffer::AddMesh(const MeshGeometry::MESH_DATA& mesh)
+{
+	MESH_RANGE range;
+	range.firstIndex = (GLuint)m_indices.size();
+	range.indexCount = (GLsizei)mesh.indices.size();
+	range.baseVertex = (GLint)m_vertices.size();
+	range.vertexCount = (GLsizei)mesh.vertices.size();
+
+	m_vertices.insert(m_vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+	m_indices.insert(m_indices.end(), mesh.indices.begin(), mesh.indices.end());
+	m_ranges.push_back(range);
+
+	MeshGeometry::MESH_BOUNDS bounds;
+	MeshGeometry::ComputeBounds(mesh, bounds);
+	m_bounds.push_back(bounds);
+
+	return((int)m_ranges.size() - 1);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for uploading the shared vertex and
+ *  index data into the buffers and configuring the vertex
+ *  attributes. It is called once, after all the meshes have
+ *  been added.
+ ***********************************************************/
+void MeshBuffer::Upload()
+{
+	const GLsizei vertexStride = sizeof(MeshGeometry::VERTEX);
+
+	if (0 == m_vao)
+	{
+		glGenVertexArrays(1, &m_vao);
+		glGenBuffers(2, m_vbos);
+	}
+	glBindVertexArray(m_vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbos[0]);
+	glBufferData(GL_ARRAY_BUFFER,
+		m_vertices.size() * sizeof(MeshGeometry::VERTEX),
+		m_vertices.data(),
+		GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(g_PositionLocation);
+	glVertexAttribPointer(g_PositionLocation, 3, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, position));
+	glEnableVertexAttribArray(g_NormalLocation);
+	glVertexAttribPointer(g_NormalLocation, 3, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, normal));
+	glEnableVertexAttribArray(g_TextureCoordinateLocation);
+	glVertexAttribPointer(g_TextureCoordinateLocation, 2, GL_FLOAT, GL_FALSE, vertexStride,
+		(void*)offsetof(MeshGeometry::VERTEX, textureCoordinate));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vbos[1]);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+		m_indices.size() * sizeof(GLuint),
+		m_indices.data(),
+		GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  CollapseIndices()
+ *
+ *  This method is used for pointing a run of the indices of
+ *  one mesh at its first vertex. The triangles of the run
+ *  have no area and are dropped by the rasterizer, so part
+ *  of a mesh stops being drawn without the shared data being
+ *  packed again. The run is indexed from the first index of
+ *  the mesh, and is also written into the index buffer once
+ *  the data is uploaded.
+ ***********************************************************/
+void MeshBuffer::CollapseIndices(int meshID, GLuint firstIndex, GLsizei indexCount)
+{
+	if ((meshID < 0) || (meshID >= (int)m_ranges.size()))
+	{
+		return;
+	}
+
+	const MESH_RANGE& range = m_ranges[meshID];
+	if ((indexCount <= 0) || (firstIndex + indexCount > (GLuint)range.indexCount))
+	{
+		return;
+	}
+
+	GLuint first = range.firstIndex + firstIndex;
+	std::fill(m_indices.begin() + first, m_indices.begin() + first + indexCount, 0);
+
+	if (0 != m_vao)
+	{
+		// the index buffer is bound through the vertex array
+		glBindVertexArray(m_vao);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER,
+			first * sizeof(GLuint),
+			indexCount * sizeof(GLuint),
+			m_indices.data() + first);
+		glBindVertexArray(0);
+	}
+}
+
+/***********************************************************
+ *  GetMeshData()
+ *
+ *  This method is used for copying the vertex and index data
+ *  of one mesh out of the shared data. The indices are
+ *  relative to the first vertex of the mesh.
+ ***********************************************************/
+void MeshBuffer::GetMeshData(int meshID, MeshGeometry::MESH_DATA& mesh) const
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	if ((meshID < 0) || (meshID >= (int)m_ranges.size()))
+	{
+		return;
+	}
+
+	const MESH_RANGE& range = m_ranges[meshID];
+	mesh.vertices.assign(
+		m_vertices.begin() + range.baseVertex,
+		m_vertices.begin() + range.baseVertex + range.vertexCount);
+	mesh.indices.assign(
+		m_indices.begin() + range.firstIndex,
+		m_indices.begin() + range.firstIndex + range.indexCount);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the vertex array and the
+ *  buffers, together with the shared mesh data.
+ ***********************************************************/
+void MeshBuffer::Destroy()
+{
+	if (0 != m_vao)
+	{
+		glDeleteVertexArrays(1, &m_vao);
+		glDeleteBuffers(2, m_vbos);
+		m_vao = 0;
+		m_vbos[0] = 0;
+		m_vbos[1] = 0;
+	}
+	m_vertices.clear();
+	m_indices.clear();
+	m_ranges.clear();
+	m_bounds.clear();
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for making the shared vertex array
+ *  current, so any of the meshes can be drawn.
+ ***********************************************************/
+void MeshBuffer::Bind() const
+{
+	glBindVertexArray(m_vao);
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used for drawing one mesh out of the
+ *  shared buffers. The shared vertex array must be bound.
+ ***********************************************************/
+void MeshBuffer::DrawMesh(int meshID) const
+{
+	if ((meshID < 0) || (meshID >= (int)m_ranges.size()))
+	{
+		return;
+	}
+
+	const MESH_RANGE& range = m_ranges[meshID];
+	glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+		(void*)(range.firstIndex * sizeof(GLuint)), range.baseVertex);
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshbuffer.h
+// ============
+// pack the vertex and index data of many meshes into shared buffers
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshGeometry.h"
+
+#include <vector>
+
+/***********************************************************
+ *  MeshBuffer
+ *
+ *  This class packs any number of meshes into one vertex
+ *  buffer and one index buffer behind a single vertex array.
+ *  Each mesh is found through its range in the offset table,
+ *  so switching between meshes needs no rebinding, and all
+ *  the meshes can be drawn by one indirect draw call.
+ ***********************************************************/
+class MeshBuffer
+{
+public:
+	// constructor
+	MeshBuffer();
+	// destructor
+	~MeshBuffer();
+
+	// where a mesh lives in the shared buffers
+	struct MESH_RANGE
+	{
+		// first index of the mesh in the index buffer
+		GLuint firstIndex;
+		// number of indices of the mesh
+		GLsizei indexCount;
+		// offset added to every index of the mesh
+		GLint baseVertex;
+		// number of vertices of the mesh
+		GLsizei vertexCount;
+	};
+
+	// append a mesh to the shared data and get its mesh ID
+	int AddMesh(const MeshGeometry::MESH_DATA& mesh);
+	// upload the shared data into the vertex and index buffers
+	void Upload();
+	// free the vertex array and the buffers
+	void Destroy();
+
+	// make the shared vertex array current
+	void Bind() const;
+	// draw one mesh, the vertex array must be bound
+	void DrawMesh(int meshID) const;
+
+	// turn a run of the indices of a mesh into degenerate
+	// triangles, so that part of the mesh is no longer drawn
+	void CollapseIndices(int meshID, GLuint firstIndex, GLsizei indexCount);
+
+	// copy the vertex and index data of a mesh back out
+	void GetMeshData(int meshID, MeshGeometry::MESH_DATA& mesh) const;
+	// get the range of a mesh in the shared buffers
+	const MESH_RANGE& GetRange(int meshID) const { return(m_ranges[meshID]); }
+	// get the box around the vertices of a mesh
+	const MeshGeometry::MESH_BOUNDS& GetBounds(int meshID) const { return(m_bounds[meshID]); }
+	// number of meshes in the shared buffers
+	int GetMeshCount() const { return((int)m_ranges.size()); }
+	// shared vertex array object
+	GLuint GetVertexArray() const { return(m_vao); }
+
+private:
+	// vertex array object
+	GLuint m_vao;
+	// vertex buffer and index buffer
+	GLuint m_vbos[2];
+	// vertex and index data of all the meshes
+	std::vector<MeshGeometry::VERTEX> m_vertices;
+	std::vector<GLuint> m_indices;
+	// offset table, indexed by mesh ID
+	std::vector<MESH_RANGE> m_ranges;
+	// box around every mesh, indexed by mesh ID
+	std::vector<MeshGeometry::MESH_BOUNDS> m_bounds;
+};
\ No newline at end of file
@@ -0,0 +1,664 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshgeometry.cpp
+// ============
+// build CPU-side vertex and index data for the basic 3D shapes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshGeometry.h"
+
+#include <cmath>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	const float g_Pi = 3.14159265358979f;
+
+	// number of segments around the round shapes
+	const int g_RoundSectors = 36;
+	// number of segments from pole to pole of the sphere
+	const int g_SphereStacks = 18;
+	// number of segments around the tube of the torus
+	const int g_TorusTubeSectors = 18;
+	// radius of the tube of the torus
+	const float g_TorusTubeRadius = 0.2f;
+
+	// names of the basic shapes, in SHAPE_ID order
+	const char* const g_ShapeNames[MeshGeometry::SHAPE_COUNT] =
+	{
+		"box",
+		"plane",
+		"cylinder",
+		"cone",
+		"prism",
+		"pyramid4",
+		"sphere",
+		"tapered_cylinder",
+		"torus"
+	};
+}
+
+/***********************************************************
+ *  AddQuad()
+ *
+ *  This method is used for appending a four sided face to
+ *  the mesh data. The corners are passed in counter-clockwise
+ *  order when looking at the front of the face.
+ ***********************************************************/
+void MeshGeometry::AddQuad(
+	MESH_DATA& mesh,
+	glm::vec3 corner0,
+	glm::vec3 corner1,
+	glm::vec3 corner2,
+	glm::vec3 corner3,
+	glm::vec3 normal)
+{
+	GLuint firstVertex = (GLuint)mesh.vertices.size();
+
+	mesh.vertices.push_back({ corner0, normal, glm::vec2(0.0f, 0.0f) });
+	mesh.vertices.push_back({ corner1, normal, glm::vec2(1.0f, 0.0f) });
+	mesh.vertices.push_back({ corner2, normal, glm::vec2(1.0f, 1.0f) });
+	mesh.vertices.push_back({ corner3, normal, glm::vec2(0.0f, 1.0f) });
+
+	// two triangles per face
+	mesh.indices.push_back(firstVertex + 0);
+	mesh.indices.push_back(firstVertex + 1);
+	mesh.indices.push_back(firstVertex + 2);
+	mesh.indices.push_back(firstVertex + 0);
+	mesh.indices.push_back(firstVertex + 2);
+	mesh.indices.push_back(firstVertex + 3);
+}
+
+/***********************************************************
+ *  AddTriangle()
+ *
+ *  This method is used for appending a three sided face to
+ *  the mesh data. The corners are passed in counter-clockwise
+ *  order when looking at the front of the face.
+ ***********************************************************/
+void MeshGeometry::AddTriangle(
+	MESH_DATA& mesh,
+	glm::vec3 corner0,
+	glm::vec3 corner1,
+	glm::vec3 corner2,
+	glm::vec3 normal)
+{
+	GLuint firstVertex = (GLuint)mesh.vertices.size();
+
+	mesh.vertices.push_back({ corner0, normal, glm::vec2(0.0f, 0.0f) });
+	mesh.vertices.push_back({ corner1, normal, glm::vec2(1.0f, 0.0f) });
+	mesh.vertices.push_back({ corner2, normal, glm::vec2(0.5f, 1.0f) });
+
+	mesh.indices.push_back(firstVertex + 0);
+	mesh.indices.push_back(firstVertex + 1);
+	mesh.indices.push_back(firstVertex + 2);
+}
+
+/***********************************************************
+ *  BuildBoxMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  box that spans -0.5 to 0.5 on each axis.
+ ***********************************************************/
+void MeshGeometry::BuildBoxMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	// front side
+	AddQuad(mesh,
+		glm::vec3(-0.5f, -0.5f, 0.5f), glm::vec3(0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(-0.5f, 0.5f, 0.5f),
+		glm::vec3(0.0f, 0.0f, 1.0f));
+	// back side
+	AddQuad(mesh,
+		glm::vec3(0.5f, -0.5f, -0.5f), glm::vec3(-0.5f, -0.5f, -0.5f),
+		glm::vec3(-0.5f, 0.5f, -0.5f), glm::vec3(0.5f, 0.5f, -0.5f),
+		glm::vec3(0.0f, 0.0f, -1.0f));
+	// left side
+	AddQuad(mesh,
+		glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(-0.5f, -0.5f, 0.5f),
+		glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(-0.5f, 0.5f, -0.5f),
+		glm::vec3(-1.0f, 0.0f, 0.0f));
+	// right side
+	AddQuad(mesh,
+		glm::vec3(0.5f, -0.5f, 0.5f), glm::vec3(0.5f, -0.5f, -0.5f),
+		glm::vec3(0.5f, 0.5f, -0.5f), glm::vec3(0.5f, 0.5f, 0.5f),
+		glm::vec3(1.0f, 0.0f, 0.0f));
+	// top side
+	AddQuad(mesh,
+		glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(0.5f, 0.5f, 0.5f),
+		glm::vec3(0.5f, 0.5f, -0.5f), glm::vec3(-0.5f, 0.5f, -0.5f),
+		glm::vec3(0.0f, 1.0f, 0.0f));
+	// bottom side
+	AddQuad(mesh,
+		glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.5f, -0.5f, -0.5f),
+		glm::vec3(0.5f, -0.5f, 0.5f), glm::vec3(-0.5f, -0.5f, 0.5f),
+		glm::vec3(0.0f, -1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  BuildPrismMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  triangular prism. The triangle lies in the XZ plane with
+ *  its base edge at Z = -0.5 and its peak at Z = 0.5, and it
+ *  is extruded from -0.5 to 0.5 along the Y axis - so the
+ *  roof transforms used with the ShapeMeshes prism produce
+ *  the same roof shape.
+ ***********************************************************/
+void MeshGeometry::BuildPrismMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	glm::vec3 baseLeftTop = glm::vec3(-0.5f, 0.5f, -0.5f);
+	glm::vec3 baseRightTop = glm::vec3(0.5f, 0.5f, -0.5f);
+	glm::vec3 peakTop = glm::vec3(0.0f, 0.5f, 0.5f);
+	glm::vec3 baseLeftBottom = glm::vec3(-0.5f, -0.5f, -0.5f);
+	glm::vec3 baseRightBottom = glm::vec3(0.5f, -0.5f, -0.5f);
+	glm::vec3 peakBottom = glm::vec3(0.0f, -0.5f, 0.5f);
+
+	// triangle ends
+	AddTriangle(mesh, baseLeftTop, peakTop, baseRightTop,
+		glm::vec3(0.0f, 1.0f, 0.0f));
+	AddTriangle(mesh, baseRightBottom, peakBottom, baseLeftBottom,
+		glm::vec3(0.0f, -1.0f, 0.0f));
+
+	// base side
+	AddQuad(mesh, baseLeftBottom, baseLeftTop, baseRightTop, baseRightBottom,
+		glm::vec3(0.0f, 0.0f, -1.0f));
+	// slanted sides
+	AddQuad(mesh, baseRightBottom, baseRightTop, peakTop, peakBottom,
+		glm::normalize(glm::vec3(2.0f, 0.0f, 1.0f)));
+	AddQuad(mesh, peakBottom, peakTop, baseLeftTop, baseLeftBottom,
+		glm::normalize(glm::vec3(-2.0f, 0.0f, 1.0f)));
+}
+
+/***********************************************************
+ *  AddRoundSide()
+ *
+ *  This method is used for appending the round side of a
+ *  cylinder, cone or tapered cylinder. The side runs from
+ *  Y = 0 to Y = 1 and the normals are smoothed around it.
+ ***********************************************************/
+void MeshGeometry::AddRoundSide(
+	MESH_DATA& mesh,
+	float bottomRadius,
+	float topRadius)
+{
+	GLuint firstVertex = (GLuint)mesh.vertices.size();
+
+	for (int i = 0; i <= g_RoundSectors; i++)
+	{
+		float u = (float)i / g_RoundSectors;
+		float angle = u * 2.0f * g_Pi;
+		float sinAngle = std::sin(angle);
+		float cosAngle = std::cos(angle);
+		// the side leans inward by the change in radius
+		glm::vec3 normal = glm::normalize(glm::vec3(sinAngle, bottomRadius - topRadius, cosAngle));
+
+		mesh.vertices.push_back({
+			glm::vec3(sinAngle * bottomRadius, 0.0f, cosAngle * bottomRadius),
+			normal,
+			glm::vec2(u, 0.0f) });
+		mesh.vertices.push_back({
+			glm::vec3(sinAngle * topRadius, 1.0f, cosAngle * topRadius),
+			normal,
+			glm::vec2(u, 1.0f) });
+	}
+
+	for (int i = 0; i < g_RoundSectors; i++)
+	{
+		GLuint bottom0 = firstVertex + i * 2;
+		GLuint top0 = bottom0 + 1;
+		GLuint bottom1 = bottom0 + 2;
+		GLuint top1 = bottom0 + 3;
+
+		mesh.indices.push_back(bottom0);
+		mesh.indices.push_back(bottom1);
+		mesh.indices.push_back(top1);
+		mesh.indices.push_back(bottom0);
+		mesh.indices.push_back(top1);
+		mesh.indices.push_back(top0);
+	}
+}
+
+/***********************************************************
+ *  AddRoundCap()
+ *
+ *  This method is used for appending a flat round cap at the
+ *  passed in height, facing up or down. The texture is
+ *  mapped straight down onto the cap.
+ ***********************************************************/
+void MeshGeometry::AddRoundCap(
+	MESH_DATA& mesh,
+	float radius,
+	float height,
+	bool bFacingUp)
+{
+	GLuint center = (GLuint)mesh.vertices.size();
+	glm::vec3 normal = glm::vec3(0.0f, (true == bFacingUp) ? 1.0f : -1.0f, 0.0f);
+
+	mesh.vertices.push_back({ glm::vec3(0.0f, height, 0.0f), normal, glm::vec2(0.5f, 0.5f) });
+	for (int i = 0; i <= g_RoundSectors; i++)
+	{
+		float angle = (float)i / g_RoundSectors * 2.0f * g_Pi;
+		float sinAngle = std::sin(angle);
+		float cosAngle = std::cos(angle);
+
+		mesh.vertices.push_back({
+			glm::vec3(sinAngle * radius, height, cosAngle * radius),
+			normal,
+			glm::vec2(sinAngle * 0.5f + 0.5f, cosAngle * 0.5f + 0.5f) });
+	}
+
+	// the rim runs counter-clockwise when seen from above
+	for (int i = 0; i < g_RoundSectors; i++)
+	{
+		mesh.indices.push_back(center);
+		if (true == bFacingUp)
+		{
+			mesh.indices.push_back(center + 1 + i);
+			mesh.indices.push_back(center + 2 + i);
+		}
+		else
+		{
+			mesh.indices.push_back(center + 2 + i);
+			mesh.indices.push_back(center + 1 + i);
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildPlaneMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  flat plane that spans -1 to 1 on the X and Z axes.
+ ***********************************************************/
+void MeshGeometry::BuildPlaneMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	AddQuad(mesh,
+		glm::vec3(-1.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, -1.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  BuildCylinderMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  closed cylinder of radius 1, standing on the XZ plane
+ *  and reaching up to Y = 1.
+ ***********************************************************/
+void MeshGeometry::BuildCylinderMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	AddRoundSide(mesh, 1.0f, 1.0f);
+	AddRoundCap(mesh, 1.0f, 1.0f, true);
+	AddRoundCap(mesh, 1.0f, 0.0f, false);
+}
+
+/***********************************************************
+ *  BuildConeMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  cone with a base of radius 1 on the XZ plane and its
+ *  tip at Y = 1.
+ ***********************************************************/
+void MeshGeometry::BuildConeMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	AddRoundSide(mesh, 1.0f, 0.0f);
+	AddRoundCap(mesh, 1.0f, 0.0f, false);
+}
+
+/***********************************************************
+ *  BuildTaperedCylinderMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  closed cylinder that narrows from radius 1 at Y = 0 to
+ *  radius 0.5 at Y = 1.
+ ***********************************************************/
+void MeshGeometry::BuildTaperedCylinderMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	AddRoundSide(mesh, 1.0f, 0.5f);
+	AddRoundCap(mesh, 0.5f, 1.0f, true);
+	AddRoundCap(mesh, 1.0f, 0.0f, false);
+}
+
+/***********************************************************
+ *  BuildPyramid4Mesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  pyramid with a square base from -0.5 to 0.5 at Y = -0.5
+ *  and its tip at Y = 0.5.
+ ***********************************************************/
+void MeshGeometry::BuildPyramid4Mesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	glm::vec3 tip = glm::vec3(0.0f, 0.5f, 0.0f);
+	glm::vec3 frontLeft = glm::vec3(-0.5f, -0.5f, 0.5f);
+	glm::vec3 frontRight = glm::vec3(0.5f, -0.5f, 0.5f);
+	glm::vec3 backRight = glm::vec3(0.5f, -0.5f, -0.5f);
+	glm::vec3 backLeft = glm::vec3(-0.5f, -0.5f, -0.5f);
+
+	// sloped sides
+	AddTriangle(mesh, frontLeft, frontRight, tip,
+		glm::normalize(glm::vec3(0.0f, 0.5f, 1.0f)));
+	AddTriangle(mesh, frontRight, backRight, tip,
+		glm::normalize(glm::vec3(1.0f, 0.5f, 0.0f)));
+	AddTriangle(mesh, backRight, backLeft, tip,
+		glm::normalize(glm::vec3(0.0f, 0.5f, -1.0f)));
+	AddTriangle(mesh, backLeft, frontLeft, tip,
+		glm::normalize(glm::vec3(-1.0f, 0.5f, 0.0f)));
+	// base
+	AddQuad(mesh, backLeft, backRight, frontRight, frontLeft,
+		glm::vec3(0.0f, -1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  BuildSphereMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  sphere of radius 1. The texture wraps once around the
+ *  sphere and runs from the bottom pole to the top pole.
+ ***********************************************************/
+void MeshGeometry::BuildSphereMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	for (int stack = 0; stack <= g_SphereStacks; stack++)
+	{
+		float v = (float)stack / g_SphereStacks;
+		float polarAngle = v * g_Pi;
+
+		for (int sector = 0; sector <= g_RoundSectors; sector++)
+		{
+			float u = (float)sector / g_RoundSectors;
+			float angle = u * 2.0f * g_Pi;
+			glm::vec3 normal = glm::vec3(
+				std::sin(polarAngle) * std::sin(angle),
+				std::cos(polarAngle),
+				std::sin(polarAngle) * std::cos(angle));
+
+			mesh.vertices.push_back({ normal, normal, glm::vec2(u, 1.0f - v) });
+		}
+	}
+
+	for (int stack = 0; stack < g_SphereStacks; stack++)
+	{
+		for (int sector = 0; sector < g_RoundSectors; sector++)
+		{
+			GLuint upperLeft = stack * (g_RoundSectors + 1) + sector;
+			GLuint lowerLeft = upperLeft + g_RoundSectors + 1;
+
+			mesh.indices.push_back(upperLeft);
+			mesh.indices.push_back(lowerLeft);
+			mesh.indices.push_back(lowerLeft + 1);
+			mesh.indices.push_back(upperLeft);
+			mesh.indices.push_back(lowerLeft + 1);
+			mesh.indices.push_back(upperLeft + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildTorusMesh()
+ *
+ *  This method is used for building the vertex data of a
+ *  torus lying on the XY plane. The center of the tube runs
+ *  around the Z axis at radius 1.
+ ***********************************************************/
+void MeshGeometry::BuildTorusMesh(MESH_DATA& mesh)
+{
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	for (int sector = 0; sector <= g_RoundSectors; sector++)
+	{
+		float u = (float)sector / g_RoundSectors;
+		float ringAngle = u * 2.0f * g_Pi;
+		glm::vec3 ringCenter = glm::vec3(std::cos(ringAngle), std::sin(ringAngle), 0.0f);
+
+		for (int tubeSector = 0; tubeSector <= g_TorusTubeSectors; tubeSector++)
+		{
+			float v = (float)tubeSector / g_TorusTubeSectors;
+			float tubeAngle = v * 2.0f * g_Pi;
+			glm::vec3 normal = glm::vec3(
+				std::cos(tubeAngle) * ringCenter.x,
+				std::cos(tubeAngle) * ringCenter.y,
+				std::sin(tubeAngle));
+
+			mesh.vertices.push_back({
+				ringCenter + normal * g_TorusTubeRadius,
+				normal,
+				glm::vec2(u, v) });
+		}
+	}
+
+	for (int sector = 0; sector < g_RoundSectors; sector++)
+	{
+		for (int tubeSector = 0; tubeSector < g_TorusTubeSectors; tubeSector++)
+		{
+			GLuint current = sector * (g_TorusTubeSectors + 1) + tubeSector;
+			GLuint next = current + g_TorusTubeSectors + 1;
+
+			mesh.indices.push_back(current);
+			mesh.indices.push_back(next);
+			mesh.indices.push_back(next + 1);
+			mesh.indices.push_back(current);
+			mesh.indices.push_back(next + 1);
+			mesh.indices.push_back(current + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildShapeMesh()
+ *
+ *  This method is used for building the mesh of the basic
+ *  shape with the passed in shape ID. The mesh is left as it
+ *  is for an unknown shape ID.
+ ***********************************************************/
+void MeshGeometry::BuildShapeMesh(int shapeID, MESH_DATA& mesh)
+{
+	switch (shapeID)
+	{
+	case SHAPE_BOX:
+		BuildBoxMesh(mesh);
+		break;
+	case SHAPE_PLANE:
+		BuildPlaneMesh(mesh);
+		break;
+	case SHAPE_CYLINDER:
+		BuildCylinderMesh(mesh);
+		break;
+	case SHAPE_CONE:
+		BuildConeMesh(mesh);
+		break;
+	case SHAPE_PRISM:
+		BuildPrismMesh(mesh);
+		break;
+	case SHAPE_PYRAMID4:
+		BuildPyramid4Mesh(mesh);
+		break;
+	case SHAPE_SPHERE:
+		BuildSphereMesh(mesh);
+		break;
+	case SHAPE_TAPERED_CYLINDER:
+		BuildTaperedCylinderMesh(mesh);
+		break;
+	case SHAPE_TORUS:
+		BuildTorusMesh(mesh);
+		break;
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  GetShapeName()
+ *
+ *  This method is used for getting the name of a basic
+ *  shape, or an empty name for an unknown shape ID.
+ ***********************************************************/
+const char* MeshGeometry::GetShapeName(int shapeID)
+{
+	if ((shapeID < 0) || (shapeID >= SHAPE_COUNT))
+	{
+		return("");
+	}
+
+	return(g_ShapeNames[shapeID]);
+}
+
+/***********************************************************
+ *  FindShape()
+ *
+ *  This method is used for getting the shape ID of a basic
+ *  shape from its name.
+ ***********************************************************/
+int MeshGeometry::FindShape(const char* name)
+{
+	for (int shapeID = 0; shapeID < SHAPE_COUNT; shapeID++)
+	{
+		if (0 == strcmp(name, g_ShapeNames[shapeID]))
+		{
+			return(shapeID);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  ComputeBounds()
+ *
+ *  This method is used for finding the axis aligned box
+ *  around the vertex positions of the mesh. An empty mesh
+ *  gets an empty box at the origin.
+ ***********************************************************/
+void MeshGeometry::ComputeBounds(const MESH_DATA& mesh, MESH_BOUNDS& bounds)
+{
+	if (true == mesh.vertices.empty())
+	{
+		bounds.minPoint = glm::vec3(0.0f);
+		bounds.maxPoint = glm::vec3(0.0f);
+		return;
+	}
+
+	bounds.minPoint = mesh.vertices[0].position;
+	bounds.maxPoint = mesh.vertices[0].position;
+	for (const VERTEX& vertex : mesh.vertices)
+	{
+		bounds.minPoint = glm::min(bounds.minPoint, vertex.position);
+		bounds.maxPoint = glm::max(bounds.maxPoint, vertex.position);
+	}
+}
+
+/***********************************************************
+ *  TransformBounds()
+ *
+ *  This method is used for finding the axis aligned box
+ *  around a box moved by the model matrix. The center is
+ *  moved by the matrix, and the half size grows by the
+ *  absolute values of the matrix axes, which is the same as
+ *  moving all eight corners without the loop.
+ ***********************************************************/
+void MeshGeometry::TransformBounds(
+	const MESH_BOUNDS& bounds,
+	const glm::mat4& model,
+	MESH_BOUNDS& transformedBounds)
+{
+	glm::vec3 center = (bounds.minPoint + bounds.maxPoint) * 0.5f;
+	glm::vec3 halfSize = (bounds.maxPoint - bounds.minPoint) * 0.5f;
+
+	glm::vec3 newCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+	glm::vec3 newHalfSize =
+		glm::abs(glm::vec3(model[0])) * halfSize.x +
+		glm::abs(glm::vec3(model[1])) * halfSize.y +
+		glm::abs(glm::vec3(model[2])) * halfSize.z;
+
+	transformedBounds.minPoint = newCenter - newHalfSize;
+	transformedBounds.maxPoint = newCenter + newHalfSize;
+}
+
+/***********************************************************
+ *  MergeBounds()
+ *
+ *  This method is used for growing a box so that it also
+ *  holds the other passed in box.
+ ***********************************************************/
+void MeshGeometry::MergeBounds(MESH_BOUNDS& bounds, const MESH_BOUNDS& otherBounds)
+{
+	bounds.minPoint = glm::min(bounds.minPoint, otherBounds.minPoint);
+	bounds.maxPoint = glm::max(bounds.maxPoint, otherBounds.maxPoint);
+}
+
+/***********************************************************
+ *  ExtractFrustumPlanes()
+ *
+ *  This method is used for finding the left, right, bottom,
+ *  top, near and far planes of the view frustum from the
+ *  rows of the view-projection matrix. Each plane keeps its
+ *  normal in xyz, pointing into the frustum, and its
+ *  distance in w.
+ ***********************************************************/
+void MeshGeometry::ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6])
+{
+	glm::vec4 row[4];
+	for (int i = 0; i < 4; i++)
+	{
+		row[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	planes[0] = row[3] + row[0];
+	planes[1] = row[3] - row[0];
+	planes[2] = row[3] + row[1];
+	planes[3] = row[3] - row[1];
+	planes[4] = row[3] + row[2];
+	planes[5] = row[3] - row[2];
+}
+
+/***********************************************************
+ *  IsBoundsInFrustum()
+ *
+ *  This method is used for checking a box against the
+ *  frustum planes. The box is outside when the corner
+ *  furthest along a plane normal is still behind that plane.
+ *  Boxes crossing a frustum corner may be kept, which only
+ *  costs a draw.
+ ***********************************************************/
+bool MeshGeometry::IsBoundsInFrustum(const MESH_BOUNDS& bounds, const glm::vec4 planes[6])
+{
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& plane = planes[i];
+		glm::vec3 corner(
+			(plane.x >= 0.0f) ? bounds.maxPoint.x : bounds.minPoint.x,
+			(plane.y >= 0.0f) ? bounds.maxPoint.y : bounds.minPoint.y,
+			(plane.z >= 0.0f) ? bounds.maxPoint.z : bounds.minPoint.z);
+
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
\ No newline at end of file
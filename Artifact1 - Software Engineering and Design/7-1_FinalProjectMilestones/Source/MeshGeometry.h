@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshgeometry.h
+// ============
+// build CPU-side vertex and index data for the basic 3D shapes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  MeshGeometry
+ *
+ *  This class contains the code for generating the vertex
+ *  and index data of the basic 3D shapes in memory, so that
+ *  the data can be uploaded into custom vertex buffers. The
+ *  vertex layout matches the one used by the shaders:
+ *  position (location 0), normal (1), texture coordinate (2).
+ ***********************************************************/
+class MeshGeometry
+{
+public:
+	struct VERTEX
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 textureCoordinate;
+	};
+
+	struct MESH_DATA
+	{
+		std::vector<VERTEX> vertices;
+		std::vector<GLuint> indices;
+	};
+
+	// identifiers for the basic shapes, the order the mesh
+	// buffer and the cooked mesh pack hold them in
+	enum SHAPE_ID
+	{
+		SHAPE_BOX = 0,
+		SHAPE_PLANE,
+		SHAPE_CYLINDER,
+		SHAPE_CONE,
+		SHAPE_PRISM,
+		SHAPE_PYRAMID4,
+		SHAPE_SPHERE,
+		SHAPE_TAPERED_CYLINDER,
+		SHAPE_TORUS,
+		SHAPE_COUNT
+	};
+
+	// axis aligned box around a mesh
+	struct MESH_BOUNDS
+	{
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+	};
+
+	// build a unit box centered on the origin
+	static void BuildBoxMesh(MESH_DATA& mesh);
+	// build a unit triangular prism centered on the origin
+	static void BuildPrismMesh(MESH_DATA& mesh);
+	// build a flat 2x2 plane on the XZ plane
+	static void BuildPlaneMesh(MESH_DATA& mesh);
+	// build a cylinder of radius 1 from Y = 0 to Y = 1
+	static void BuildCylinderMesh(MESH_DATA& mesh);
+	// build a cone of radius 1 from Y = 0 to its tip at Y = 1
+	static void BuildConeMesh(MESH_DATA& mesh);
+	// build a four sided pyramid centered on the origin
+	static void BuildPyramid4Mesh(MESH_DATA& mesh);
+	// build a sphere of radius 1 centered on the origin
+	static void BuildSphereMesh(MESH_DATA& mesh);
+	// build a cylinder narrowing from radius 1 to 0.5 along Y
+	static void BuildTaperedCylinderMesh(MESH_DATA& mesh);
+	// build a torus of radius 1 around the Z axis
+	static void BuildTorusMesh(MESH_DATA& mesh);
+
+	// build the mesh of a basic shape by its shape ID
+	static void BuildShapeMesh(int shapeID, MESH_DATA& mesh);
+	// lower case name of a basic shape, as used in scene
+	// descriptions, and the shape ID of a name, -1 if unknown
+	static const char* GetShapeName(int shapeID);
+	static int FindShape(const char* name);
+
+	// find the box around the vertices of a mesh
+	static void ComputeBounds(const MESH_DATA& mesh, MESH_BOUNDS& bounds);
+	// find the box around a box moved by a model matrix
+	static void TransformBounds(
+		const MESH_BOUNDS& bounds,
+		const glm::mat4& model,
+		MESH_BOUNDS& transformedBounds);
+	// grow a box to also hold another box
+	static void MergeBounds(MESH_BOUNDS& bounds, const MESH_BOUNDS& otherBounds);
+	// find the six planes of the view frustum, in world space
+	// for a view-projection matrix
+	static void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+	// check whether a box is at least partly inside the frustum
+	static bool IsBoundsInFrustum(const MESH_BOUNDS& bounds, const glm::vec4 planes[6]);
+
+private:
+	// append a four sided face to the mesh data
+	static void AddQuad(
+		MESH_DATA& mesh,
+		glm::vec3 corner0,
+		glm::vec3 corner1,
+		glm::vec3 corner2,
+		glm::vec3 corner3,
+		glm::vec3 normal);
+	// append a three sided face to the mesh data
+	static void AddTriangle(
+		MESH_DATA& mesh,
+		glm::vec3 corner0,
+		glm::vec3 corner1,
+		glm::vec3 corner2,
+		glm::vec3 normal);
+	// append the round side of a cylinder, cone or tapered
+	// cylinder running from Y = 0 to Y = 1
+	static void AddRoundSide(
+		MESH_DATA& mesh,
+		float bottomRadius,
+		float topRadius);
+	// append a flat round cap at the passed in height
+	static void AddRoundCap(
+		MESH_DATA& mesh,
+		float radius,
+		float height,
+		bool bFacingUp);
+};
\ No newline at end of file
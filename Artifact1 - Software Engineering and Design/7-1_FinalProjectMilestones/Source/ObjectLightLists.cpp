@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectlightlists.cpp
+// ============
+// assign to every drawn object the point lights that reach its bounds
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ObjectLightLists.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// texture unit of the light indices, above the units of
+	// the light clusters and the per-draw values
+	const int g_ObjectLightIndexTextureUnit = 20;
+
+	const char* g_UseObjectLightListsName = "bUseObjectLightLists";
+	const char* g_ObjectLightIndicesName = "objectLightIndices";
+}
+
+/***********************************************************
+ *  ObjectLightLists()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ObjectLightLists::ObjectLightLists()
+{
+	m_pShaderUniforms = NULL;
+	m_bEnabled = true;
+	m_indexBuffer = 0;
+	m_indexTexture = 0;
+	m_bufferCapacity = 0;
+	m_firstChanged = 0;
+	m_unusedCount = 0;
+	m_stats = { 0, 0, 0 };
+}
+
+/***********************************************************
+ *  ~ObjectLightLists()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ObjectLightLists::~ObjectLightLists()
+{
+	Destroy();
+	m_pShaderUniforms = NULL;
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the texture buffer that
+ *  passes the light indices of the objects to the shaders.
+ *  It must be called after the shader uniform locations have
+ *  been resolved.
+ ***********************************************************/
+void ObjectLightLists::Create(ShaderUniforms* pShaderUniforms)
+{
+	Destroy();
+
+	m_pShaderUniforms = pShaderUniforms;
+
+	// the buffer starts out with a single unused index, so the
+	// texture buffer is never empty
+	m_indexData.assign(1, 0);
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_indexData.size() * sizeof(GLuint), m_indexData.data(), GL_DYNAMIC_DRAW);
+	m_bufferCapacity = m_indexData.size();
+	glGenTextures(1, &m_indexTexture);
+	glActiveTexture(GL_TEXTURE0 + g_ObjectLightIndexTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_indexBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0);
+	m_indexData.clear();
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_uniforms.useObjectLightLists = m_pShaderUniforms->Register<bool>(g_UseObjectLightListsName);
+		m_uniforms.objectLightIndices = m_pShaderUniforms->Register<int>(g_ObjectLightIndicesName);
+
+		m_pShaderUniforms->Set(m_uniforms.objectLightIndices, g_ObjectLightIndexTextureUnit);
+		m_pShaderUniforms->Set(m_uniforms.useObjectLightLists, m_bEnabled);
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the texture buffer.
+ ***********************************************************/
+void ObjectLightLists::Destroy()
+{
+	if (0 != m_indexTexture)
+	{
+		glDeleteTextures(1, &m_indexTexture);
+		m_indexTexture = 0;
+	}
+	if (0 != m_indexBuffer)
+	{
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = 0;
+	}
+	m_bufferCapacity = 0;
+	Clear();
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing the light lists of all
+ *  the objects before they are assigned again.
+ ***********************************************************/
+void ObjectLightLists::Clear()
+{
+	m_indexData.clear();
+	m_firstChanged = 0;
+	m_unusedCount = 0;
+	m_stats = { 0, 0, 0 };
+}
+
+/***********************************************************
+ *  AddObject()
+ *
+ *  This method is used for appending the list of the point
+ *  lights whose range reaches into the passed in world space
+ *  box. The returned offset and count locate the list in the
+ *  light indices - a count of 0 means no point light reaches
+ *  the object.
+ ***********************************************************/
+glm::ivec2 ObjectLightLists::AddObject(const MeshGeometry::MESH_BOUNDS& worldBounds, const LightBuffer& lights)
+{
+	glm::ivec2 lightRange((int)m_indexData.size(), 0);
+
+	for (int i = 0; i < lights.GetLightCount(); i++)
+	{
+		const LightBuffer::POINT_LIGHT& light = lights.GetLight(i);
+
+		// closest point of the box to the light
+		glm::vec3 closest = glm::clamp(light.position, worldBounds.minPoint, worldBounds.maxPoint);
+		glm::vec3 offset = closest - light.position;
+
+		if (glm::dot(offset, offset) <= light.range * light.range)
+		{
+			m_indexData.push_back((GLuint)i);
+			lightRange.y++;
+		}
+	}
+
+	CountObject(lightRange.y);
+
+	return(lightRange);
+}
+
+/***********************************************************
+ *  AddObjectLights()
+ *
+ *  This method is used for appending a list of point lights
+ *  the caller already found for an object, for callers that
+ *  find the objects reached by each light instead.
+ ***********************************************************/
+glm::ivec2 ObjectLightLists::AddObjectLights(const GLuint* pLightIndices, int lightCount)
+{
+	glm::ivec2 lightRange((int)m_indexData.size(), lightCount);
+
+	m_indexData.insert(m_indexData.end(), pLightIndices, pLightIndices + lightCount);
+	CountObject(lightCount);
+
+	return(lightRange);
+}
+
+/***********************************************************
+ *  UpdateObject()
+ *
+ *  This method is used for finding the point lights of an
+ *  object again after it moved, without touching the lists
+ *  of the other objects. The new list is written over the
+ *  old one when it is no longer, and appended otherwise,
+ *  which leaves the old list unused until all the lists are
+ *  assigned again. A range with a count of -1 has no list
+ *  yet, so its new list is always appended.
+ ***********************************************************/
+glm::ivec2 ObjectLightLists::UpdateObject(
+	glm::ivec2 lightRange,
+	const MeshGeometry::MESH_BOUNDS& worldBounds,
+	const LightBuffer& lights)
+{
+	glm::ivec2 newRange = AddObject(worldBounds, lights);
+
+	// the old list is no longer counted, the new one replaces it
+	if (lightRange.y < 0)
+	{
+		return(newRange);
+	}
+	m_stats.objects--;
+	m_stats.lightIndices -= lightRange.y;
+
+	// a list from before the last Clear() is not written over
+	if ((newRange.y > lightRange.y) || (lightRange.x + lightRange.y > newRange.x))
+	{
+		m_unusedCount += lightRange.y;
+		return(newRange);
+	}
+
+	std::copy(m_indexData.begin() + newRange.x, m_indexData.end(), m_indexData.begin() + lightRange.x);
+	m_indexData.resize(newRange.x);
+	m_unusedCount += lightRange.y - newRange.y;
+	m_firstChanged = std::min(m_firstChanged, (size_t)lightRange.x);
+
+	return(glm::ivec2(lightRange.x, newRange.y));
+}
+
+/***********************************************************
+ *  RemoveObject()
+ *
+ *  This method is used for dropping the list of an object
+ *  that is no longer drawn from the counters. Its light
+ *  indices stay where they are, unused, until all the lists
+ *  are assigned again.
+ ***********************************************************/
+void ObjectLightLists::RemoveObject(glm::ivec2 lightRange)
+{
+	if (lightRange.y < 0)
+	{
+		return;
+	}
+
+	m_stats.objects--;
+	m_stats.lightIndices -= lightRange.y;
+	m_unusedCount += lightRange.y;
+}
+
+/***********************************************************
+ *  CountObject()
+ *
+ *  This method is used for adding the list of an object to
+ *  the light assignment counters.
+ ***********************************************************/
+void ObjectLightLists::CountObject(int lightCount)
+{
+	m_stats.objects++;
+	m_stats.lightIndices += lightCount;
+	if (lightCount > m_stats.maxObjectLights)
+	{
+		m_stats.maxObjectLights = lightCount;
+	}
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for uploading the light indices that
+ *  changed or were appended since the last upload into the
+ *  texture buffer. When they outgrow the buffer it is made
+ *  twice as large as needed, so the lists of moved objects
+ *  can be appended for a while without it growing again.
+ ***********************************************************/
+void ObjectLightLists::Upload()
+{
+	if ((0 == m_indexBuffer) || (true == m_indexData.empty()))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+	if (m_indexData.size() > m_bufferCapacity)
+	{
+		m_bufferCapacity = m_indexData.size() * 2;
+		glBufferData(GL_TEXTURE_BUFFER, m_bufferCapacity * sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+		m_firstChanged = 0;
+	}
+	if (m_firstChanged < m_indexData.size())
+	{
+		glBufferSubData(GL_TEXTURE_BUFFER,
+			m_firstChanged * sizeof(GLuint),
+			(m_indexData.size() - m_firstChanged) * sizeof(GLuint),
+			m_indexData.data() + m_firstChanged);
+	}
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	m_firstChanged = m_indexData.size();
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for switching the shaders between the
+ *  per-object light loop and the loop over the whole list.
+ ***********************************************************/
+void ObjectLightLists::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.useObjectLightLists, m_bEnabled);
+	}
+}
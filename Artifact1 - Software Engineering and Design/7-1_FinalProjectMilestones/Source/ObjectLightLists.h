@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectlightlists.h
+// ============
+// assign to every drawn object the point lights that reach its bounds
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "LightBuffer.h"
+#include "MeshGeometry.h"
+#include "ShaderUniforms.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ObjectLightLists
+ *
+ *  This class finds, on the CPU, the point lights whose
+ *  range reaches into the world space box of each object,
+ *  and packs the light indices of all the objects into one
+ *  texture buffer. Every object gets the offset and count of
+ *  its own lights in that buffer, so the fragment shader
+ *  only loops over the few lights near the object.
+ *
+ *  The lists are built once for the static scene, which
+ *  makes this cheaper than the per-frame light clusters,
+ *  at the cost of a looser fit for large objects. The list
+ *  of an object that moves is found again on its own, and
+ *  only the changed light indices are uploaded.
+ ***********************************************************/
+class ObjectLightLists
+{
+public:
+	// counters of the last light assignment
+	struct LIGHT_LIST_STATS
+	{
+		int objects;
+		int lightIndices;
+		int maxObjectLights;
+	};
+
+	// constructor
+	ObjectLightLists();
+	// destructor
+	~ObjectLightLists();
+
+	// create the texture buffer for the light indices
+	void Create(ShaderUniforms* pShaderUniforms);
+	// free the texture buffer
+	void Destroy();
+
+	// remove the lists of all the objects
+	void Clear();
+	// find the lights reaching a world space box, and get the
+	// offset and count of its list in the light indices
+	glm::ivec2 AddObject(const MeshGeometry::MESH_BOUNDS& worldBounds, const LightBuffer& lights);
+	// append a list of lights already found for an object, and
+	// get the offset and count of the list in the light indices
+	glm::ivec2 AddObjectLights(const GLuint* pLightIndices, int lightCount);
+	// find the lights reaching the new box of a moved object,
+	// reusing the place of its old list when the new one fits
+	glm::ivec2 UpdateObject(glm::ivec2 lightRange, const MeshGeometry::MESH_BOUNDS& worldBounds, const LightBuffer& lights);
+	// leave the list of a removed object unused
+	void RemoveObject(glm::ivec2 lightRange);
+	// upload the light indices changed since the last upload
+	void Upload();
+	// light indices left behind by the lists found again
+	int GetUnusedCount() const { return(m_unusedCount); }
+
+	// turn the per-object light loop in the shaders on or off
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const { return(m_bEnabled); }
+
+	// get the counters of the last light assignment
+	const LIGHT_LIST_STATS& GetStats() const { return(m_stats); }
+
+private:
+	// handles of the uniforms set by the light lists
+	struct LIGHT_LIST_UNIFORMS
+	{
+		UniformHandle<bool> useObjectLightLists;
+		UniformHandle<int> objectLightIndices;
+	};
+
+	// pointer to the uniform location table of the shader program
+	ShaderUniforms* m_pShaderUniforms;
+	LIGHT_LIST_UNIFORMS m_uniforms;
+	// loop over the object's lights instead of the whole list
+	bool m_bEnabled;
+
+	// light indices of every object, back to back
+	std::vector<GLuint> m_indexData;
+	GLuint m_indexBuffer;
+	GLuint m_indexTexture;
+	// light indices the buffer has room for
+	size_t m_bufferCapacity;
+	// first light index changed since the last upload
+	size_t m_firstChanged;
+	// light indices no list uses any more
+	int m_unusedCount;
+
+	// counters of the last light assignment
+	LIGHT_LIST_STATS m_stats;
+
+	// count an added list in the light assignment counters
+	void CountObject(int lightCount);
+};
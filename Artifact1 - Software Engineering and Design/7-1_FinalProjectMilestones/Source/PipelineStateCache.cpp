@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// pipelinestatecache.cpp
+// ============
+// apply fixed-function pipeline states, skipping unchanged settings
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PipelineStateCache.h"
+
+// declaration of global variables
+namespace
+{
+	// depth tested and written, not blended
+	const PIPELINE_STATE g_OpaqueState =
+	{
+		true, true, GL_LESS,
+		false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+		false, GL_BACK,
+		GL_FILL
+	};
+}
+
+/***********************************************************
+ *  PipelineStateCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PipelineStateCache::PipelineStateCache()
+{
+	m_current = g_OpaqueState;
+	m_bValid = false;
+	m_stats = { 0, 0 };
+}
+
+/***********************************************************
+ *  ~PipelineStateCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+PipelineStateCache::~PipelineStateCache()
+{
+}
+
+/***********************************************************
+ *  Opaque()
+ *
+ *  This method is used for getting the state of geometry
+ *  that hides what is behind it.
+ ***********************************************************/
+const PIPELINE_STATE& PipelineStateCache::Opaque()
+{
+	return(g_OpaqueState);
+}
+
+/***********************************************************
+ *  SetCapability()
+ *
+ *  This method is used for enabling or disabling one OpenGL
+ *  capability.
+ ***********************************************************/
+void PipelineStateCache::SetCapability(GLenum capability, bool bEnabled)
+{
+	if (true == bEnabled)
+	{
+		glEnable(capability);
+	}
+	else
+	{
+		glDisable(capability);
+	}
+	m_stats.transitions++;
+}
+
+/***********************************************************
+ *  Apply()
+ *
+ *  This method is used for making the passed in state
+ *  current. Only the settings that differ from the current
+ *  state reach OpenGL, unless the current state is unknown,
+ *  in which case every setting is applied.
+ ***********************************************************/
+void PipelineStateCache::Apply(const PIPELINE_STATE& state)
+{
+	const bool bForce = (false == m_bValid);
+	const int transitions = m_stats.transitions;
+
+	if ((true == bForce) || (state.bDepthTest != m_current.bDepthTest))
+	{
+		SetCapability(GL_DEPTH_TEST, state.bDepthTest);
+	}
+	if ((true == bForce) || (state.bDepthWrite != m_current.bDepthWrite))
+	{
+		glDepthMask((true == state.bDepthWrite) ? GL_TRUE : GL_FALSE);
+		m_stats.transitions++;
+	}
+	if ((true == bForce) || (state.depthFunc != m_current.depthFunc))
+	{
+		glDepthFunc(state.depthFunc);
+		m_stats.transitions++;
+	}
+
+	if ((true == bForce) || (state.bBlend != m_current.bBlend))
+	{
+		SetCapability(GL_BLEND, state.bBlend);
+	}
+	if ((true == bForce) ||
+		(state.blendSrc != m_current.blendSrc) ||
+		(state.blendDst != m_current.blendDst))
+	{
+		glBlendFunc(state.blendSrc, state.blendDst);
+		m_stats.transitions++;
+	}
+
+	if ((true == bForce) || (state.bCullFace != m_current.bCullFace))
+	{
+		SetCapability(GL_CULL_FACE, state.bCullFace);
+	}
+	if ((true == bForce) || (state.cullFace != m_current.cullFace))
+	{
+		glCullFace(state.cullFace);
+		m_stats.transitions++;
+	}
+
+	// the core profile only accepts both faces for the mode
+	if ((true == bForce) || (state.polygonMode != m_current.polygonMode))
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, state.polygonMode);
+		m_stats.transitions++;
+	}
+
+	if (transitions == m_stats.transitions)
+	{
+		m_stats.transitionsSkipped++;
+	}
+
+	m_current = state;
+	m_bValid = true;
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for forgetting the current state, so
+ *  the next applied state is set in full. This is needed
+ *  when code outside the cache has changed the settings.
+ ***********************************************************/
+void PipelineStateCache::Invalidate()
+{
+	m_bValid = false;
+}
+
+/***********************************************************
+ *  ResetFrameCounters()
+ *
+ *  This method is used for resetting the counters at the
+ *  start of a frame.
+ ***********************************************************/
+void PipelineStateCache::ResetFrameCounters()
+{
+	m_stats.transitions = 0;
+	m_stats.transitionsSkipped = 0;
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// pipelinestatecache.h
+// ============
+// apply fixed-function pipeline states, skipping unchanged settings
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  PIPELINE_STATE
+ *
+ *  The fixed-function settings a render pass depends on.
+ *  Each pass declares the full state it needs instead of
+ *  relying on whatever an earlier pass left enabled.
+ ***********************************************************/
+struct PIPELINE_STATE
+{
+	// depth testing and depth buffer writes
+	bool bDepthTest;
+	bool bDepthWrite;
+	GLenum depthFunc;
+	// alpha blending and its source and destination factors
+	bool bBlend;
+	GLenum blendSrc;
+	GLenum blendDst;
+	// face culling and the faces that are culled
+	bool bCullFace;
+	GLenum cullFace;
+	// fill mode of both front and back faces
+	GLenum polygonMode;
+};
+
+/***********************************************************
+ *  PipelineStateCache
+ *
+ *  This class keeps a copy of the pipeline state that is
+ *  currently set in the OpenGL context. Applying a state
+ *  only issues the GL calls for the settings that differ
+ *  from the current state, so passes can declare their
+ *  state every frame without redundant driver calls.
+ ***********************************************************/
+class PipelineStateCache
+{
+public:
+	// constructor
+	PipelineStateCache();
+	// destructor
+	~PipelineStateCache();
+
+	// counters since the last reset - the GL calls issued, and
+	// the applied states that needed no GL call at all
+	struct STATE_STATS
+	{
+		int transitions;
+		int transitionsSkipped;
+	};
+
+	// depth tested and written, not blended
+	static const PIPELINE_STATE& Opaque();
+
+	// make the passed in state current in the OpenGL context
+	void Apply(const PIPELINE_STATE& state);
+	// forget the current state, e.g. after outside code changed it
+	void Invalidate();
+
+	// reset the counters at the start of a frame
+	void ResetFrameCounters();
+	// get the counters of the current frame
+	const STATE_STATS& GetFrameCounters() const { return(m_stats); }
+
+private:
+	// state currently set in the OpenGL context
+	PIPELINE_STATE m_current;
+	// false until the first state is applied in full
+	bool m_bValid;
+	// counters of the current frame
+	STATE_STATS m_stats;
+
+	// enable or disable a capability
+	void SetCapability(GLenum capability, bool bEnabled);
+};
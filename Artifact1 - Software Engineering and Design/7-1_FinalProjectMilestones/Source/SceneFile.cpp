@@ -0,0 +1,385 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// map a binary scene file into memory and read its tables in place
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// the records are read in place, so their layout must never
+// depend on the compiler
+static_assert(sizeof(SceneFile::SCENE_FILE_HEADER) == 64, "scene file header must be 64 bytes");
+static_assert(sizeof(SceneFile::SCENE_NODE) == 48, "scene node must be 48 bytes");
+static_assert(sizeof(SceneFile::SCENE_OBJECT) == 96, "scene object must be 96 bytes");
+static_assert(sizeof(SceneFile::SCENE_TAG) == 32, "scene tag must be 32 bytes");
+
+// declaration of global variables
+namespace
+{
+	// every table starts on this boundary
+	const uint64_t g_TableAlignment = 16;
+
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return((offset + g_TableAlignment - 1) & ~(g_TableAlignment - 1));
+	}
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_pData = NULL;
+	m_size = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_fileDescriptor = -1;
+	m_pHeader = NULL;
+	m_pNodes = NULL;
+	m_pObjects = NULL;
+	m_pTags = NULL;
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+	Close();
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for mapping the passed in scene file
+ *  into memory read-only. Only the header and the table
+ *  bounds are checked, so opening takes the same time for
+ *  any number of objects - the pages are read by the system
+ *  when the tables are first used.
+ ***********************************************************/
+bool SceneFile::Open(const char* filename)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE == file)
+	{
+		return(false);
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((FALSE == GetFileSizeEx(file, &fileSize)) || (0 == fileSize.QuadPart))
+	{
+		CloseHandle(file);
+		return(false);
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (NULL == mapping)
+	{
+		CloseHandle(file);
+		return(false);
+	}
+
+	void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (NULL == pView)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return(false);
+	}
+
+	m_fileHandle = file;
+	m_mappingHandle = mapping;
+	m_pData = (const unsigned char*)pView;
+	m_size = (size_t)fileSize.QuadPart;
+#else
+	int fileDescriptor = open(filename, O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return(false);
+	}
+
+	struct stat fileStat;
+	if ((0 != fstat(fileDescriptor, &fileStat)) || (0 == fileStat.st_size))
+	{
+		close(fileDescriptor);
+		return(false);
+	}
+
+	void* pView = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (MAP_FAILED == pView)
+	{
+		close(fileDescriptor);
+		return(false);
+	}
+
+	m_fileDescriptor = fileDescriptor;
+	m_pData = (const unsigned char*)pView;
+	m_size = (size_t)fileStat.st_size;
+#endif
+
+	return(FindTables());
+}
+
+/***********************************************************
+ *  Read()
+ *
+ *  This method is used for reading the passed in scene file
+ *  into memory. The file is closed again right away, so it
+ *  can be rewritten while the scene is in use. A file read
+ *  while it is being written fails the table checks.
+ ***********************************************************/
+bool SceneFile::Read(const char* filename)
+{
+	Close();
+
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	if (false == file.is_open())
+	{
+		return(false);
+	}
+
+	std::streamoff fileSize = file.tellg();
+	if (fileSize <= 0)
+	{
+		return(false);
+	}
+
+	m_buffer.resize(((size_t)fileSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+	file.seekg(0, std::ios::beg);
+	if (false == file.read((char*)m_buffer.data(), fileSize).good())
+	{
+		Close();
+		return(false);
+	}
+
+	m_pData = (const unsigned char*)m_buffer.data();
+	m_size = (size_t)fileSize;
+
+	return(FindTables());
+}
+
+/***********************************************************
+ *  FindTables()
+ *
+ *  This method is used for checking the header of the
+ *  mapped or read file and for finding its tables. The file
+ *  is closed when it is not a valid scene file.
+ ***********************************************************/
+bool SceneFile::FindTables()
+{
+	if (m_size >= sizeof(SCENE_FILE_HEADER))
+	{
+		m_pHeader = (const SCENE_FILE_HEADER*)m_pData;
+	}
+	if ((NULL == m_pHeader) || (false == Validate()))
+	{
+		Close();
+		return(false);
+	}
+
+	m_pNodes = (const SCENE_NODE*)(m_pData + m_pHeader->nodeOffset);
+	m_pObjects = (const SCENE_OBJECT*)(m_pData + m_pHeader->objectOffset);
+	m_pTags = (const SCENE_TAG*)(m_pData + m_pHeader->tagOffset);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for unmapping or freeing the scene
+ *  file. The tables must not be used after the file is
+ *  closed.
+ ***********************************************************/
+void SceneFile::Close()
+{
+#ifdef _WIN32
+	if ((NULL != m_pData) && (true == m_buffer.empty()))
+	{
+		UnmapViewOfFile(m_pData);
+	}
+	if (NULL != m_mappingHandle)
+	{
+		CloseHandle((HANDLE)m_mappingHandle);
+	}
+	if (NULL != m_fileHandle)
+	{
+		CloseHandle((HANDLE)m_fileHandle);
+	}
+#else
+	if ((NULL != m_pData) && (true == m_buffer.empty()))
+	{
+		munmap((void*)m_pData, m_size);
+	}
+	if (m_fileDescriptor >= 0)
+	{
+		close(m_fileDescriptor);
+	}
+#endif
+
+	m_pData = NULL;
+	m_size = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_fileDescriptor = -1;
+	m_pHeader = NULL;
+	m_pNodes = NULL;
+	m_pObjects = NULL;
+	m_pTags = NULL;
+	std::vector<uint64_t>().swap(m_buffer);
+}
+
+/***********************************************************
+ *  Swap()
+ *
+ *  This method is used for exchanging the file, its handles
+ *  and its tables with another scene file. A read copy keeps
+ *  its memory, so the table pointers stay valid.
+ ***********************************************************/
+void SceneFile::Swap(SceneFile& other)
+{
+	std::swap(m_pData, other.m_pData);
+	std::swap(m_size, other.m_size);
+	m_buffer.swap(other.m_buffer);
+	std::swap(m_fileHandle, other.m_fileHandle);
+	std::swap(m_mappingHandle, other.m_mappingHandle);
+	std::swap(m_fileDescriptor, other.m_fileDescriptor);
+	std::swap(m_pHeader, other.m_pHeader);
+	std::swap(m_pNodes, other.m_pNodes);
+	std::swap(m_pObjects, other.m_pObjects);
+	std::swap(m_pTags, other.m_pTags);
+}
+
+/***********************************************************
+ *  IsTableValid()
+ *
+ *  This method is used for checking that a table starts on
+ *  the table boundary and ends inside the mapped file.
+ ***********************************************************/
+bool SceneFile::IsTableValid(uint64_t offset, uint64_t count, uint64_t recordSize) const
+{
+	if ((0 != (offset % g_TableAlignment)) || (offset > m_size))
+	{
+		return(false);
+	}
+
+	// the count is at most 32 bits, so the size cannot overflow
+	return(count * recordSize <= m_size - offset);
+}
+
+/***********************************************************
+ *  Validate()
+ *
+ *  This method is used for checking the header of the mapped
+ *  file - the magic value, the version and the record sizes
+ *  - and that every table fits inside the file.
+ ***********************************************************/
+bool SceneFile::Validate() const
+{
+	if ((FILE_MAGIC != m_pHeader->magic) ||
+		(FILE_VERSION != m_pHeader->version) ||
+		(sizeof(SCENE_FILE_HEADER) != m_pHeader->headerSize) ||
+		(sizeof(SCENE_NODE) != m_pHeader->nodeSize) ||
+		(sizeof(SCENE_OBJECT) != m_pHeader->objectSize) ||
+		(sizeof(SCENE_TAG) != m_pHeader->tagSize))
+	{
+		return(false);
+	}
+
+	return((true == IsTableValid(m_pHeader->nodeOffset, m_pHeader->nodeCount, sizeof(SCENE_NODE))) &&
+		(true == IsTableValid(m_pHeader->objectOffset, m_pHeader->objectCount, sizeof(SCENE_OBJECT))) &&
+		(true == IsTableValid(m_pHeader->tagOffset, m_pHeader->tagCount, sizeof(SCENE_TAG))));
+}
+
+/***********************************************************
+ *  GetTag()
+ *
+ *  This method is used for getting the name of a tag. The
+ *  name stops at the first zero or at the end of the record.
+ ***********************************************************/
+std::string SceneFile::GetTag(int tag) const
+{
+	if ((tag < 0) || (tag >= GetTagCount()))
+	{
+		return(std::string());
+	}
+
+	const char* pName = m_pTags[tag].name;
+	size_t length = 0;
+	while ((length < sizeof(m_pTags[tag].name)) && (0 != pName[length]))
+	{
+		length++;
+	}
+
+	return(std::string(pName, length));
+}
+
+/***********************************************************
+ *  Write()
+ *
+ *  This method is used for writing the passed in tables into
+ *  a new scene file, each table on the table boundary
+ *  after the header.
+ ***********************************************************/
+bool SceneFile::Write(
+	const char* filename,
+	const std::vector<SCENE_NODE>& nodes,
+	const std::vector<SCENE_OBJECT>& objects,
+	const std::vector<SCENE_TAG>& tags)
+{
+	SCENE_FILE_HEADER header = {};
+	header.magic = FILE_MAGIC;
+	header.version = FILE_VERSION;
+	header.headerSize = sizeof(SCENE_FILE_HEADER);
+	header.nodeSize = sizeof(SCENE_NODE);
+	header.objectSize = sizeof(SCENE_OBJECT);
+	header.tagSize = sizeof(SCENE_TAG);
+	header.nodeCount = (uint32_t)nodes.size();
+	header.objectCount = (uint32_t)objects.size();
+	header.tagCount = (uint32_t)tags.size();
+	header.nodeOffset = AlignOffset(sizeof(SCENE_FILE_HEADER));
+	header.objectOffset = AlignOffset(header.nodeOffset + nodes.size() * sizeof(SCENE_NODE));
+	header.tagOffset = AlignOffset(header.objectOffset + objects.size() * sizeof(SCENE_OBJECT));
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (false == file.is_open())
+	{
+		return(false);
+	}
+
+	// the record sizes are multiples of the table boundary,
+	// so every table starts right after the one before it
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)nodes.data(), nodes.size() * sizeof(SCENE_NODE));
+	file.write((const char*)objects.data(), objects.size() * sizeof(SCENE_OBJECT));
+	file.write((const char*)tags.data(), tags.size() * sizeof(SCENE_TAG));
+
+	return(true == file.good());
+}
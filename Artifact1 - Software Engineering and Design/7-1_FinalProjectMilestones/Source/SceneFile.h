@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// map a binary scene file into memory and read its tables in place
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class maps a binary scene file into memory. The file
+ *  is a header followed by three tables of fixed size
+ *  records - transform nodes, objects and tag names - each
+ *  starting on a 16 byte boundary. Opening the file only
+ *  checks the header and the table bounds, the records are
+ *  then read straight out of the mapped file without being
+ *  parsed or copied.
+ *
+ *  A file that is rewritten while the scene is shown - one
+ *  that is reloaded on change - is read into memory instead,
+ *  since a mapped file can not be safely replaced under the
+ *  mapping. The tables are then read in place from the
+ *  copy the same way.
+ *
+ *  The records are written in the byte order of the machine,
+ *  which is little-endian on every supported target. The
+ *  version must be raised whenever a record layout changes.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// "SCNB" read as a little-endian 32-bit value
+	static const uint32_t FILE_MAGIC = 0x424E4353;
+	static const uint32_t FILE_VERSION = 1;
+	// bit of SCENE_OBJECT::flags for objects that may move
+	static const uint32_t OBJECT_DYNAMIC = 0x1;
+
+	// start of the file, 64 bytes
+	struct SCENE_FILE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t headerSize;
+		// record sizes, checked against the structures below
+		uint32_t nodeSize;
+		uint32_t objectSize;
+		uint32_t tagSize;
+		uint32_t nodeCount;
+		uint32_t objectCount;
+		uint32_t tagCount;
+		uint32_t reserved;
+		// byte offsets of the tables from the start of the file
+		uint64_t nodeOffset;
+		uint64_t objectOffset;
+		uint64_t tagOffset;
+	};
+
+	// transform node, 48 bytes - a parent always comes before
+	// its children, -1 for a root node
+	struct SCENE_NODE
+	{
+		float scaleXYZ[3];
+		float rotationDegrees[3];
+		float positionXYZ[3];
+		int32_t parent;
+		uint32_t reserved[2];
+	};
+
+	// drawn object, 96 bytes
+	struct SCENE_OBJECT
+	{
+		// columns of the model matrix relative to the node,
+		// without the last row
+		float localModel[4][3];
+		float color[4];
+		float UVscale[2];
+		// transform node, or -1 for a model in world space
+		int32_t node;
+		uint32_t meshID;
+		// index into the tag table, or -1 for none
+		int32_t materialTag;
+		int32_t textureTag;
+		uint32_t flags;
+		uint32_t reserved;
+	};
+
+	// texture or material tag, 32 bytes, zero padded
+	struct SCENE_TAG
+	{
+		char name[32];
+	};
+
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// map a scene file and check its header and tables
+	bool Open(const char* filename);
+	// read a scene file into memory instead of mapping it, so
+	// the file can be written again while it is in use
+	bool Read(const char* filename);
+	// unmap or free the scene file
+	void Close();
+	// exchange the file with another scene file
+	void Swap(SceneFile& other);
+	bool IsOpen() const { return(NULL != m_pData); }
+
+	// the tables, read in place from the mapped file
+	int GetNodeCount() const { return((NULL != m_pHeader) ? (int)m_pHeader->nodeCount : 0); }
+	const SCENE_NODE* GetNodes() const { return(m_pNodes); }
+	int GetObjectCount() const { return((NULL != m_pHeader) ? (int)m_pHeader->objectCount : 0); }
+	const SCENE_OBJECT* GetObjects() const { return(m_pObjects); }
+	int GetTagCount() const { return((NULL != m_pHeader) ? (int)m_pHeader->tagCount : 0); }
+	std::string GetTag(int tag) const;
+
+	// write the tables into a new scene file
+	static bool Write(
+		const char* filename,
+		const std::vector<SCENE_NODE>& nodes,
+		const std::vector<SCENE_OBJECT>& objects,
+		const std::vector<SCENE_TAG>& tags);
+
+private:
+	// the mapped file, or the read copy of it
+	const unsigned char* m_pData;
+	size_t m_size;
+	// copy of a read file, in 64-bit words so the tables are
+	// aligned the same as in a mapping
+	std::vector<uint64_t> m_buffer;
+	// handles of the file and its mapping, by platform
+	void* m_fileHandle;
+	void* m_mappingHandle;
+	int m_fileDescriptor;
+
+	// the header and tables inside the mapped file
+	const SCENE_FILE_HEADER* m_pHeader;
+	const SCENE_NODE* m_pNodes;
+	const SCENE_OBJECT* m_pObjects;
+	const SCENE_TAG* m_pTags;
+
+	// find the tables of the mapped or read file
+	bool FindTables();
+	// check that the header and the tables fit the file
+	bool Validate() const;
+	// check that a table lies inside the file and is aligned
+	bool IsTableValid(uint64_t offset, uint64_t count, uint64_t recordSize) const;
+};
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.cpp
+// ============
+// transform hierarchy with cached world matrices and dirty flags
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneGraph.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// nodes per chunk of the update on the worker threads, a
+	// longer subtree run is cut into the subtrees below it
+	const int g_NodeChunkSize = 1024;
+}
+
+/***********************************************************
+ *  SceneGraph()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneGraph::SceneGraph()
+{
+	m_bOrderDirty = false;
+}
+
+/***********************************************************
+ *  ~SceneGraph()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneGraph::~SceneGraph()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the nodes.
+ ***********************************************************/
+void SceneGraph::Clear()
+{
+	m_nodes.clear();
+	m_order.clear();
+	m_positions.clear();
+	m_subtreeEnds.clear();
+	m_bOrderDirty = false;
+	m_dirtyNodes.clear();
+	m_updatedRanges.clear();
+}
+
+/***********************************************************
+ *  ComposeMatrix()
+ *
+ *  This method is used for building the matrix of a local
+ *  transformation, in the same order as the scene objects
+ *  are transformed - scale, then the X, Y and Z rotations,
+ *  then the position.
+ ***********************************************************/
+glm::mat4 SceneGraph::ComposeMatrix(const TRANSFORM& local)
+{
+	return(TransformBatch::ComposeMatrix(local.scaleXYZ, local.rotationDegrees, local.positionXYZ));
+}
+
+/***********************************************************
+ *  AddNode()
+ *
+ *  This method is used for appending a node below the passed
+ *  in parent. The parent must already be in the hierarchy,
+ *  which keeps every parent in front of its children. The
+ *  new node is dirty until the next update, which also puts
+ *  it into the depth-first order.
+ ***********************************************************/
+int SceneGraph::AddNode(int parent, const TRANSFORM& local)
+{
+	if (parent >= (int)m_nodes.size())
+	{
+		parent = -1;
+	}
+
+	NODE node;
+	node.local = local;
+	node.localMatrix = glm::mat4(1.0f);
+	node.world = glm::mat4(1.0f);
+	node.parent = parent;
+	node.bDirty = true;
+	node.bUpdated = false;
+	m_nodes.push_back(node);
+
+	m_dirtyNodes.push_back((int)m_nodes.size() - 1);
+	m_bOrderDirty = true;
+
+	return((int)m_nodes.size() - 1);
+}
+
+/***********************************************************
+ *  SetLocalTransform()
+ *
+ *  This method is used for changing the local transformation
+ *  of a node. The world matrices of the node and of its
+ *  subtree are recomputed by the next update.
+ ***********************************************************/
+void SceneGraph::SetLocalTransform(int node, const TRANSFORM& local)
+{
+	if ((node < 0) || (node >= (int)m_nodes.size()))
+	{
+		return;
+	}
+
+	m_nodes[node].local = local;
+	if (false == m_nodes[node].bDirty)
+	{
+		m_nodes[node].bDirty = true;
+		m_dirtyNodes.push_back(node);
+	}
+}
+
+/***********************************************************
+ *  BuildOrder()
+ *
+ *  This method is used for listing the nodes in depth-first
+ *  order. The size of every subtree is summed from the back
+ *  of the node array, since every child is behind its
+ *  parent, and then every node takes the next free position
+ *  below its parent and leaves room behind it for its
+ *  subtree. The children of a node keep the order they were
+ *  added in.
+ ***********************************************************/
+void SceneGraph::BuildOrder()
+{
+	int nodeCount = (int)m_nodes.size();
+	std::vector<int> subtreeSizes(nodeCount, 1);
+	std::vector<int> nextPositions(nodeCount, 0);
+	int nextRootPosition = 0;
+
+	for (int i = nodeCount - 1; i >= 0; i--)
+	{
+		if (m_nodes[i].parent >= 0)
+		{
+			subtreeSizes[m_nodes[i].parent] += subtreeSizes[i];
+		}
+	}
+
+	m_order.resize(nodeCount);
+	m_positions.resize(nodeCount);
+	m_subtreeEnds.resize(nodeCount);
+	for (int i = 0; i < nodeCount; i++)
+	{
+		int parent = m_nodes[i].parent;
+		int& nextPosition = (parent >= 0) ? nextPositions[parent] : nextRootPosition;
+		int position = nextPosition;
+		nextPosition += subtreeSizes[i];
+
+		m_order[position] = i;
+		m_positions[i] = position;
+		m_subtreeEnds[position] = position + subtreeSizes[i];
+		nextPositions[i] = position + 1;
+	}
+
+	m_bOrderDirty = false;
+}
+
+/***********************************************************
+ *  UpdateNodeAt()
+ *
+ *  This method is used for recomputing the world matrix of
+ *  the node at a depth-first position from its parent, whose
+ *  world matrix must already be current.
+ ***********************************************************/
+void SceneGraph::UpdateNodeAt(int position)
+{
+	NODE& node = m_nodes[m_order[position]];
+
+	if (node.parent >= 0)
+	{
+		node.world = m_nodes[node.parent].world * node.localMatrix;
+	}
+	else
+	{
+		node.world = node.localMatrix;
+	}
+	node.bDirty = false;
+	node.bUpdated = true;
+}
+
+/***********************************************************
+ *  UpdateWorldMatrices()
+ *
+ *  This method is used for recomputing the world matrices of
+ *  the dirty nodes and of everything below them. Each dirty
+ *  node stands for the run of depth-first positions of its
+ *  subtree, a run inside another one is dropped, and only
+ *  the remaining runs are walked - from the front, so every
+ *  parent is recomputed before its children. The runs do
+ *  not depend on each other, so they are handed to the
+ *  worker threads a chunk at a time. A run longer than a
+ *  chunk has its top node recomputed here and is cut into
+ *  the subtrees of its children, until every piece fits.
+ ***********************************************************/
+int SceneGraph::UpdateWorldMatrices(WorkerPool& workerPool)
+{
+	int nUpdated = 0;
+
+	// the nodes of the last update are only marked again when
+	// this update recomputes them too
+	for (const glm::ivec2& range : m_updatedRanges)
+	{
+		for (int position = range.x; position < range.y; position++)
+		{
+			m_nodes[m_order[position]].bUpdated = false;
+		}
+	}
+	m_updatedRanges.clear();
+
+	if (true == m_bOrderDirty)
+	{
+		BuildOrder();
+	}
+	if (true == m_dirtyNodes.empty())
+	{
+		return(0);
+	}
+
+	// compose the local matrices of all the dirty nodes in
+	// batches before walking the hierarchy
+	m_dirtyTransforms.Clear();
+	for (int dirtyNode : m_dirtyNodes)
+	{
+		const NODE& node = m_nodes[dirtyNode];
+		m_dirtyTransforms.Add(node.local.scaleXYZ, node.local.rotationDegrees, node.local.positionXYZ);
+	}
+	m_dirtyMatrices.resize(m_dirtyNodes.size());
+	workerPool.ParallelFor((int)m_dirtyNodes.size(), g_NodeChunkSize,
+		[this](int begin, int end)
+		{
+			m_dirtyTransforms.ComputeMatrices(m_dirtyMatrices.data(), begin, end);
+			for (int i = begin; i < end; i++)
+			{
+				m_nodes[m_dirtyNodes[i]].localMatrix = m_dirtyMatrices[i];
+			}
+		});
+
+	// subtrees are either nested or apart, so once the runs are
+	// sorted a run starting inside the one before is covered
+	for (int dirtyNode : m_dirtyNodes)
+	{
+		int position = m_positions[dirtyNode];
+		m_updatedRanges.push_back(glm::ivec2(position, m_subtreeEnds[position]));
+	}
+	m_dirtyNodes.clear();
+	std::sort(m_updatedRanges.begin(), m_updatedRanges.end(),
+		[](const glm::ivec2& a, const glm::ivec2& b)
+		{
+			return(a.x < b.x);
+		});
+	size_t keptCount = 0;
+	for (size_t i = 0; i < m_updatedRanges.size(); i++)
+	{
+		if ((keptCount > 0) && (m_updatedRanges[i].x < m_updatedRanges[keptCount - 1].y))
+		{
+			continue;
+		}
+		m_updatedRanges[keptCount++] = m_updatedRanges[i];
+		nUpdated += m_updatedRanges[i].y - m_updatedRanges[i].x;
+	}
+	m_updatedRanges.resize(keptCount);
+
+	// cut the long runs down to the subtrees below their top
+	// nodes, which are recomputed first
+	std::vector<glm::ivec2> pendingRanges(m_updatedRanges.begin(), m_updatedRanges.end());
+	m_chunkRanges.clear();
+	while (false == pendingRanges.empty())
+	{
+		glm::ivec2 range = pendingRanges.back();
+		pendingRanges.pop_back();
+		if (range.y - range.x <= g_NodeChunkSize)
+		{
+			m_chunkRanges.push_back(range);
+			continue;
+		}
+
+		UpdateNodeAt(range.x);
+		for (int child = range.x + 1; child < range.y; child = m_subtreeEnds[child])
+		{
+			pendingRanges.push_back(glm::ivec2(child, m_subtreeEnds[child]));
+		}
+	}
+
+	// gather the short runs into chunks of about the same
+	// number of nodes
+	m_chunkFirstRanges.clear();
+	int chunkNodes = g_NodeChunkSize;
+	for (int i = 0; i < (int)m_chunkRanges.size(); i++)
+	{
+		if (chunkNodes >= g_NodeChunkSize)
+		{
+			m_chunkFirstRanges.push_back(i);
+			chunkNodes = 0;
+		}
+		chunkNodes += m_chunkRanges[i].y - m_chunkRanges[i].x;
+	}
+	m_chunkFirstRanges.push_back((int)m_chunkRanges.size());
+
+	workerPool.ParallelFor((int)m_chunkFirstRanges.size() - 1, 1,
+		[this](int begin, int end)
+		{
+			for (int chunk = begin; chunk < end; chunk++)
+			{
+				for (int i = m_chunkFirstRanges[chunk]; i < m_chunkFirstRanges[chunk + 1]; i++)
+				{
+					for (int position = m_chunkRanges[i].x; position < m_chunkRanges[i].y; position++)
+					{
+						UpdateNodeAt(position);
+					}
+				}
+			}
+		});
+
+	return(nUpdated);
+}
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.h
+// ============
+// transform hierarchy with cached world matrices and dirty flags
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TransformBatch.h"
+#include "WorkerPool.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  SceneGraph
+ *
+ *  This class keeps a hierarchy of transform nodes. Each
+ *  node stores its local scale, rotation and position and
+ *  the index of its parent, and the world matrix of every
+ *  node is cached.
+ *
+ *  Nodes are kept in one array where a parent always comes
+ *  before its children, and are also listed in depth-first
+ *  order, where the subtree of a node is the run of
+ *  positions from the node up to its subtree end. Changing
+ *  a node only adds it to the dirty list, and the update
+ *  pass turns the dirty nodes into the runs of their
+ *  subtrees and only walks those runs, so moving one node
+ *  costs its subtree and nothing else. The local matrices of
+ *  the dirty nodes are composed together in one batch, the
+ *  nodes below them reuse their cached local matrix. The
+ *  runs are independent, so they are split across the
+ *  worker threads, and a run too long for one thread is cut
+ *  into the subtrees of its children.
+ ***********************************************************/
+class SceneGraph
+{
+public:
+	// constructor
+	SceneGraph();
+	// destructor
+	~SceneGraph();
+
+	// local transformation of a node relative to its parent,
+	// applied as scale, then X, Y and Z rotation, then position
+	struct TRANSFORM
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+	};
+
+	// remove all the nodes
+	void Clear();
+	// add a node below an existing parent, -1 for a root node,
+	// and get its index
+	int AddNode(int parent, const TRANSFORM& local);
+
+	// change the local transformation of a node
+	void SetLocalTransform(int node, const TRANSFORM& local);
+	const TRANSFORM& GetLocalTransform(int node) const { return(m_nodes[node].local); }
+
+	// recompute the world matrices of the changed subtrees on
+	// the worker pool, and get the number of recomputed nodes
+	int UpdateWorldMatrices(WorkerPool& workerPool);
+	// true when the last update recomputed the node
+	bool WasUpdated(int node) const { return(m_nodes[node].bUpdated); }
+	// runs of depth-first positions the last update recomputed,
+	// each the first position and one past the last
+	const std::vector<glm::ivec2>& GetUpdatedRanges() const { return(m_updatedRanges); }
+	// get the node at a depth-first position
+	int GetOrderedNode(int position) const { return(m_order[position]); }
+	// get the cached world matrix of a node
+	const glm::mat4& GetWorldMatrix(int node) const { return(m_nodes[node].world); }
+
+	// get the parent of a node, -1 for a root node
+	int GetParent(int node) const { return(m_nodes[node].parent); }
+	// number of nodes in the hierarchy
+	int GetNodeCount() const { return((int)m_nodes.size()); }
+
+	// build the matrix of a local transformation
+	static glm::mat4 ComposeMatrix(const TRANSFORM& local);
+
+private:
+	struct NODE
+	{
+		TRANSFORM local;
+		glm::mat4 localMatrix;
+		glm::mat4 world;
+		int parent;
+		// the local transformation changed since the last update
+		bool bDirty;
+		// the world matrix changed in the last update
+		bool bUpdated;
+	};
+
+	// nodes with every parent in front of its children
+	std::vector<NODE> m_nodes;
+	// the nodes in depth-first order, the position of every
+	// node in it, and one past the last position of the
+	// subtree at every position
+	std::vector<int> m_order;
+	std::vector<int> m_positions;
+	std::vector<int> m_subtreeEnds;
+	// true when nodes were added since the order was built
+	bool m_bOrderDirty;
+
+	// nodes changed since the last update, each listed once
+	std::vector<int> m_dirtyNodes;
+	// local values of the dirty nodes of the current update
+	TransformBatch m_dirtyTransforms;
+	std::vector<glm::mat4> m_dirtyMatrices;
+	// subtree runs of the last update, and the runs cut down
+	// to fit the worker chunks
+	std::vector<glm::ivec2> m_updatedRanges;
+	std::vector<glm::ivec2> m_chunkRanges;
+	// first run of every worker chunk, and the end of the last
+	std::vector<int> m_chunkFirstRanges;
+
+	// build the depth-first order of the nodes again
+	void BuildOrder();
+	// recompute the world matrix of the node at a position
+	void UpdateNodeAt(int position);
+};
@@ -1,1580 +1,4238 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.cpp
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#include <glm/gtx/transform.hpp>
-
-// declaration of global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ,
-	glm::vec3 offset)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ + offset);
-
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
-}
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
-/***********************************************************
-  *  LoadSceneTextures()
-  *
-  *  This method is used for preparing the 3D scene by loading
-  *  the shapes, textures in memory to support the 3D scene
-  *  rendering
-  ***********************************************************/
-void SceneManager::LoadSceneTextures()
-{
-	/*** STUDENTS - add the code BELOW for loading the textures that ***/
-	/*** will be used for mapping to objects in the 3D scene. Up to  ***/
-	/*** 16 textures can be loaded per scene. Refer to the code in   ***/
-	/*** the OpenGL Sample for help.                                 ***/
-	bool bReturn = false;
-
-	bReturn = CreateGLTexture(
-		"textures/Grass.jpg",
-		"Grass");
-
-	bReturn = CreateGLTexture(
-		"textures/Brick.jpg",
-		"Brick");
-
-	bReturn = CreateGLTexture(
-		"textures/Roof.jpg",
-		"Roof");
-
-	bReturn = CreateGLTexture(
-		"textures/Wood.jpg",
-		"Wood");
-
-	// after the texture image data is loaded into memory, the
-	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
-	BindGLTextures();
-}
-
-void SceneManager::DefineObjectMaterials()
-{
-	OBJECT_MATERIAL metal;
-	metal.diffuseColor = glm::vec3(0.4f, 0.4f, 0.4f);
-	metal.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
-	metal.shininess = 52.0;
-	metal.tag = "metal";
-
-	m_objectMaterials.push_back(metal);
-
-	OBJECT_MATERIAL wood;
-	wood.diffuseColor = glm::vec3(0.78f, 0.49f, 0.2f);
-	wood.specularColor = glm::vec3(0.96f, 0.72f, 0.49f);
-	wood.shininess = 4.0;
-	wood.tag = "wood";
-
-	m_objectMaterials.push_back(wood);
-
-	OBJECT_MATERIAL glass;
-	glass.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
-	glass.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
-	glass.shininess = 0.25;
-	glass.tag = "glass";
-
-	m_objectMaterials.push_back(glass);
-
-	OBJECT_MATERIAL stone;
-	stone.diffuseColor = glm::vec3(0.7f, 0.7f, 0.7f);
-	stone.specularColor = glm::vec3(0.75f, 0.75f, 0.75f);
-	stone.shininess = 2.0;
-	stone.tag = "stone";
-
-	m_objectMaterials.push_back(stone);
-
-	OBJECT_MATERIAL roof;
-	roof.diffuseColor = glm::vec3(0.7f, 0.35f, 0.0f);
-	roof.specularColor = glm::vec3(0.9f, 0.53f, 0.17f);
-	roof.shininess = 30.0;
-	roof.tag = "roof";
-
-	m_objectMaterials.push_back(roof);
-
-	OBJECT_MATERIAL cement;
-	cement.diffuseColor = glm::vec3(0.6f, 0.6f, 0.6f);
-	cement.specularColor = glm::vec3(0.75f, 0.75f, 0.75f);
-	cement.shininess = 1.0;
-	cement.tag = "cement";
-
-	m_objectMaterials.push_back(cement);
-
-	OBJECT_MATERIAL grass;
-	grass.diffuseColor = glm::vec3(0.7f, 0.8f, 0.2f);
-	grass.specularColor = glm::vec3(0.88f, 1.0f, 0.24f);
-	grass.shininess = 5.0;
-	grass.tag = "grass";
-
-	m_objectMaterials.push_back(grass);
-
-}
-
-
-
-/***********************************************************
- *  SetupSceneLights()
- *
- *  This method is called to add and configure the light
- *  sources for the 3D scene.  There are up to 4 light sources.
- ***********************************************************/
-void SceneManager::SetupSceneLights()
-{
-	// this line of code is NEEDED for telling the shaders to render 
-	// the 3D scene with custom lighting - to use the default rendered 
-	// lighting then comment out the following line
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	// directional light to simulate sunlight
-	m_pShaderManager->setVec3Value("directionalLight.direction", 20.0f, -1.0f, -15.0f);
-	m_pShaderManager->setVec3Value("directionalLight.ambient", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", 0.8f, 0.8f, 0.9f);
-	m_pShaderManager->setVec3Value("directionalLight.specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
-
-	//point light
-	m_pShaderManager->setVec3Value("pointLights[0].position", 12.0f, 1.0f, -4.0f);
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 0.33f, 0.14f, 0.02f);
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-
-	//point light
-	m_pShaderManager->setVec3Value("pointLights[1].position", 11.0f, 1.0f, -8.0f);
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", 0.33f, 0.14f, 0.02f);
-	m_pShaderManager->setVec3Value("pointLights[1].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
-
-	//point light
-	m_pShaderManager->setVec3Value("pointLights[2].position", -4.0f, 1.0f, -10.0f);
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", 0.33f, 0.14f, 0.02f);
-	m_pShaderManager->setVec3Value("pointLights[2].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);
-
-	//point light
-	m_pShaderManager->setVec3Value("pointLights[3].position", 8.5f, 1.0f, -10.0f);
-	m_pShaderManager->setVec3Value("pointLights[3].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[3].diffuse", 0.33f, 0.14f, 0.02f);
-	m_pShaderManager->setVec3Value("pointLights[3].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setBoolValue("pointLights[3].bActive", true);
-
-}
-
-/***********************************************************
- *  PrepareScene()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- ***********************************************************/
-void SceneManager::PrepareScene()
-{
-
-	// load the textures for the 3D scene
-	LoadSceneTextures();
-	// define the materials that will be used for the objects
-	// in the 3D scene
-	DefineObjectMaterials();
-	// add and defile the light sources for the 3D scene
-	SetupSceneLights();
-
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadConeMesh();
-	m_basicMeshes->LoadPrismMesh();
-	m_basicMeshes->LoadPyramid4Mesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadTaperedCylinderMesh();
-	m_basicMeshes->LoadTorusMesh();
-}
-
-/***********************************************************
- *  RenderScene()
- *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
- ***********************************************************/
-void SceneManager::RenderScene()
-{
-	RenderGround(0.0f);
-	RenderHouse(0.0f, 0.0f, 0.0, -6.6f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, -4.4f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, -2.2f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, 0.0f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, 2.2f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, 4.4f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, 6.6f, 0.0f, -7.2f);
-	RenderHouse(0.0f, 0.0f, 0.0, -6.6f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, -4.4f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, -2.2f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, 0.0f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, 2.2f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, 4.4f, 0.0f, -3.1f);
-	RenderHouse(0.0f, 0.0f, 0.0, 6.6f, 0.0f, -3.1f);
-	RenderHouse2(0.0f, 0.0f, 0.0, 9.0f, 0.0f, -2.8f);
-	RenderHouse2(0.0f, 0.0f, 0.0, 9.0f, 0.0f, -5.0f);
-	RenderHouse2(0.0f, 0.0f, 0.0, 9.0f, 0.0f, -7.2f);
-	RenderHouse3(0.0f, 0.0f, 0.0, -9.0f, 0.0f, -2.8f);
-	RenderHouse3(0.0f, 0.0f, 0.0, -9.0f, 0.0f, -5.0f);
-	RenderHouse3(0.0f, 0.0f, 0.0, -9.0f, 0.0f, -7.2f);
-	RenderWall();
-	RenderWindmill();
-}
-
-/***********************************************************
- *  RenderGround()
- *
- *  This method is called to render the shapes for the Ground oject.
- ***********************************************************/
-void SceneManager::RenderGround(float Xrotation)
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(50.0f, 1.0f, 30.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = Xrotation;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	//SetShaderColor(0.18, 0.34, 0.22, 1.0);
-	SetShaderTexture("Grass");
-	SetTextureUVScale(16.0, 16.0);
-	SetShaderMaterial("grass");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-	/****************************************************************/
-}
-
-/***********************************************************
- *  RenderHouse1()
- *
- *  This method is called to render the shapes for the House object.
- * 
- *  This is the house that is facing toward the camera.
- ***********************************************************/
-void SceneManager::RenderHouse(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-
-	/*** Render Building											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 90.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	SetShaderColor(0.91, 0.85, 0.71, 1.0);
-	SetShaderTexture("Brick");
-	SetTextureUVScale(4.0, 4.0);
-	SetShaderMaterial("stone");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Roof												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -90.0f + Xrot;
-	YrotationDegrees = 90.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
-	SetShaderTexture("Roof");
-	SetTextureUVScale(1.25, 2.25);
-	SetShaderMaterial("roof");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPrismMesh();
-	/****************************************************************/
-
-	/*** Render Door												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 0.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f + Xpos, 0.25f + Ypos, 0.39f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	// set the color for the next draw command
-	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-	SetShaderTexture("Wood");
-	SetTextureUVScale(1.5, 2.0);
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Window												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 0.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-0.5f + Xpos, 0.625f + Ypos, 0.39f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.41, 0.83, 0.85, 1.0);
-	SetShaderMaterial("glass");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-		// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Window2												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 0.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.5f + Xpos, 0.625f + Ypos, 0.39f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.41, 0.83, 0.85, 1.0);
-	SetShaderMaterial("glass");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-	}
-
-/***********************************************************
- *  RenderHouse2()
- *
- *  This method is called to render the shapes for the House object.
- * 
- *   This is the house that is facing to the left of the camera.
- ***********************************************************/
-void SceneManager::RenderHouse2(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-
-	/*** Render Building											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 0.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	SetShaderColor(0.91, 0.85, 0.71, 1.0);
-	SetShaderTexture("Brick");
-	SetTextureUVScale(4.0, 4.0);
-	SetShaderMaterial("stone");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Roof												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -90.0f + Xrot;
-	YrotationDegrees = 0.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
-	SetShaderTexture("Roof");
-	SetTextureUVScale(1.25, 2.25);
-	SetShaderMaterial("roof");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPrismMesh();
-	/****************************************************************/
-
-	/*** Render Door												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 90.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-0.39f + Xpos, 0.25f + Ypos, 0.0f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	// set the color for the next draw command
-	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-	SetShaderTexture("Wood");
-	SetTextureUVScale(1.5, 2.0);
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Window												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 90.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-0.39f + Xpos, 0.625f + Ypos, 0.5f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.41, 0.83, 0.85, 1.0);
-	SetShaderMaterial("glass");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-		// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Window2												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f + Xrot;
-	YrotationDegrees = 90.0f + Yrot;
-	ZrotationDegrees = 0.0f + Zrot;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-0.39f + Xpos, 0.625f + Ypos, -0.5f + Zpos);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.41, 0.83, 0.85, 1.0);
-	SetShaderMaterial("glass");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-	}
-
-
-	/***********************************************************
- *  RenderHouse3()
- *
- *  This method is called to render the shapes for the House object.
- *
- *   This is the house that is facing to the right of the camera.
- ***********************************************************/
-	void SceneManager::RenderHouse3(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
-	{
-		// declare the variables for the transformations
-		glm::vec3 scaleXYZ;
-		float XrotationDegrees = 0.0f;
-		float YrotationDegrees = 0.0f;
-		float ZrotationDegrees = 0.0f;
-		glm::vec3 positionXYZ;
-
-
-		/*** Render Building											***/
-		/*** Set needed transformations before drawing the basic mesh.  ***/
-		/*** This same ordering of code should be used for transforming ***/
-		/*** and drawing all the basic 3D shapes.						***/
-		/******************************************************************/
-		// set the XYZ scale for the mesh
-		scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
-
-		// set the XYZ rotation for the mesh
-		XrotationDegrees = 0.0f + Xrot;
-		YrotationDegrees = 0.0f + Yrot;
-		ZrotationDegrees = 0.0f + Zrot;
-
-		// set the XYZ position for the mesh
-		positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
-
-		// set the transformations into memory to be used on the drawn meshes
-		SetTransformations(
-			scaleXYZ,
-			XrotationDegrees,
-			YrotationDegrees,
-			ZrotationDegrees,
-			positionXYZ);
-
-		// set the color for the next draw command
-		SetShaderColor(0.91, 0.85, 0.71, 1.0);
-		SetShaderTexture("Brick");
-		SetTextureUVScale(4.0, 4.0);
-		SetShaderMaterial("stone");
-		// draw the mesh with transformation values
-		m_basicMeshes->DrawBoxMesh();
-		/****************************************************************/
-
-		/*** Render Roof												***/
-		/*** Set needed transformations before drawing the basic mesh.  ***/
-		/*** This same ordering of code should be used for transforming ***/
-		/*** and drawing all the basic 3D shapes.						***/
-		/******************************************************************/
-		// set the XYZ scale for the mesh
-		scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
-
-		// set the XYZ rotation for the mesh
-		XrotationDegrees = -90.0f + Xrot;
-		YrotationDegrees = 0.0f + Yrot;
-		ZrotationDegrees = 0.0f + Zrot;
-
-		// set the XYZ position for the mesh
-		positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
-
-		// set the transformations into memory to be used on the drawn meshes
-		SetTransformations(
-			scaleXYZ,
-			XrotationDegrees,
-			YrotationDegrees,
-			ZrotationDegrees,
-			positionXYZ);
-
-		// set the color for the next draw command
-		//SetShaderColor(0.36, 0.16, 0.11, 1.0);
-		SetShaderTexture("Roof");
-		SetTextureUVScale(1.25, 2.25);
-		SetShaderMaterial("roof");
-		// draw the mesh with transformation values
-		m_basicMeshes->DrawPrismMesh();
-		/****************************************************************/
-
-		/*** Render Door												***/
-		/*** Set needed transformations before drawing the basic mesh.  ***/
-		/*** This same ordering of code should be used for transforming ***/
-		/*** and drawing all the basic 3D shapes.						***/
-		/******************************************************************/
-		// set the XYZ scale for the mesh
-		scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
-
-		// set the XYZ rotation for the mesh
-		XrotationDegrees = 0.0f + Xrot;
-		YrotationDegrees = 90.0f + Yrot;
-		ZrotationDegrees = 0.0f + Zrot;
-
-		// set the XYZ position for the mesh
-		positionXYZ = glm::vec3(0.39f + Xpos, 0.25f + Ypos, 0.0f + Zpos);
-
-		// set the transformations into memory to be used on the drawn meshes
-		SetTransformations(
-			scaleXYZ,
-			XrotationDegrees,
-			YrotationDegrees,
-			ZrotationDegrees,
-			positionXYZ);
-
-
-		// set the color for the next draw command
-		//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-		SetShaderTexture("Wood");
-		SetTextureUVScale(1.5, 2.0);
-		SetShaderMaterial("wood");
-		// draw the mesh with transformation values
-		m_basicMeshes->DrawBoxMesh();
-		/****************************************************************/
-
-		/*** Render Window												***/
-		/*** Set needed transformations before drawing the basic mesh.  ***/
-		/*** This same ordering of code should be used for transforming ***/
-		/*** and drawing all the basic 3D shapes.						***/
-		/******************************************************************/
-		// set the XYZ scale for the mesh
-		scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-		// set the XYZ rotation for the mesh
-		XrotationDegrees = 0.0f + Xrot;
-		YrotationDegrees = 90.0f + Yrot;
-		ZrotationDegrees = 0.0f + Zrot;
-
-		// set the XYZ position for the mesh
-		positionXYZ = glm::vec3(0.39f + Xpos, 0.625f + Ypos, -0.5f + Zpos);
-
-		// set the transformations into memory to be used on the drawn meshes
-		SetTransformations(
-			scaleXYZ,
-			XrotationDegrees,
-			YrotationDegrees,
-			ZrotationDegrees,
-			positionXYZ);
-
-		SetShaderColor(0.41, 0.83, 0.85, 1.0);
-		SetShaderMaterial("glass");
-		// draw the mesh with transformation values
-		m_basicMeshes->DrawBoxMesh();
-		/****************************************************************/
-
-			// draw the mesh with transformation values
-		m_basicMeshes->DrawBoxMesh();
-		/****************************************************************/
-
-		/*** Render Window2												***/
-		/*** Set needed transformations before drawing the basic mesh.  ***/
-		/*** This same ordering of code should be used for transforming ***/
-		/*** and drawing all the basic 3D shapes.						***/
-		/******************************************************************/
-		// set the XYZ scale for the mesh
-		scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
-
-		// set the XYZ rotation for the mesh
-		XrotationDegrees = 0.0f + Xrot;
-		YrotationDegrees = 90.0f + Yrot;
-		ZrotationDegrees = 0.0f + Zrot;
-
-		// set the XYZ position for the mesh
-		positionXYZ = glm::vec3(0.39f + Xpos, 0.625f + Ypos, 0.5f + Zpos);
-
-		// set the transformations into memory to be used on the drawn meshes
-		SetTransformations(
-			scaleXYZ,
-			XrotationDegrees,
-			YrotationDegrees,
-			ZrotationDegrees,
-			positionXYZ);
-
-		SetShaderColor(0.41, 0.83, 0.85, 1.0);
-		SetShaderMaterial("glass");
-		// draw the mesh with transformation values
-		m_basicMeshes->DrawBoxMesh();
-		/****************************************************************/
-	}
-
-/***********************************************************
- *  RenderWindmill()
- *
- *  This method is called to render the shapes for the House object.
- * 
- *  This is the windmill facing left of the camera
- ***********************************************************/
-void SceneManager::RenderWindmill()
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-
-	/*** Render Building											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 4.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(12.0f, 0.0f, -4.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	SetShaderColor(0.91, 0.85, 0.71, 1.0);
-	SetShaderTexture("Brick");
-	SetTextureUVScale(4.0, 4.0);
-	SetShaderMaterial("stone");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	/*** Render Roof											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 2.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(12.0f, 4.0f, -4.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
-	SetShaderTexture("Roof");
-	SetTextureUVScale(2.0, 2.0);
-	SetShaderMaterial("roof");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	/*** Render Pole											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.10f, 1.0f, 0.10f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(11.35f, 3.0f, -3.35f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color for the next draw command
-	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-	SetShaderTexture("Wood");
-	SetTextureUVScale(1.5, 2.0);
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	/*** Render Door												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 45.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(11.38f, 0.25f, -3.38f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	/*** Render Blade1												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.05f, 3.0f, 0.35f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 45.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.75f, 3.0f, -2.75f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	// set the color for the next draw command
-	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-	SetShaderTexture("Wood");
-	SetTextureUVScale(3.0, 6.0);
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render Blade2												***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.05f, 3.0f, 0.35f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -45.0f;
-	YrotationDegrees = 45.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.75f, 3.0f, -2.75f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	// set the color for the next draw command
-	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
-	SetShaderTexture("Wood");
-	SetTextureUVScale(3.0, 6.0);
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-}
-
-/***********************************************************
-*  RenderWall()
-*
-*  This method is called to render the shapes for the Wall object.
-***********************************************************/
-void SceneManager::RenderWall()
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Render WallBase											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(100.0f, 20.0f, 5.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render WallBump											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render WallBump											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(25.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render WallBump											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(50.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render WallBump											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-25.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	/*** Render WallBump											***/
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, 10.0f, -28.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.6, 0.6, 0.6, 1.0);
-	SetShaderMaterial("cement");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.cpp
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+#include "CookedAssets.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+// declaration of global variables
+namespace
+{
+	const char* g_ModelName = "model";
+	const char* g_ColorValueName = "objectColor";
+	const char* g_TextureLayerName = "textureLayer";
+	const char* g_TextureBucketsName = "textureBuckets";
+	const char* g_UseLightingName = "bUseLighting";
+	const char* g_UseInstancingName = "bUseInstancing";
+	const char* g_UVScaleName = "UVscale";
+	const char* g_MaterialIndexName = "materialIndex";
+	const char* g_ObjectLightRangeName = "objectLightRange";
+	const char* g_MaterialBlockName = "MaterialBlock";
+	const char* g_PointLightCountName = "pointLightCount";
+	const char* g_UseIndirectDrawName = "bUseIndirectDraw";
+	const char* g_DrawDataName = "drawData";
+	const char* g_DrawDataFirstName = "drawDataFirst";
+	const char* g_DirectionalLightDirectionName = "directionalLight.direction";
+	const char* g_DirectionalLightAmbientName = "directionalLight.ambient";
+	const char* g_DirectionalLightDiffuseName = "directionalLight.diffuse";
+	const char* g_DirectionalLightSpecularName = "directionalLight.specular";
+	const char* g_DirectionalLightActiveName = "directionalLight.bActive";
+
+	// texture unit of the first texture array, the others
+	// follow on the next units
+	const int g_FirstTextureBucketUnit = 0;
+
+	// uniform buffer binding point of the material table
+	const GLuint g_MaterialBlockBinding = 0;
+	// size of the material table - must match MAX_MATERIALS
+	// in the fragment shader
+	const int g_MaxMaterials = 64;
+
+	// size of the whole point light list
+	const int g_MaxPointLights = 4096;
+
+	// draws per chunk of the per-frame work on the worker threads
+	const int g_DrawChunkSize = 1024;
+
+	// texture unit of the per-draw values read by the indirect
+	// draws, above the units of the light clusters
+	const int g_DrawDataTextureUnit = 19;
+	// frames the CPU may run ahead of the GPU, each with its
+	// own region of the per-draw value ring buffer
+	const int g_FramesInFlight = 3;
+	// indirect draws per frame the ring buffer starts out with,
+	// grown to the draw list when that is longer
+	const int g_MinStreamedDraws = 4096;
+
+	// where the wall and the windmill are built in code, the
+	// point a landmark placement moves them from
+	const glm::vec3 g_WallOrigin(0.0f, 0.0f, -28.0f);
+	const glm::vec3 g_WindmillOrigin(12.0f, 0.0f, -4.0f);
+	// length, height and thickness of the wall built in code
+	const glm::vec3 g_WallSize(105.0f, 20.0f, 10.0f);
+	// windmills of a generated city are shrunk to fit a lot
+	const float g_CityWindmillScale = 0.8f;
+	// house variants, drawn by RenderHouse() to RenderHouse3()
+	const int g_HouseVariants = 3;
+	// templates of a streamed city, the house variants and
+	// then the landmark kinds
+	const int g_StreamHouseTemplates = g_HouseVariants;
+	const int g_StreamTemplates = g_StreamHouseTemplates + 2;
+	// ground plane of the scene built in code, and the number
+	// of times its texture repeats
+	const glm::vec3 g_GroundScale(50.0f, 1.0f, 30.0f);
+	const glm::vec2 g_GroundUVScale(16.0f, 16.0f);
+
+	// one std140 material table entry, the shininess is
+	// packed into the w of the specular color
+	struct MATERIAL_BLOCK_ENTRY
+	{
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColorShininess;
+	};
+
+	// local transform of a scene file node
+	SceneGraph::TRANSFORM GetNodeTransform(const SceneFile::SCENE_NODE& node)
+	{
+		SceneGraph::TRANSFORM nodeTransform = {
+			glm::vec3(node.scaleXYZ[0], node.scaleXYZ[1], node.scaleXYZ[2]),
+			glm::vec3(node.rotationDegrees[0], node.rotationDegrees[1], node.rotationDegrees[2]),
+			glm::vec3(node.positionXYZ[0], node.positionXYZ[1], node.positionXYZ[2]) };
+		return(nodeTransform);
+	}
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager, ShaderUniforms *pShaderUniforms, PipelineStateCache *pPipelineState)
+{
+	m_pShaderManager = pShaderManager;
+	m_pShaderUniforms = pShaderUniforms;
+	m_pPipelineState = pPipelineState;
+	m_bWireframe = false;
+	m_materialBuffer = 0;
+	m_bUseHouseInstancing = true;
+	m_bRecordingDrawList = false;
+	m_bUseDrawList = true;
+	m_bDrawListDirty = false;
+	m_bUseIndirectDraw = false;
+	m_bIndirectDrawListDirty = false;
+	m_drawDataTexture = 0;
+	m_drawDataCapacity = 0;
+	m_maxDrawDataCapacity = 0;
+	m_bUseStaticBake = true;
+	m_transformParent = -1;
+	m_bSceneGraphDirty = false;
+	m_bNodeDrawsDirty = true;
+	m_bGeneratedCity = false;
+	m_groundScale = g_GroundScale;
+	m_groundPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+	m_bFrustumCulling = true;
+	m_bCullingViewSet = false;
+	m_bObjectBVHDirty = true;
+	m_bUseWorldStreaming = false;
+	m_streamSettings = WorldStreamer::GetDefaultSettings();
+	m_bAllowSourceAssets = false;
+	m_visibleDrawCount = 0;
+	for (int i = 0; i < 6; i++)
+	{
+		m_frustumPlanes[i] = glm::vec4(0.0f);
+	}
+	m_renderStats = { 0, 0, 0, 0, 0, 0 };
+
+	// register the uniforms that are set while rendering, so
+	// their locations are only looked up once
+	if (NULL != m_pShaderUniforms)
+	{
+		m_uniforms.model = m_pShaderUniforms->Register<glm::mat4>(g_ModelName);
+		m_uniforms.objectColor = m_pShaderUniforms->Register<glm::vec4>(g_ColorValueName);
+		m_uniforms.textureLayer = m_pShaderUniforms->Register<int>(g_TextureLayerName);
+		m_uniforms.useLighting = m_pShaderUniforms->Register<bool>(g_UseLightingName);
+		m_uniforms.useInstancing = m_pShaderUniforms->Register<bool>(g_UseInstancingName);
+		m_uniforms.UVscale = m_pShaderUniforms->Register<glm::vec2>(g_UVScaleName);
+		m_uniforms.materialIndex = m_pShaderUniforms->Register<int>(g_MaterialIndexName);
+		m_uniforms.objectLightRange = m_pShaderUniforms->Register<glm::ivec2>(g_ObjectLightRangeName);
+		m_uniforms.pointLightCount = m_pShaderUniforms->Register<int>(g_PointLightCountName);
+		m_uniforms.useIndirectDraw = m_pShaderUniforms->Register<bool>(g_UseIndirectDrawName);
+		m_uniforms.drawData = m_pShaderUniforms->Register<int>(g_DrawDataName);
+		m_uniforms.drawDataFirst = m_pShaderUniforms->Register<int>(g_DrawDataFirstName);
+		m_uniforms.directionalLightDirection = m_pShaderUniforms->Register<glm::vec3>(g_DirectionalLightDirectionName);
+		m_uniforms.directionalLightAmbient = m_pShaderUniforms->Register<glm::vec3>(g_DirectionalLightAmbientName);
+		m_uniforms.directionalLightDiffuse = m_pShaderUniforms->Register<glm::vec3>(g_DirectionalLightDiffuseName);
+		m_uniforms.directionalLightSpecular = m_pShaderUniforms->Register<glm::vec3>(g_DirectionalLightSpecularName);
+		m_uniforms.directionalLightActive = m_pShaderUniforms->Register<bool>(g_DirectionalLightActiveName);
+	}
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	m_pShaderManager = NULL;
+	m_pShaderUniforms = NULL;
+	m_pPipelineState = NULL;
+	DestroyGLTextures();
+	if (0 != m_materialBuffer)
+	{
+		glDeleteBuffers(1, &m_materialBuffer);
+		m_materialBuffer = 0;
+	}
+	m_clusteredLighting.Destroy();
+	m_objectLightLists.Destroy();
+	m_pointLights.Destroy();
+	m_staticBake.Destroy();
+	DestroyHouseBatches();
+	m_worldStreamer.Clear();
+	m_indirectDrawList.Destroy();
+	if (0 != m_drawDataTexture)
+	{
+		glDeleteTextures(1, &m_drawDataTexture);
+		m_drawDataTexture = 0;
+	}
+	m_drawDataStream.Destroy();
+	m_meshBuffer.Destroy();
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files
+ *  into the texture array bucket of their size and format.
+ *  The cooked texture the build step made from the image
+ *  file is loaded, and a missing or stale cooked texture is
+ *  an error. The image file is only decoded instead when
+ *  source assets are allowed for development. The texture
+ *  arrays are created by BindGLTextures() once every texture
+ *  is loaded.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+{
+	std::string cookedFilename = CookedAssets::GetCookedFilename(filename, ".tex");
+	if ((true == CookedAssets::IsCookedCurrent(filename, cookedFilename)) &&
+		(true == m_textures.LoadCooked(cookedFilename.c_str(), tag)))
+	{
+		return(true);
+	}
+
+	if (false == m_bAllowSourceAssets)
+	{
+		std::cerr << "ERROR: The cooked texture " << cookedFilename << " is missing or older than "
+			<< filename << ", build the project to cook it" << std::endl;
+		return(false);
+	}
+
+	return(m_textures.Load(filename, tag));
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for creating the texture arrays from
+ *  the loaded textures and binding them to OpenGL texture
+ *  units, one unit per texture array. The shaders pick the
+ *  texture array and its layer per draw.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	m_textures.Upload();
+	m_textures.Bind(g_FirstTextureBucketUnit);
+
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	// point every texture array sampler at its texture unit
+	for (int bucket = 0; bucket < m_textures.GetBucketCount(); bucket++)
+	{
+		std::string samplerName = std::string(g_TextureBucketsName) + "[" + std::to_string(bucket) + "]";
+		UniformHandle<int> sampler = m_pShaderUniforms->Register<int>(samplerName.c_str());
+		m_pShaderUniforms->Set(sampler, g_FirstTextureBucketUnit + bucket);
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory of all the
+ *  loaded textures.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	m_textures.Destroy();
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(TagID tag)
+{
+	return(m_textures.FindTexture(tag));
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(TagID tag, OBJECT_MATERIAL& material)
+{
+	int index = FindMaterialIndex(tag);
+	if (index < 0)
+	{
+		return(false);
+	}
+
+	material.diffuseColor = m_objectMaterials[index].diffuseColor;
+	material.specularColor = m_objectMaterials[index].specularColor;
+	material.shininess = m_objectMaterials[index].shininess;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the index of the previously
+ *  defined material that is associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(TagID tag)
+{
+	return(m_materialTags.Find(tag));
+}
+
+/***********************************************************
+ *  ComposeTransformations()
+ *
+ *  This method is used for building the model matrix from
+ *  the passed in transformation values. The matrix is
+ *  written directly, without multiplying the separate
+ *  scale, rotation and translation matrices together.
+ ***********************************************************/
+glm::mat4 SceneManager::ComposeTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	return(TransformBatch::ComposeMatrix(
+		scaleXYZ,
+		glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees),
+		positionXYZ));
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values. While a
+ *  parent node is set, the values are relative to the node
+ *  and the model matrix hangs below its world matrix.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ,
+	glm::vec3 offset)
+{
+	// variables for this method
+	glm::mat4 modelView;
+
+	modelView = ComposeTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ + offset);
+
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.transformNode = m_transformParent;
+		m_recordedDraw.localModel = modelView;
+	}
+	if (m_transformParent >= 0)
+	{
+		modelView = m_sceneGraph.GetWorldMatrix(m_transformParent) * modelView;
+	}
+
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.model = modelView;
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.model, modelView);
+	}
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.textureSlot = -1;
+		m_recordedDraw.color = currentColor;
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.textureLayer, -1);
+		m_pShaderUniforms->Set(m_uniforms.objectColor, currentColor);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in ID into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	TagID textureTag)
+{
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.textureSlot = FindTextureSlot(textureTag);
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		int textureSlot = -1;
+		textureSlot = FindTextureSlot(textureTag);
+		m_pShaderUniforms->Set(m_uniforms.textureLayer, m_textures.GetLayerRef(textureSlot));
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.UVscale = glm::vec2(u, v);
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.UVscale, glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for selecting the material in the
+ *  shader's material table.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	TagID materialTag)
+{
+	if (true == m_bRecordingDrawList)
+	{
+		// an unknown material keeps the one set before, as the
+		// shader does
+		int materialIndex = FindMaterialIndex(materialTag);
+		if (materialIndex >= 0)
+		{
+			m_recordedDraw.materialIndex = materialIndex;
+		}
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		int materialIndex = FindMaterialIndex(materialTag);
+		if (materialIndex >= 0)
+		{
+			m_pShaderUniforms->Set(m_uniforms.materialIndex, materialIndex);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetObjectDynamic()
+ *
+ *  This method is used for marking the objects drawn next as
+ *  moving. Moving objects stay in the draw list instead of
+ *  being merged into the static bake.
+ ***********************************************************/
+void SceneManager::SetObjectDynamic(bool bDynamic)
+{
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.bDynamic = bDynamic;
+	}
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used for drawing the basic shape mesh
+ *  with the current shader values, out of the shared mesh
+ *  buffer. While the draw list is
+ *  being recorded, the draw is captured together with the
+ *  collected shader values instead.
+ ***********************************************************/
+void SceneManager::DrawMesh(int meshID)
+{
+	if (true == m_bRecordingDrawList)
+	{
+		m_recordedDraw.meshID = meshID;
+		AddDrawEntity(m_drawList, m_recordedDraw);
+		return;
+	}
+
+	m_renderStats.drawCalls++;
+
+	// the shared mesh buffer is bound once per frame, so
+	// switching meshes needs no rebinding
+	m_meshBuffer.DrawMesh(meshID);
+}
+
+/***********************************************************
+ *  RecordDrawList()
+ *
+ *  This method is used for recording the scene objects into
+ *  the draw list. The model matrices, texture slots and
+ *  material indices are resolved once here, so rendering a
+ *  frame only needs to replay the recorded commands.
+ ***********************************************************/
+void SceneManager::RecordDrawList()
+{
+	m_drawList.Clear();
+	m_bObjectBVHDirty = true;
+	m_bNodeDrawsDirty = true;
+
+	ResetRecordedDraw();
+	m_bRecordingDrawList = true;
+	SubmitSceneObjects();
+	m_bRecordingDrawList = false;
+
+	// move the static objects out of the draw list and into
+	// the merged meshes
+	m_staticBake.Clear();
+	m_bakedDraws.clear();
+	if (true == m_bUseStaticBake)
+	{
+		BakeStaticGeometry();
+	}
+
+	// the scene and its lights do not move, so the lights of
+	// every object are found once here
+	AssignObjectLights();
+
+	// the recorded order follows the source code, so the
+	// list must be sorted before it is replayed
+	m_bDrawListDirty = true;
+}
+
+/***********************************************************
+ *  ResetRecordedDraw()
+ *
+ *  This method is used for starting every recording from the
+ *  default shader values.
+ ***********************************************************/
+void SceneManager::ResetRecordedDraw()
+{
+	m_recordedDraw.meshID = MESH_BOX;
+	m_recordedDraw.model = glm::mat4(1.0f);
+	m_recordedDraw.transformNode = -1;
+	m_recordedDraw.localModel = glm::mat4(1.0f);
+	m_recordedDraw.textureSlot = -1;
+	// the first material of the shader's table until one is set
+	m_recordedDraw.materialIndex = 0;
+	m_recordedDraw.UVscale = glm::vec2(1.0f, 1.0f);
+	m_recordedDraw.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	m_recordedDraw.lightRange = glm::ivec2(0, -1);
+	m_recordedDraw.bDynamic = false;
+	m_recordedDraw.sourceKey = 0;
+}
+
+/***********************************************************
+ *  RecordSceneFileObjects()
+ *
+ *  This method is used for recording the objects of the
+ *  mapped scene file into the draw list. The object table
+ *  is read in place, and only the handful of tags is looked
+ *  up by name - once, before the objects are walked. Scene
+ *  files are only drawn through the draw list.
+ ***********************************************************/
+void SceneManager::RecordSceneFileObjects()
+{
+	if (false == m_bRecordingDrawList)
+	{
+		return;
+	}
+
+	SCENE_FILE_TAGS tags;
+	ResolveSceneFileTags(m_sceneFile, tags);
+
+	const SceneFile::SCENE_OBJECT* pObjects = m_sceneFile.GetObjects();
+	int objectCount = m_sceneFile.GetObjectCount();
+
+	m_drawList.Reserve(m_drawList.GetEntityCount() + objectCount);
+	int materialIndex = 0;
+	for (int i = 0; i < objectCount; i++)
+	{
+		DRAW_COMMAND draw;
+		if (true == MakeSceneFileDraw(pObjects[i], tags, materialIndex, draw))
+		{
+			AddDrawEntity(m_drawList, draw);
+		}
+	}
+}
+
+/***********************************************************
+ *  ResolveSceneFileTags()
+ *
+ *  This method is used for looking up the texture slot, the
+ *  material index and the hash of every tag of a scene file,
+ *  once, before its objects are walked.
+ ***********************************************************/
+void SceneManager::ResolveSceneFileTags(const SceneFile& sceneFile, SCENE_FILE_TAGS& tags)
+{
+	int tagCount = sceneFile.GetTagCount();
+	tags.textureSlots.resize(tagCount);
+	tags.materialIndices.resize(tagCount);
+	tags.tagHashes.resize(tagCount);
+	for (int tag = 0; tag < tagCount; tag++)
+	{
+		std::string name = sceneFile.GetTag(tag);
+		TagID tagID(name);
+		tags.textureSlots[tag] = FindTextureSlot(tagID);
+		tags.materialIndices[tag] = FindMaterialIndex(tagID);
+		tags.tagHashes[tag] = tagID.GetHash();
+	}
+}
+
+/***********************************************************
+ *  MakeSceneFileDraw()
+ *
+ *  This method is used for making the draw of a scene file
+ *  object. The draw also gets the key of the object - a hash
+ *  of its record with the texture tag index replaced by the
+ *  tag hash and the material tag by the material it is
+ *  drawn with - so a reload can match it with the same
+ *  object of a new file, wherever the object and its tags
+ *  are in the tables.
+ *
+ *  An object without a known material keeps the material of
+ *  the object before it in the file, the passed in material
+ *  index, which is then set to the material of this object.
+ *  The objects must therefore be made in file order, and the
+ *  draw always ends up with a material of its own.
+ ***********************************************************/
+bool SceneManager::MakeSceneFileDraw(
+	const SceneFile::SCENE_OBJECT& object,
+	const SCENE_FILE_TAGS& tags,
+	int& materialIndex,
+	DRAW_COMMAND& draw)
+{
+	if (object.meshID >= MESH_COUNT)
+	{
+		return(false);
+	}
+
+	int tagCount = (int)tags.tagHashes.size();
+	bool bHasTexture = ((object.textureTag >= 0) && (object.textureTag < tagCount));
+	bool bHasMaterial = ((object.materialTag >= 0) && (object.materialTag < tagCount));
+
+	if ((true == bHasMaterial) && (tags.materialIndices[object.materialTag] >= 0))
+	{
+		materialIndex = tags.materialIndices[object.materialTag];
+	}
+
+	// the key holds the material the object is drawn with, so
+	// an object inheriting another material is a new object
+	SceneFile::SCENE_OBJECT keyObject = object;
+	keyObject.textureTag = (true == bHasTexture) ? (int32_t)tags.tagHashes[object.textureTag] : -1;
+	keyObject.materialTag = (int32_t)materialIndex;
+	uint64_t sourceKey = CookedAssets::HashBytes(&keyObject, sizeof(keyObject), CookedAssets::HASH_SEED);
+
+	draw.meshID = (int)object.meshID;
+	draw.localModel = glm::mat4(
+		glm::vec4(object.localModel[0][0], object.localModel[0][1], object.localModel[0][2], 0.0f),
+		glm::vec4(object.localModel[1][0], object.localModel[1][1], object.localModel[1][2], 0.0f),
+		glm::vec4(object.localModel[2][0], object.localModel[2][1], object.localModel[2][2], 0.0f),
+		glm::vec4(object.localModel[3][0], object.localModel[3][1], object.localModel[3][2], 1.0f));
+	draw.transformNode = -1;
+	draw.model = draw.localModel;
+	if ((object.node >= 0) && (object.node < (int)m_sceneFileNodes.size()))
+	{
+		draw.transformNode = m_sceneFileNodes[object.node];
+		draw.model = m_sceneGraph.GetWorldMatrix(draw.transformNode) * draw.localModel;
+	}
+	draw.textureSlot = (true == bHasTexture) ? tags.textureSlots[object.textureTag] : -1;
+	draw.materialIndex = materialIndex;
+	draw.color = glm::vec4(object.color[0], object.color[1], object.color[2], object.color[3]);
+	draw.UVscale = glm::vec2(object.UVscale[0], object.UVscale[1]);
+	draw.lightRange = glm::ivec2(0, -1);
+	draw.bDynamic = (0 != (object.flags & SceneFile::OBJECT_DYNAMIC));
+	// 0 is kept for the objects built in code
+	draw.sourceKey = (0 != sourceKey) ? sourceKey : 1;
+
+	return(true);
+}
+
+/***********************************************************
+ *  MakeSortKey()
+ *
+ *  This method is used for building the 64-bit key that
+ *  orders the draw submission. The most expensive state
+ *  change goes in the highest bits, so sorting by the key
+ *  groups draws sharing a program, then a texture, then a
+ *  material, then a mesh:
+ *
+ *    bits 56-63  shader program
+ *    bits 40-55  texture slot + 1 (0 = drawn with color)
+ *    bits 24-39  material index + 1 (0 = no material)
+ *    bits  8-23  mesh
+ *    bits  0-7   unused
+ ***********************************************************/
+uint64_t SceneManager::MakeSortKey(
+	const EntityStore::MESH_REF& mesh,
+	const EntityStore::TEXTURE_REF& texture,
+	const EntityStore::MATERIAL_REF& material) const
+{
+	// the scene is drawn with a single shader program
+	uint64_t programBits = 0;
+	uint64_t textureBits = (uint64_t)(texture.textureSlot + 1) & 0xFFFF;
+	uint64_t materialBits = (uint64_t)(material.materialIndex + 1) & 0xFFFF;
+	uint64_t meshBits = (uint64_t)mesh.meshID & 0xFFFF;
+
+	return((programBits << 56) | (textureBits << 40) | (materialBits << 24) | (meshBits << 8));
+}
+
+/***********************************************************
+ *  AddDrawEntity()
+ *
+ *  This method is used for adding a recorded draw to a draw
+ *  list as an entity, one component per part of its values.
+ *  The world space box of the draw is found once here, and
+ *  after that only when its node moves.
+ ***********************************************************/
+void SceneManager::AddDrawEntity(EntityStore& drawList, const DRAW_COMMAND& draw)
+{
+	EntityStore::ENTITY entity = drawList.CreateEntity();
+
+	EntityStore::TRANSFORM_COMPONENT transform = { draw.model, draw.localModel, draw.transformNode };
+	EntityStore::TEXTURE_REF texture = { draw.textureSlot, draw.UVscale, draw.color };
+	EntityStore::BOUNDS_COMPONENT bounds;
+	MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(draw.meshID), draw.model, bounds.worldBounds);
+	EntityStore::FLAGS_COMPONENT flags = { (true == draw.bDynamic) ? (uint32_t)EntityStore::ENTITY_DYNAMIC : 0 };
+
+	drawList.Add(entity, transform);
+	drawList.Add(entity, EntityStore::MESH_REF{ draw.meshID });
+	drawList.Add(entity, EntityStore::MATERIAL_REF{ draw.materialIndex });
+	drawList.Add(entity, texture);
+	drawList.Add(entity, bounds);
+	drawList.Add(entity, EntityStore::LIGHT_LIST_REF{ draw.lightRange });
+	drawList.Add(entity, flags);
+	drawList.Add(entity, EntityStore::SOURCE_REF{ draw.sourceKey });
+}
+
+/***********************************************************
+ *  GetDrawCommands()
+ *
+ *  This method is used for reading the draws of a draw list
+ *  back out of their entities, in the order they are stored.
+ ***********************************************************/
+void SceneManager::GetDrawCommands(EntityStore& drawList, std::vector<DRAW_COMMAND>& draws)
+{
+	draws.clear();
+	draws.reserve(drawList.GetEntityCount());
+
+	drawList.Each<
+		EntityStore::TRANSFORM_COMPONENT,
+		EntityStore::MESH_REF,
+		EntityStore::MATERIAL_REF,
+		EntityStore::TEXTURE_REF,
+		EntityStore::LIGHT_LIST_REF,
+		EntityStore::FLAGS_COMPONENT,
+		EntityStore::SOURCE_REF>(
+		[&draws](int,
+			EntityStore::TRANSFORM_COMPONENT& transform,
+			EntityStore::MESH_REF& mesh,
+			EntityStore::MATERIAL_REF& material,
+			EntityStore::TEXTURE_REF& texture,
+			EntityStore::LIGHT_LIST_REF& lights,
+			EntityStore::FLAGS_COMPONENT& flags,
+			EntityStore::SOURCE_REF& source)
+		{
+			DRAW_COMMAND draw;
+			draw.meshID = mesh.meshID;
+			draw.model = transform.model;
+			draw.transformNode = transform.transformNode;
+			draw.localModel = transform.localModel;
+			draw.textureSlot = texture.textureSlot;
+			draw.materialIndex = material.materialIndex;
+			draw.UVscale = texture.UVscale;
+			draw.color = texture.color;
+			draw.lightRange = lights.lightRange;
+			draw.bDynamic = (0 != (flags.flags & EntityStore::ENTITY_DYNAMIC));
+			draw.sourceKey = source.sourceKey;
+			draws.push_back(draw);
+		});
+}
+
+/***********************************************************
+ *  SortDrawList()
+ *
+ *  This method is used for sorting the draw list by the draw
+ *  command keys. The sort is stable, so draws sharing a key
+ *  keep their recorded order. Every component array is put
+ *  into the sorted order, so the systems walking the draw
+ *  list stream through the arrays in submission order.
+ ***********************************************************/
+void SceneManager::SortDrawList()
+{
+	std::vector<std::pair<uint64_t, EntityStore::ENTITY>> keys;
+	keys.reserve(m_drawList.GetEntityCount());
+	m_drawList.Each<EntityStore::MESH_REF, EntityStore::TEXTURE_REF, EntityStore::MATERIAL_REF>(
+		[this, &keys](int slot,
+			EntityStore::MESH_REF& mesh,
+			EntityStore::TEXTURE_REF& texture,
+			EntityStore::MATERIAL_REF& material)
+		{
+			keys.push_back(std::make_pair(
+				MakeSortKey(mesh, texture, material),
+				m_drawList.GetEntity<EntityStore::MESH_REF>(slot)));
+		});
+
+	std::stable_sort(keys.begin(), keys.end(),
+		[](const std::pair<uint64_t, EntityStore::ENTITY>& a, const std::pair<uint64_t, EntityStore::ENTITY>& b)
+		{
+			return(a.first < b.first);
+		});
+
+	std::vector<EntityStore::ENTITY> order;
+	order.reserve(keys.size());
+	for (const std::pair<uint64_t, EntityStore::ENTITY>& key : keys)
+	{
+		order.push_back(key.second);
+	}
+	m_drawList.SortEntities(order);
+
+	// the hierarchy items are the slots, which have moved
+	m_bObjectBVHDirty = true;
+	m_bDrawListDirty = false;
+	m_bIndirectDrawListDirty = true;
+}
+
+/***********************************************************
+ *  ReplayDrawList()
+ *
+ *  This method is used for drawing the recorded draw list in
+ *  sort key order. The last submitted texture, color, UV
+ *  scale and material are remembered, so a shader value is
+ *  only set when it differs from the previous draw. The
+ *  draws outside the view frustum are skipped.
+ ***********************************************************/
+void SceneManager::ReplayDrawList()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	if (true == m_bDrawListDirty)
+	{
+		SortDrawList();
+	}
+	CullDrawList();
+
+	ReplayVisibleDraws();
+}
+
+/***********************************************************
+ *  ReplayVisibleDraws()
+ *
+ *  This method is used for drawing the draws of the sorted
+ *  draw list that the last CullDrawList() left visible, one
+ *  call per draw.
+ ***********************************************************/
+void SceneManager::ReplayVisibleDraws()
+{
+	// start from an unknown state so the first draw sets everything
+	bool bFirstDraw = true;
+	EntityStore::TEXTURE_REF lastTexture = { -1, glm::vec2(0.0f), glm::vec4(0.0f) };
+	int lastMaterialIndex = -1;
+	glm::ivec2 lastLightRange(0, -1);
+
+	m_drawList.Each<
+		EntityStore::TRANSFORM_COMPONENT,
+		EntityStore::MESH_REF,
+		EntityStore::MATERIAL_REF,
+		EntityStore::TEXTURE_REF,
+		EntityStore::LIGHT_LIST_REF>(
+		[&](int slot,
+			EntityStore::TRANSFORM_COMPONENT& transform,
+			EntityStore::MESH_REF& mesh,
+			EntityStore::MATERIAL_REF& material,
+			EntityStore::TEXTURE_REF& texture,
+			EntityStore::LIGHT_LIST_REF& lights)
+		{
+			if (0 == m_drawVisible[slot])
+			{
+				return;
+			}
+
+			m_pShaderUniforms->Set(m_uniforms.model, transform.model);
+
+			if ((true == bFirstDraw) ||
+				(texture.textureSlot != lastTexture.textureSlot) ||
+				((texture.textureSlot < 0) && (texture.color != lastTexture.color)))
+			{
+				m_pShaderUniforms->Set(m_uniforms.textureLayer, m_textures.GetLayerRef(texture.textureSlot));
+				if (texture.textureSlot < 0)
+				{
+					m_pShaderUniforms->Set(m_uniforms.objectColor, texture.color);
+				}
+				m_renderStats.stateChanges++;
+			}
+			else
+			{
+				m_renderStats.stateChangesAvoided++;
+			}
+
+			if ((true == bFirstDraw) || (texture.UVscale != lastTexture.UVscale))
+			{
+				m_pShaderUniforms->Set(m_uniforms.UVscale, texture.UVscale);
+				m_renderStats.stateChanges++;
+			}
+			else
+			{
+				m_renderStats.stateChangesAvoided++;
+			}
+
+			if ((material.materialIndex >= 0) &&
+				((true == bFirstDraw) || (material.materialIndex != lastMaterialIndex)))
+			{
+				m_pShaderUniforms->Set(m_uniforms.materialIndex, material.materialIndex);
+				m_renderStats.stateChanges++;
+			}
+			else if (material.materialIndex >= 0)
+			{
+				m_renderStats.stateChangesAvoided++;
+			}
+
+			if ((true == bFirstDraw) || (lights.lightRange != lastLightRange))
+			{
+				m_pShaderUniforms->Set(m_uniforms.objectLightRange, lights.lightRange);
+				m_renderStats.stateChanges++;
+			}
+			else
+			{
+				m_renderStats.stateChangesAvoided++;
+			}
+
+			DrawMesh(mesh.meshID);
+
+			bFirstDraw = false;
+			lastTexture = texture;
+			lastMaterialIndex = material.materialIndex;
+			lastLightRange = lights.lightRange;
+		});
+}
+
+/***********************************************************
+ *  BuildIndirectDrawList()
+ *
+ *  This method is used for writing the sorted draw list into
+ *  the indirect draw commands. The commands only change when
+ *  the draw list does, the per-draw values are written every
+ *  frame in SubmitIndirectDrawList().
+ ***********************************************************/
+void SceneManager::BuildIndirectDrawList()
+{
+	m_indirectDrawList.Clear();
+
+	m_drawList.Each<EntityStore::TRANSFORM_COMPONENT, EntityStore::MESH_REF>(
+		[this](int, EntityStore::TRANSFORM_COMPONENT&, EntityStore::MESH_REF& mesh)
+		{
+			m_indirectDrawList.AddDraw(m_meshBuffer.GetRange(mesh.meshID));
+		});
+
+	m_indirectDrawList.Upload(m_meshBuffer);
+	m_bIndirectDrawListDirty = false;
+}
+
+/***********************************************************
+ *  SubmitIndirectDrawList()
+ *
+ *  This method is used for drawing the draw list with the
+ *  indirect draw commands. The texture is picked per draw
+ *  from the texture arrays, so the whole list is drawn with
+ *  a single multi-draw call, and every value is read per
+ *  draw in the vertex shader from the per-draw value ring
+ *  buffer. Only the draws inside the view frustum are
+ *  submitted, and their values and commands are written on
+ *  the worker threads - the GL thread only uploads and draws.
+ ***********************************************************/
+void SceneManager::SubmitIndirectDrawList()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	if (true == m_bDrawListDirty)
+	{
+		SortDrawList();
+	}
+	if (true == m_bIndirectDrawListDirty)
+	{
+		BuildIndirectDrawList();
+	}
+	CullDrawList();
+	if (0 == m_visibleDrawCount)
+	{
+		return;
+	}
+
+	// the ring grows to hold every draw of the list, so it is
+	// not grown again as more of the list comes into view
+	if ((m_visibleDrawCount > m_drawDataCapacity) && (m_drawDataCapacity < m_maxDrawDataCapacity))
+	{
+		CreateDrawDataStream(m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>());
+		m_drawDataStream.BeginFrame();
+	}
+
+	// the per-draw values of the visible draws are written
+	// straight into the mapped ring buffer, packed in order
+	GLintptr offset = 0;
+	IndirectDrawList::DRAW_DATA* pDrawData = (IndirectDrawList::DRAW_DATA*)m_drawDataStream.Allocate(
+		m_visibleDrawCount * sizeof(IndirectDrawList::DRAW_DATA),
+		sizeof(IndirectDrawList::DRAW_DATA),
+		offset);
+	if (NULL == pDrawData)
+	{
+		// more draws are visible than one texture buffer can
+		// hold values for, so they are drawn one by one
+		m_renderStats.streamFallbacks++;
+		ReplayVisibleDraws();
+		return;
+	}
+
+	// every chunk of draws writes its values and commands from
+	// its own first slot, so the workers never share a slot
+	m_indirectDrawList.BeginVisibleDraws(m_visibleDrawCount);
+	m_workerPool.ParallelFor(m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>(), g_DrawChunkSize,
+		[this, pDrawData](int begin, int end)
+		{
+			int visibleSlot = m_chunkFirstSlots[begin / g_DrawChunkSize];
+
+			m_drawList.EachRange<
+				EntityStore::TRANSFORM_COMPONENT,
+				EntityStore::MATERIAL_REF,
+				EntityStore::TEXTURE_REF,
+				EntityStore::LIGHT_LIST_REF>(
+				begin, end,
+				[this, pDrawData, &visibleSlot](int slot,
+					EntityStore::TRANSFORM_COMPONENT& transform,
+					EntityStore::MATERIAL_REF& material,
+					EntityStore::TEXTURE_REF& texture,
+					EntityStore::LIGHT_LIST_REF& lights)
+				{
+					if (0 == m_drawVisible[slot])
+					{
+						return;
+					}
+
+					IndirectDrawList::DRAW_DATA& drawData = pDrawData[visibleSlot];
+					drawData.model = transform.model;
+					drawData.color = texture.color;
+					drawData.UVscaleMaterialLayer = glm::vec4(
+						texture.UVscale.x,
+						texture.UVscale.y,
+						(float)material.materialIndex,
+						(float)m_textures.GetLayerRef(texture.textureSlot));
+					drawData.lightRange = glm::vec4((float)lights.lightRange.x, (float)lights.lightRange.y, 0.0f, 0.0f);
+
+					m_indirectDrawList.SetVisibleDraw(visibleSlot, slot);
+					visibleSlot++;
+				});
+		});
+	m_drawDataStream.Flush();
+	m_indirectDrawList.UploadVisibleDraws();
+
+	m_pShaderUniforms->Set(m_uniforms.drawDataFirst, (int)(offset / sizeof(IndirectDrawList::DRAW_DATA)));
+	m_pShaderUniforms->Set(m_uniforms.useIndirectDraw, true);
+
+	m_indirectDrawList.Draw();
+	m_renderStats.drawCalls++;
+
+	m_pShaderUniforms->Set(m_uniforms.useIndirectDraw, false);
+}
+
+/***********************************************************
+ *  BakeStaticGeometry()
+ *
+ *  This method is used for moving every static draw of the
+ *  draw list into the static bake. Only the dynamic draws
+ *  are left in the draw list. Every draw already has its
+ *  material resolved when it is recorded, so the bake can be
+ *  rebuilt without the draws before it.
+ ***********************************************************/
+void SceneManager::BakeStaticGeometry()
+{
+	std::vector<DRAW_COMMAND> draws;
+	GetDrawCommands(m_drawList, draws);
+
+	for (const DRAW_COMMAND& draw : draws)
+	{
+		if (false == draw.bDynamic)
+		{
+			m_bakedDraws.push_back(draw);
+		}
+	}
+
+	std::vector<EntityStore::ENTITY> staticEntities;
+	m_drawList.Each<EntityStore::FLAGS_COMPONENT>(
+		[this, &staticEntities](int slot, EntityStore::FLAGS_COMPONENT& flags)
+		{
+			if (0 == (flags.flags & EntityStore::ENTITY_DYNAMIC))
+			{
+				staticEntities.push_back(m_drawList.GetEntity<EntityStore::FLAGS_COMPONENT>(slot));
+			}
+		});
+
+	RebuildStaticBake();
+	m_drawList.DestroyEntities(staticEntities);
+}
+
+/***********************************************************
+ *  RebuildStaticBake()
+ *
+ *  This method is used for merging the baked draws into the
+ *  static bake. The merged meshes are in world space, so a
+ *  baked draw that moves is taken out of the bake and drawn
+ *  from the draw list instead, until the bake is rebuilt.
+ ***********************************************************/
+void SceneManager::RebuildStaticBake()
+{
+	MeshGeometry::MESH_DATA mesh;
+
+	m_staticBake.Clear();
+	m_bakedObjects.clear();
+	for (const DRAW_COMMAND& draw : m_bakedDraws)
+	{
+		StaticGeometryBake::BAKE_KEY key;
+		key.textureSlot = draw.textureSlot;
+		key.materialIndex = draw.materialIndex;
+		key.color = draw.color;
+
+		m_meshBuffer.GetMeshData(draw.meshID, mesh);
+		m_bakedObjects.push_back(m_staticBake.AddObject(mesh, draw.model, draw.UVscale, key));
+	}
+
+	m_staticBake.Upload();
+}
+
+/***********************************************************
+ *  AssignObjectLights()
+ *
+ *  This method is used for finding the point lights that
+ *  reach each drawn object - every command of the draw list,
+ *  every merged mesh of the bake and of the loaded chunks,
+ *  and every house batch - and for uploading the light
+ *  lists of all of them. The draws reached by each light
+ *  are found in the object hierarchy, so a light only
+ *  visits the draws near it, and the lists are then grouped
+ *  by draw.
+ ***********************************************************/
+void SceneManager::AssignObjectLights()
+{
+	m_objectLightLists.Clear();
+	UpdateObjectBVH();
+
+	int drawCount = m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>();
+	std::vector<std::pair<int, GLuint>> drawLights;
+	for (int i = 0; i < m_pointLights.GetLightCount(); i++)
+	{
+		const LightBuffer::POINT_LIGHT& light = m_pointLights.GetLight(i);
+		m_objectBVH.QuerySphere(light.position, light.range, m_queryItems);
+		for (int item : m_queryItems)
+		{
+			// the baked draws are lit by the lists of their batches
+			if (item < drawCount)
+			{
+				drawLights.push_back(std::make_pair(item, (GLuint)i));
+			}
+		}
+	}
+
+	// group the lights by draw, keeping the lights of a draw
+	// in light order
+	std::vector<int> firstLights(drawCount + 1, 0);
+	for (const std::pair<int, GLuint>& drawLight : drawLights)
+	{
+		firstLights[drawLight.first + 1]++;
+	}
+	for (int slot = 0; slot < drawCount; slot++)
+	{
+		firstLights[slot + 1] += firstLights[slot];
+	}
+	std::vector<GLuint> lightIndices(drawLights.size());
+	std::vector<int> nextLights(firstLights.begin(), firstLights.end() - 1);
+	for (const std::pair<int, GLuint>& drawLight : drawLights)
+	{
+		lightIndices[nextLights[drawLight.first]++] = drawLight.second;
+	}
+
+	m_drawList.Each<EntityStore::TRANSFORM_COMPONENT, EntityStore::LIGHT_LIST_REF>(
+		[this, &firstLights, &lightIndices](int slot, EntityStore::TRANSFORM_COMPONENT&, EntityStore::LIGHT_LIST_REF& lights)
+		{
+			lights.lightRange = m_objectLightLists.AddObjectLights(
+				lightIndices.data() + firstLights[slot],
+				firstLights[slot + 1] - firstLights[slot]);
+		});
+
+	m_bakeLightRanges.clear();
+	for (int batch = 0; batch < m_staticBake.GetBatchCount(); batch++)
+	{
+		// the merged meshes are already in world space
+		m_bakeLightRanges.push_back(m_objectLightLists.AddObject(m_staticBake.GetBatchBounds(batch), m_pointLights));
+	}
+
+	for (HOUSE_BATCH& batch : m_houseBatches)
+	{
+		// a batch without instances is not drawn
+		batch.lightRange = glm::ivec2(0, -1);
+		if (false == batch.instances.empty())
+		{
+			batch.lightRange = m_objectLightLists.AddObject(batch.bounds, m_pointLights);
+		}
+	}
+
+	m_streamLightRanges.clear();
+	for (int chunk : m_worldStreamer.GetLoadedChunks())
+	{
+		const StaticGeometryBake& chunkBake = m_worldStreamer.GetChunkBake(chunk);
+		for (int batch = 0; batch < chunkBake.GetBatchCount(); batch++)
+		{
+			m_streamLightRanges.push_back(m_objectLightLists.AddObject(chunkBake.GetBatchBounds(batch), m_pointLights));
+		}
+	}
+
+	m_objectLightLists.Upload();
+}
+
+/***********************************************************
+ *  UploadObjectLights()
+ *
+ *  This method is used for uploading the point light lists
+ *  found again for the moved, added or removed objects. The
+ *  lists left behind by them stay in the light indices, so
+ *  once they outweigh the lists in use, all the lists are
+ *  assigned again and packed.
+ ***********************************************************/
+void SceneManager::UploadObjectLights()
+{
+	if (m_objectLightLists.GetUnusedCount() > m_objectLightLists.GetStats().lightIndices)
+	{
+		AssignObjectLights();
+	}
+	else
+	{
+		m_objectLightLists.Upload();
+	}
+}
+
+/***********************************************************
+ *  RenderStaticBake()
+ *
+ *  This method is used for drawing the merged static meshes,
+ *  one draw call per texture, material and color. The
+ *  meshes are already in world space with their UV scale
+ *  applied, so the model matrix and UV scale are identity.
+ ***********************************************************/
+void SceneManager::RenderStaticBake()
+{
+	if ((NULL == m_pShaderUniforms) || (0 == m_staticBake.GetBatchCount()))
+	{
+		return;
+	}
+
+	m_staticBake.Bind();
+
+	m_pShaderUniforms->Set(m_uniforms.model, glm::mat4(1.0f));
+	m_pShaderUniforms->Set(m_uniforms.UVscale, glm::vec2(1.0f, 1.0f));
+
+	for (int batch = 0; batch < m_staticBake.GetBatchCount(); batch++)
+	{
+		SetBakeBatchState(m_staticBake.GetBatchKey(batch), m_bakeLightRanges[batch]);
+
+		m_staticBake.DrawBatch(batch);
+		m_renderStats.drawCalls++;
+	}
+}
+
+/***********************************************************
+ *  RenderStreamedChunks()
+ *
+ *  This method is used for drawing the merged meshes of the
+ *  loaded chunks of a streamed city, the same way as the
+ *  static bake. A chunk outside the view frustum is skipped
+ *  as a whole.
+ ***********************************************************/
+void SceneManager::RenderStreamedChunks()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	m_pShaderUniforms->Set(m_uniforms.model, glm::mat4(1.0f));
+	m_pShaderUniforms->Set(m_uniforms.UVscale, glm::vec2(1.0f, 1.0f));
+
+	bool bCulling = (true == m_bFrustumCulling) && (true == m_bCullingViewSet);
+	// the light lists follow the merged meshes of the loaded
+	// chunks in order
+	int lightRange = 0;
+	for (int chunk : m_worldStreamer.GetLoadedChunks())
+	{
+		const StaticGeometryBake& chunkBake = m_worldStreamer.GetChunkBake(chunk);
+		int batchCount = chunkBake.GetBatchCount();
+
+		if ((true == bCulling) && (false == MeshGeometry::IsBoundsInFrustum(m_worldStreamer.GetChunkBounds(chunk), m_frustumPlanes)))
+		{
+			m_renderStats.drawsCulled += batchCount;
+			lightRange += batchCount;
+			continue;
+		}
+
+		chunkBake.Bind();
+		for (int batch = 0; batch < batchCount; batch++)
+		{
+			SetBakeBatchState(chunkBake.GetBatchKey(batch), m_streamLightRanges[lightRange++]);
+
+			chunkBake.DrawBatch(batch);
+			m_renderStats.drawCalls++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetBakeBatchState()
+ *
+ *  This method is used for setting the texture, color,
+ *  material and point light list of a merged mesh into the
+ *  shader.
+ ***********************************************************/
+void SceneManager::SetBakeBatchState(const StaticGeometryBake::BAKE_KEY& key, glm::ivec2 lightRange)
+{
+	m_pShaderUniforms->Set(m_uniforms.textureLayer, m_textures.GetLayerRef(key.textureSlot));
+	if (key.textureSlot < 0)
+	{
+		m_pShaderUniforms->Set(m_uniforms.objectColor, key.color);
+	}
+	if (key.materialIndex >= 0)
+	{
+		m_pShaderUniforms->Set(m_uniforms.materialIndex, key.materialIndex);
+	}
+	m_pShaderUniforms->Set(m_uniforms.objectLightRange, lightRange);
+	m_renderStats.stateChanges++;
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+/***********************************************************
+  *  LoadSceneTextures()
+  *
+  *  This method is used for preparing the 3D scene by loading
+  *  the shapes, textures in memory to support the 3D scene
+  *  rendering
+  ***********************************************************/
+void SceneManager::LoadSceneTextures()
+{
+	/*** STUDENTS - add the code BELOW for loading the textures that ***/
+	/*** will be used for mapping to objects in the 3D scene. Refer  ***/
+	/*** to the code in the OpenGL Sample for help.                  ***/
+	bool bReturn = false;
+
+	bReturn = CreateGLTexture(
+		"textures/Grass.jpg",
+		"Grass");
+
+	bReturn = CreateGLTexture(
+		"textures/Brick.jpg",
+		"Brick");
+
+	bReturn = CreateGLTexture(
+		"textures/Roof.jpg",
+		"Roof");
+
+	bReturn = CreateGLTexture(
+		"textures/Wood.jpg",
+		"Wood");
+
+	// after the texture image data is loaded into memory, the
+	// loaded textures are packed into texture arrays - one per
+	// image size and format - and bound to texture units
+	BindGLTextures();
+}
+
+void SceneManager::DefineObjectMaterials()
+{
+	OBJECT_MATERIAL metal;
+	metal.diffuseColor = glm::vec3(0.4f, 0.4f, 0.4f);
+	metal.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	metal.shininess = 52.0;
+	metal.tag = "metal";
+
+	m_objectMaterials.push_back(metal);
+
+	OBJECT_MATERIAL wood;
+	wood.diffuseColor = glm::vec3(0.78f, 0.49f, 0.2f);
+	wood.specularColor = glm::vec3(0.96f, 0.72f, 0.49f);
+	wood.shininess = 4.0;
+	wood.tag = "wood";
+
+	m_objectMaterials.push_back(wood);
+
+	OBJECT_MATERIAL glass;
+	glass.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	glass.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	glass.shininess = 0.25;
+	glass.tag = "glass";
+
+	m_objectMaterials.push_back(glass);
+
+	OBJECT_MATERIAL stone;
+	stone.diffuseColor = glm::vec3(0.7f, 0.7f, 0.7f);
+	stone.specularColor = glm::vec3(0.75f, 0.75f, 0.75f);
+	stone.shininess = 2.0;
+	stone.tag = "stone";
+
+	m_objectMaterials.push_back(stone);
+
+	OBJECT_MATERIAL roof;
+	roof.diffuseColor = glm::vec3(0.7f, 0.35f, 0.0f);
+	roof.specularColor = glm::vec3(0.9f, 0.53f, 0.17f);
+	roof.shininess = 30.0;
+	roof.tag = "roof";
+
+	m_objectMaterials.push_back(roof);
+
+	OBJECT_MATERIAL cement;
+	cement.diffuseColor = glm::vec3(0.6f, 0.6f, 0.6f);
+	cement.specularColor = glm::vec3(0.75f, 0.75f, 0.75f);
+	cement.shininess = 1.0;
+	cement.tag = "cement";
+
+	m_objectMaterials.push_back(cement);
+
+	OBJECT_MATERIAL grass;
+	grass.diffuseColor = glm::vec3(0.7f, 0.8f, 0.2f);
+	grass.specularColor = glm::vec3(0.88f, 1.0f, 0.24f);
+	grass.shininess = 5.0;
+	grass.tag = "grass";
+
+	m_objectMaterials.push_back(grass);
+
+}
+
+/***********************************************************
+ *  UploadMaterialBuffer()
+ *
+ *  This method is used for uploading all the defined
+ *  materials into a std140 uniform buffer. The shaders pick
+ *  the material of a draw by its index in the table, so
+ *  changing materials only sets one integer.
+ ***********************************************************/
+void SceneManager::UploadMaterialBuffer()
+{
+	MATERIAL_BLOCK_ENTRY materialTable[g_MaxMaterials] = {};
+	int materialCount = (int)m_objectMaterials.size();
+
+	// the draws find their material by tag in the registry,
+	// the first material defined with a tag keeps it
+	m_materialTags.Clear();
+	for (int i = 0; i < materialCount; i++)
+	{
+		m_materialTags.Add(TagID(m_objectMaterials[i].tag), i);
+	}
+
+	if (materialCount > g_MaxMaterials)
+	{
+		std::cout << "Only the first " << g_MaxMaterials << " of " << materialCount
+			<< " materials fit in the material table" << std::endl;
+		materialCount = g_MaxMaterials;
+	}
+
+	for (int i = 0; i < materialCount; i++)
+	{
+		materialTable[i].diffuseColor = glm::vec4(m_objectMaterials[i].diffuseColor, 1.0f);
+		materialTable[i].specularColorShininess = glm::vec4(
+			m_objectMaterials[i].specularColor,
+			m_objectMaterials[i].shininess);
+	}
+
+	if (0 == m_materialBuffer)
+	{
+		glGenBuffers(1, &m_materialBuffer);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(materialTable), materialTable, GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// attach the buffer to the material block of the shaders
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_MaterialBlockBinding, m_materialBuffer);
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->BindUniformBlock(g_MaterialBlockName, g_MaterialBlockBinding);
+	}
+}
+
+
+
+/***********************************************************
+ *  SetupSceneLights()
+ *
+ *  This method is called to add and configure the light
+ *  sources for the 3D scene.
+ ***********************************************************/
+void SceneManager::SetupSceneLights()
+{
+	if (NULL != m_pShaderUniforms)
+	{
+		// this line of code is NEEDED for telling the shaders to render 
+		// the 3D scene with custom lighting - to use the default rendered 
+		// lighting then comment out the following line
+		m_pShaderUniforms->Set(m_uniforms.useLighting, true);
+
+		// directional light to simulate sunlight
+		m_pShaderUniforms->Set(m_uniforms.directionalLightDirection, glm::vec3(20.0f, -1.0f, -15.0f));
+		m_pShaderUniforms->Set(m_uniforms.directionalLightAmbient, glm::vec3(0.2f, 0.2f, 0.2f));
+		m_pShaderUniforms->Set(m_uniforms.directionalLightDiffuse, glm::vec3(0.8f, 0.8f, 0.9f));
+		m_pShaderUniforms->Set(m_uniforms.directionalLightSpecular, glm::vec3(0.1f, 0.1f, 0.1f));
+		m_pShaderUniforms->Set(m_uniforms.directionalLightActive, true);
+	}
+
+	// the point lights are kept in a uniform buffer, so any
+	// number of them is sent to the shaders with one upload
+	LightBuffer::POINT_LIGHT pointLight;
+	pointLight.ambient = glm::vec3(0.05f, 0.05f, 0.05f);
+	pointLight.diffuse = glm::vec3(0.33f, 0.14f, 0.02f);
+	pointLight.specular = glm::vec3(0.1f, 0.1f, 0.1f);
+	pointLight.range = 20.0f;
+
+	m_pointLights.Create(g_MaxPointLights);
+	m_pointLights.ClearLights();
+
+	// a generated city brings its own street lights
+	if (true == m_bGeneratedCity)
+	{
+		for (const glm::vec3& position : m_cityLightPositions)
+		{
+			if (m_pointLights.GetLightCount() >= g_MaxPointLights)
+			{
+				break;
+			}
+			pointLight.position = position;
+			m_pointLights.AddLight(pointLight);
+		}
+	}
+	else
+	{
+		//point light
+		pointLight.position = glm::vec3(12.0f, 1.0f, -4.0f);
+		m_pointLights.AddLight(pointLight);
+
+		//point light
+		pointLight.position = glm::vec3(11.0f, 1.0f, -8.0f);
+		m_pointLights.AddLight(pointLight);
+
+		//point light
+		pointLight.position = glm::vec3(-4.0f, 1.0f, -10.0f);
+		m_pointLights.AddLight(pointLight);
+
+		//point light
+		pointLight.position = glm::vec3(8.5f, 1.0f, -10.0f);
+		m_pointLights.AddLight(pointLight);
+	}
+
+	m_pointLights.Upload();
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.pointLightCount, m_pointLights.GetLightCount());
+	}
+
+	// every lighting path reads the light list through a
+	// texture buffer, so the list is not held to a uniform
+	// block size
+	m_clusteredLighting.Create(m_pShaderUniforms, m_pointLights.GetBufferID());
+	// the per-object light lists index into that light list
+	m_objectLightLists.Create(m_pShaderUniforms);
+}
+
+/***********************************************************
+ *  LoadSceneMeshes()
+ *
+ *  This method is used for packing every basic shape mesh
+ *  into the shared mesh buffer. The meshes are read from the
+ *  mesh pack made by the cook tool when there is one, and
+ *  built otherwise. They are added in MESH_ID order, so each
+ *  mesh ID is also its index in the mesh buffer offset table.
+ ***********************************************************/
+void SceneManager::LoadSceneMeshes()
+{
+	std::vector<MeshGeometry::MESH_DATA> meshes;
+
+	if ((false == CookedAssets::ReadMeshPack(CookedAssets::GetMeshPackFilename().c_str(), meshes)) ||
+		(MESH_COUNT != (int)meshes.size()))
+	{
+		meshes.resize(MESH_COUNT);
+		for (int meshID = 0; meshID < MESH_COUNT; meshID++)
+		{
+			MeshGeometry::BuildShapeMesh(meshID, meshes[meshID]);
+		}
+	}
+
+	for (const MeshGeometry::MESH_DATA& mesh : meshes)
+	{
+		m_meshBuffer.AddMesh(mesh);
+	}
+
+	m_meshBuffer.Upload();
+}
+
+/***********************************************************
+ *  CreateDrawDataStream()
+ *
+ *  This method is used for creating the ring buffer that the
+ *  per-draw values of the indirect draws are written into,
+ *  and the texture buffer the vertex shader reads them from.
+ *  It is created again, with a region per frame as large as
+ *  the passed in number of draws, whenever the draw list
+ *  outgrows it. The buffer it replaces is freed by OpenGL
+ *  once the frames in flight are done reading it.
+ ***********************************************************/
+void SceneManager::CreateDrawDataStream(int drawCount)
+{
+	GLint maxTextureBufferSize = 0;
+	const GLsizeiptr texelsPerDraw = sizeof(IndirectDrawList::DRAW_DATA) / sizeof(glm::vec4);
+
+	// the whole ring must fit in one texture buffer
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferSize);
+	m_maxDrawDataCapacity = (int)(maxTextureBufferSize / (texelsPerDraw * g_FramesInFlight));
+	m_drawDataCapacity = (drawCount < g_MinStreamedDraws) ? g_MinStreamedDraws : drawCount;
+	if (m_drawDataCapacity > m_maxDrawDataCapacity)
+	{
+		m_drawDataCapacity = m_maxDrawDataCapacity;
+	}
+
+	m_drawDataStream.Create(m_drawDataCapacity * sizeof(IndirectDrawList::DRAW_DATA), g_FramesInFlight);
+
+	if (0 == m_drawDataTexture)
+	{
+		glGenTextures(1, &m_drawDataTexture);
+	}
+	glActiveTexture(GL_TEXTURE0 + g_DrawDataTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_drawDataTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_drawDataStream.GetBuffer());
+	glActiveTexture(GL_TEXTURE0);
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->Set(m_uniforms.drawData, g_DrawDataTextureUnit);
+	}
+}
+
+/***********************************************************
+ *  SetIndirectDraw()
+ *
+ *  This method is used for switching the draw list between
+ *  the multi-draw indirect submission and the replay with
+ *  one draw call per object. Indirect drawing stays off when
+ *  the OpenGL context does not support it.
+ ***********************************************************/
+void SceneManager::SetIndirectDraw(bool bEnabled)
+{
+	m_bUseIndirectDraw = bEnabled && IndirectDrawList::IsSupported();
+	m_bIndirectDrawListDirty = true;
+}
+
+/***********************************************************
+ *  SetStaticBake()
+ *
+ *  This method is used for switching between drawing the
+ *  static objects from the merged meshes and drawing every
+ *  object on its own. The draw list is recorded again, so
+ *  the static objects move into or out of the bake.
+ ***********************************************************/
+void SceneManager::SetStaticBake(bool bEnabled)
+{
+	if (m_bUseStaticBake == bEnabled)
+	{
+		return;
+	}
+
+	m_bUseStaticBake = bEnabled;
+	// the houses that are not instanced are recorded instead
+	FillHouseInstances();
+	RecordDrawList();
+}
+
+/***********************************************************
+ *  UpdateLightClusters()
+ *
+ *  This method is used for assigning the point lights to
+ *  the light clusters of the current view. It is called once
+ *  per frame, after the view has been prepared.
+ ***********************************************************/
+void SceneManager::UpdateLightClusters(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane,
+	glm::ivec2 viewportSize)
+{
+	m_clusteredLighting.Update(view, projection, nearPlane, farPlane, viewportSize, m_pointLights);
+}
+
+/***********************************************************
+ *  SetClusteredLighting()
+ *
+ *  This method is used for switching between the clustered
+ *  light lookup and the loop over the whole light list.
+ ***********************************************************/
+void SceneManager::SetClusteredLighting(bool bEnabled)
+{
+	m_clusteredLighting.SetEnabled(bEnabled);
+}
+
+/***********************************************************
+ *  SetObjectLightLists()
+ *
+ *  This method is used for switching between the per-object
+ *  light lists and the loop over the whole light list. The
+ *  light clusters take precedence when both are enabled.
+ ***********************************************************/
+void SceneManager::SetObjectLightLists(bool bEnabled)
+{
+	m_objectLightLists.SetEnabled(bEnabled);
+}
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ ***********************************************************/
+void SceneManager::PrepareScene()
+{
+
+	// load the textures for the 3D scene
+	LoadSceneTextures();
+	// define the materials that will be used for the objects
+	// in the 3D scene
+	DefineObjectMaterials();
+	UploadMaterialBuffer();
+	// add and defile the light sources for the 3D scene
+	SetupSceneLights();
+
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene
+
+	LoadSceneMeshes();
+
+	// the indirect draws read their per-draw values from a
+	// ring buffer written every frame
+	CreateDrawDataStream(g_MinStreamedDraws);
+	SetIndirectDraw(true);
+
+	// place the houses and the landmarks, add their nodes to
+	// the transform hierarchy and fill the instance buffers
+	// that draw the instanced houses with a handful of calls
+	if (true == m_sceneFile.IsOpen())
+	{
+		// the houses of a scene file are plain objects
+		m_housePlacements.clear();
+		m_landmarkPlacements.clear();
+	}
+	else if (false == m_bGeneratedCity)
+	{
+		DefineHousePlacements();
+		DefineLandmarkPlacements();
+	}
+	else if (true == m_bUseWorldStreaming)
+	{
+		// the streamed city is merged chunk by chunk around the
+		// camera, so its placements are not built here
+		PrepareWorldStreaming();
+	}
+	BuildSceneGraph();
+	PrepareHouseInstances();
+
+	// the scene is static, so the draw commands only need
+	// to be recorded once
+	RecordDrawList();
+}
+
+/***********************************************************
+ *  ApplyPassState()
+ *
+ *  This method is used for making the pipeline state of a
+ *  render pass current. In wireframe mode the geometry is
+ *  drawn as lines, whatever the pass asks for.
+ ***********************************************************/
+void SceneManager::ApplyPassState(const PIPELINE_STATE& state)
+{
+	if (NULL == m_pPipelineState)
+	{
+		return;
+	}
+
+	if (true == m_bWireframe)
+	{
+		PIPELINE_STATE wireframeState = state;
+		wireframeState.polygonMode = GL_LINE;
+		m_pPipelineState->Apply(wireframeState);
+	}
+	else
+	{
+		m_pPipelineState->Apply(state);
+	}
+}
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by 
+ *  transforming and drawing the basic 3D shapes
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	m_renderStats = { 0, 0, 0, 0, 0, 0 };
+
+	// bring the objects below the moved nodes up to date
+	UpdateSceneGraph();
+
+	// move on to the ring buffer region of this frame
+	m_drawDataStream.ResetFrameCounters();
+	m_drawDataStream.BeginFrame();
+
+	// the static objects are drawn first from the merged meshes
+	if ((true == m_bUseDrawList) && (true == m_bUseStaticBake))
+	{
+		ApplyPassState(PipelineStateCache::Opaque());
+		RenderStaticBake();
+	}
+
+	// the loaded chunks of a streamed city are merged meshes too
+	if (true == m_worldStreamer.IsStarted())
+	{
+		ApplyPassState(PipelineStateCache::Opaque());
+		RenderStreamedChunks();
+	}
+
+	// every basic shape is drawn out of the shared mesh buffer
+	ApplyPassState(PipelineStateCache::Opaque());
+	m_meshBuffer.Bind();
+
+	if ((true == m_bUseDrawList) && (true == m_bUseIndirectDraw))
+	{
+		SubmitIndirectDrawList();
+	}
+	else if (true == m_bUseDrawList)
+	{
+		ReplayDrawList();
+	}
+	else
+	{
+		// the objects drawn one by one have no light lists
+		if (NULL != m_pShaderUniforms)
+		{
+			m_pShaderUniforms->Set(m_uniforms.objectLightRange, glm::ivec2(0, -1));
+		}
+		SubmitSceneObjects();
+	}
+
+	// the houses that may move are instanced, and with the
+	// static bake the others are part of the merged meshes
+	if (true == m_bUseHouseInstancing)
+	{
+		ApplyPassState(PipelineStateCache::Opaque());
+		RenderHouseInstances();
+	}
+
+	// the region may only be written again once the GPU has
+	// finished the draws of this frame
+	m_drawDataStream.EndFrame();
+}
+
+/***********************************************************
+ *  SubmitSceneObjects()
+ *
+ *  This method is used for drawing the scene objects that
+ *  are not drawn with instancing. While the draw list is
+ *  being recorded, the objects are captured instead.
+ ***********************************************************/
+void SceneManager::SubmitSceneObjects()
+{
+	// a loaded scene file replaces the objects built in code
+	if (true == m_sceneFile.IsOpen())
+	{
+		RecordSceneFileObjects();
+		return;
+	}
+
+	RenderGround(0.0f);
+
+	// the house rotation and position come from the node of
+	// the house, so the parts are placed relative to it and a
+	// rotated house keeps its shape
+	for (int i = 0; i < (int)m_housePlacements.size(); i++)
+	{
+		if (true == IsHouseInstanced(i))
+		{
+			continue;
+		}
+
+		m_transformParent = m_houseNodes[i];
+
+		switch (m_housePlacements[i].variant)
+		{
+		case 2:
+			RenderHouse2(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		case 3:
+			RenderHouse3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		default:
+			RenderHouse(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		}
+	}
+	m_transformParent = -1;
+
+	// the walls and windmills are built below the node of
+	// their placement the same way
+	for (size_t i = 0; i < m_landmarkPlacements.size(); i++)
+	{
+		m_transformParent = m_landmarkNodes[i];
+
+		if (LANDMARK_WINDMILL == m_landmarkPlacements[i].kind)
+		{
+			RenderWindmill();
+		}
+		else
+		{
+			RenderWall();
+		}
+	}
+	m_transformParent = -1;
+}
+
+/***********************************************************
+ *  DefineHousePlacements()
+ *
+ *  This method is used for defining where each house object
+ *  is placed in the 3D scene and which variant is used. The
+ *  houses placed in code may be moved, so they are drawn
+ *  with instancing rather than merged into the static bake.
+ ***********************************************************/
+void SceneManager::DefineHousePlacements()
+{
+	m_housePlacements.clear();
+
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-6.6f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-4.4f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-2.2f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(2.2f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(4.4f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(6.6f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-6.6f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-4.4f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-2.2f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(2.2f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(4.4f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 1, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(6.6f, 0.0f, -3.1f), true });
+	m_housePlacements.push_back({ 2, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(9.0f, 0.0f, -2.8f), true });
+	m_housePlacements.push_back({ 2, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(9.0f, 0.0f, -5.0f), true });
+	m_housePlacements.push_back({ 2, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(9.0f, 0.0f, -7.2f), true });
+	m_housePlacements.push_back({ 3, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-9.0f, 0.0f, -2.8f), true });
+	m_housePlacements.push_back({ 3, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-9.0f, 0.0f, -5.0f), true });
+	m_housePlacements.push_back({ 3, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-9.0f, 0.0f, -7.2f), true });
+}
+
+/***********************************************************
+ *  DefineLandmarkPlacements()
+ *
+ *  This method is used for placing the wall and the windmill
+ *  where they are built in code.
+ ***********************************************************/
+void SceneManager::DefineLandmarkPlacements()
+{
+	m_landmarkPlacements.clear();
+
+	m_landmarkPlacements.push_back({ LANDMARK_WALL, glm::vec3(1.0f), glm::vec3(0.0f), g_WallOrigin });
+	m_landmarkPlacements.push_back({ LANDMARK_WINDMILL, glm::vec3(1.0f), glm::vec3(0.0f), g_WindmillOrigin });
+}
+
+/***********************************************************
+ *  GenerateCity()
+ *
+ *  This method is used for taking the placements of a
+ *  generated city in place of the ones made in code. The
+ *  ground is stretched under the whole city with its texture
+ *  repeated at the same density, and the street lights of
+ *  the city replace the point lights of the scene.
+ ***********************************************************/
+void SceneManager::GenerateCity(const CityGenerator& city)
+{
+	m_housePlacements.clear();
+	m_landmarkPlacements.clear();
+
+	for (const CityGenerator::CITY_PLACEMENT& placement : city.GetPlacements())
+	{
+		switch (placement.kind)
+		{
+		case CityGenerator::PLACE_WINDMILL:
+			m_landmarkPlacements.push_back({
+				LANDMARK_WINDMILL,
+				glm::vec3(g_CityWindmillScale),
+				placement.rotationDegrees,
+				placement.positionXYZ });
+			break;
+		case CityGenerator::PLACE_WALL:
+			m_landmarkPlacements.push_back({
+				LANDMARK_WALL,
+				placement.sizeXYZ / g_WallSize,
+				placement.rotationDegrees,
+				placement.positionXYZ });
+			break;
+		default:
+			// the houses of a city stand still, so they are
+			// merged into the static bake
+			m_housePlacements.push_back({ placement.kind, placement.rotationDegrees, placement.positionXYZ, false });
+			break;
+		}
+	}
+
+	m_cityLightPositions = city.GetLightPositions();
+
+	// the plane mesh spans -1 to 1, so it is scaled by half the
+	// size of the city
+	glm::vec3 cityMin = city.GetMinPoint();
+	glm::vec3 cityMax = city.GetMaxPoint();
+	m_groundScale = glm::vec3(0.5f * (cityMax.x - cityMin.x), 1.0f, 0.5f * (cityMax.z - cityMin.z));
+	m_groundPosition = glm::vec3(0.5f * (cityMin.x + cityMax.x), 0.0f, 0.5f * (cityMin.z + cityMax.z));
+
+	m_bGeneratedCity = true;
+}
+
+/***********************************************************
+ *  PrepareWorldStreaming()
+ *
+ *  This method is used for handing the placements of the
+ *  generated city to the world streamer in place of the
+ *  scene. The parts of each house variant, the windmill and
+ *  the wall are recorded once below no node, so they are
+ *  relative to their placement, and every placement becomes
+ *  an item with the matrix of the nodes BuildSceneGraph()
+ *  would give it. A streamed windmill is merged whole, its
+ *  blades included.
+ ***********************************************************/
+void SceneManager::PrepareWorldStreaming()
+{
+	m_worldStreamer.Clear();
+
+	MeshGeometry::MESH_DATA mesh;
+	for (int meshID = 0; meshID < MESH_COUNT; meshID++)
+	{
+		m_meshBuffer.GetMeshData(meshID, mesh);
+		m_worldStreamer.SetMesh(meshID, mesh);
+	}
+
+	std::vector<DRAW_COMMAND> draws;
+	for (int streamTemplate = 0; streamTemplate < g_StreamTemplates; streamTemplate++)
+	{
+		m_drawList.Clear();
+		ResetRecordedDraw();
+		m_bRecordingDrawList = true;
+		switch (streamTemplate)
+		{
+		case 0:
+			RenderHouse(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		case 1:
+			RenderHouse2(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		case 2:
+			RenderHouse3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		case g_StreamHouseTemplates + LANDMARK_WINDMILL:
+			RenderWindmill();
+			break;
+		default:
+			RenderWall();
+			break;
+		}
+		m_bRecordingDrawList = false;
+
+		int templateIndex = m_worldStreamer.AddTemplate();
+		GetDrawCommands(m_drawList, draws);
+		for (const DRAW_COMMAND& draw : draws)
+		{
+			StaticGeometryBake::BAKE_KEY key;
+			key.textureSlot = draw.textureSlot;
+			key.materialIndex = draw.materialIndex;
+			key.color = draw.color;
+			m_worldStreamer.AddTemplatePart(templateIndex, draw.meshID, draw.model, draw.UVscale, key);
+		}
+	}
+	m_drawList.Clear();
+
+	for (const HOUSE_PLACEMENT& house : m_housePlacements)
+	{
+		int variant = ((2 == house.variant) || (3 == house.variant)) ? house.variant : 1;
+		glm::mat4 model = ComposeTransformations(
+			glm::vec3(1.0f),
+			house.rotationDegrees.x,
+			house.rotationDegrees.y,
+			house.rotationDegrees.z,
+			house.positionXYZ);
+		m_worldStreamer.AddItem(variant - 1, model);
+	}
+
+	for (const LANDMARK_PLACEMENT& landmark : m_landmarkPlacements)
+	{
+		int kind = (LANDMARK_WINDMILL == landmark.kind) ? LANDMARK_WINDMILL : LANDMARK_WALL;
+		glm::vec3 origin = (LANDMARK_WINDMILL == kind) ? g_WindmillOrigin : g_WallOrigin;
+		glm::mat4 model = ComposeTransformations(
+			landmark.scaleXYZ,
+			landmark.rotationDegrees.x,
+			landmark.rotationDegrees.y,
+			landmark.rotationDegrees.z,
+			landmark.positionXYZ) * glm::translate(-origin);
+		m_worldStreamer.AddItem(g_StreamHouseTemplates + kind, model);
+	}
+
+	// the city is only taken out of the scene once the
+	// streamer runs, otherwise it is placed as a whole
+	m_worldStreamer.Start(m_streamSettings);
+	if (true == m_worldStreamer.IsStarted())
+	{
+		m_housePlacements.clear();
+		m_landmarkPlacements.clear();
+	}
+	else
+	{
+		m_worldStreamer.Clear();
+	}
+}
+
+/***********************************************************
+ *  BuildSceneGraph()
+ *
+ *  This method is used for adding a root node for every
+ *  placed house and landmark to the transform hierarchy,
+ *  and then the nodes of the scene file. The parts of a
+ *  house are placed relative to the node of the house, so
+ *  they need no nodes of their own.
+ ***********************************************************/
+void SceneManager::BuildSceneGraph()
+{
+	m_sceneGraph.Clear();
+	m_houseNodes.clear();
+
+	for (const HOUSE_PLACEMENT& house : m_housePlacements)
+	{
+		SceneGraph::TRANSFORM houseTransform = { glm::vec3(1.0f), house.rotationDegrees, house.positionXYZ };
+		m_houseNodes.push_back(m_sceneGraph.AddNode(-1, houseTransform));
+	}
+
+	// a wall or windmill is built where it stands in code, so
+	// a child node first moves it from there to the origin
+	m_landmarkNodes.clear();
+	for (const LANDMARK_PLACEMENT& landmark : m_landmarkPlacements)
+	{
+		glm::vec3 origin = (LANDMARK_WINDMILL == landmark.kind) ? g_WindmillOrigin : g_WallOrigin;
+		SceneGraph::TRANSFORM landmarkTransform = { landmark.scaleXYZ, landmark.rotationDegrees, landmark.positionXYZ };
+		SceneGraph::TRANSFORM originTransform = { glm::vec3(1.0f), glm::vec3(0.0f), -origin };
+		int landmarkNode = m_sceneGraph.AddNode(-1, landmarkTransform);
+		m_landmarkNodes.push_back(m_sceneGraph.AddNode(landmarkNode, originTransform));
+	}
+
+	// the nodes of a scene file follow, in file order, which
+	// already puts every parent in front of its children
+	m_sceneFileNodes.clear();
+	if (true == m_sceneFile.IsOpen())
+	{
+		const SceneFile::SCENE_NODE* pNodes = m_sceneFile.GetNodes();
+		for (int i = 0; i < m_sceneFile.GetNodeCount(); i++)
+		{
+			const SceneFile::SCENE_NODE& node = pNodes[i];
+
+			// a parent behind the node is ignored
+			int parent = ((node.parent >= 0) && (node.parent < i)) ? m_sceneFileNodes[node.parent] : -1;
+			m_sceneFileNodes.push_back(m_sceneGraph.AddNode(parent, GetNodeTransform(node)));
+		}
+	}
+
+	m_sceneGraph.UpdateWorldMatrices(m_workerPool);
+	m_bSceneGraphDirty = false;
+	m_bNodeDrawsDirty = true;
+}
+
+/***********************************************************
+ *  PrepareHouseInstances()
+ *
+ *  This method is used for recording the parts of every
+ *  house variant, the same way the houses that are not
+ *  instanced are recorded, and for sorting the parts into
+ *  instanced batches by mesh, texture and material. The
+ *  color and UV scale of a part go into its instances, so
+ *  they do not split the batches. Every batch gets its
+ *  instanced mesh here, once, and the instanced houses are
+ *  then placed into the instance buffers.
+ ***********************************************************/
+void SceneManager::PrepareHouseInstances()
+{
+	EntityStore partDrawList;
+	std::vector<DRAW_COMMAND> draws;
+	MeshGeometry::MESH_DATA mesh;
+
+	DestroyHouseBatches();
+	m_houseVariantParts.assign(g_HouseVariants, std::vector<HOUSE_PART>());
+
+	for (int variant = 1; variant <= g_HouseVariants; variant++)
+	{
+		// record into a separate list below no node, leaving
+		// the draw list alone
+		m_drawList.Swap(partDrawList);
+		m_transformParent = -1;
+		ResetRecordedDraw();
+		m_bRecordingDrawList = true;
+		switch (variant)
+		{
+		case 2:
+			RenderHouse2(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		case 3:
+			RenderHouse3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		default:
+			RenderHouse(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			break;
+		}
+		m_bRecordingDrawList = false;
+		m_drawList.Swap(partDrawList);
+		GetDrawCommands(partDrawList, draws);
+		partDrawList.Clear();
+
+		for (const DRAW_COMMAND& draw : draws)
+		{
+			int batch = 0;
+			while ((batch < (int)m_houseBatches.size()) &&
+				((m_houseBatches[batch].meshID != draw.meshID) ||
+				(m_houseBatches[batch].textureSlot != draw.textureSlot) ||
+				(m_houseBatches[batch].materialIndex != draw.materialIndex)))
+			{
+				batch++;
+			}
+
+			if (batch == (int)m_houseBatches.size())
+			{
+				HOUSE_BATCH houseBatch;
+				houseBatch.meshID = draw.meshID;
+				houseBatch.textureSlot = draw.textureSlot;
+				houseBatch.materialIndex = draw.materialIndex;
+				houseBatch.pMesh = new InstancedMesh();
+				houseBatch.bounds = m_meshBuffer.GetBounds(draw.meshID);
+				houseBatch.lightRange = glm::ivec2(0, -1);
+
+				m_meshBuffer.GetMeshData(draw.meshID, mesh);
+				houseBatch.pMesh->CreateMesh(mesh);
+				m_houseBatches.push_back(houseBatch);
+			}
+
+			HOUSE_PART part = { batch, draw.model, draw.color, draw.UVscale };
+			m_houseVariantParts[variant - 1].push_back(part);
+		}
+	}
+
+	FillHouseInstances();
+}
+
+/***********************************************************
+ *  IsHouseInstanced()
+ *
+ *  This method is used for telling whether a placed house is
+ *  drawn with instancing. A house that may move is, so it
+ *  stays out of the static bake, and with the static bake
+ *  off every house is.
+ ***********************************************************/
+bool SceneManager::IsHouseInstanced(int house) const
+{
+	if ((false == m_bUseHouseInstancing) || (true == m_houseVariantParts.empty()))
+	{
+		return(false);
+	}
+
+	return((true == m_housePlacements[house].bDynamic) || (false == m_bUseStaticBake));
+}
+
+/***********************************************************
+ *  FillHouseInstances()
+ *
+ *  This method is used for placing the parts of every
+ *  instanced house into the instance buffers of their
+ *  batches. Each part instance is the world matrix of the
+ *  house node times the recorded model matrix of the part,
+ *  and where it lands in its batch is kept, so the parts of
+ *  a moved house can be written back on their own. The box
+ *  around each batch is found here, and its point light
+ *  list when the lights are assigned.
+ ***********************************************************/
+void SceneManager::FillHouseInstances()
+{
+	for (HOUSE_BATCH& batch : m_houseBatches)
+	{
+		batch.instances.clear();
+	}
+	m_houseFirstInstance.assign(m_housePlacements.size(), -1);
+	m_housePartInstances.clear();
+
+	for (int house = 0; house < (int)m_housePlacements.size(); house++)
+	{
+		if (false == IsHouseInstanced(house))
+		{
+			continue;
+		}
+
+		int variant = m_housePlacements[house].variant;
+		variant = ((2 == variant) || (3 == variant)) ? variant : 1;
+		glm::mat4 houseMatrix = m_sceneGraph.GetWorldMatrix(m_houseNodes[house]);
+
+		m_houseFirstInstance[house] = (int)m_housePartInstances.size();
+		for (const HOUSE_PART& part : m_houseVariantParts[variant - 1])
+		{
+			HOUSE_BATCH& batch = m_houseBatches[part.batch];
+			InstancedMesh::INSTANCE_DATA instance;
+			instance.model = houseMatrix * part.localModel;
+			instance.color = part.color;
+			instance.UVscale = part.UVscale;
+
+			MeshGeometry::MESH_BOUNDS instanceBounds;
+			MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(batch.meshID), instance.model, instanceBounds);
+			if (true == batch.instances.empty())
+			{
+				batch.bounds = instanceBounds;
+			}
+			else
+			{
+				MeshGeometry::MergeBounds(batch.bounds, instanceBounds);
+			}
+
+			m_housePartInstances.push_back((int)batch.instances.size());
+			batch.instances.push_back(instance);
+		}
+	}
+
+	for (HOUSE_BATCH& batch : m_houseBatches)
+	{
+		batch.pMesh->SetInstances(batch.instances);
+	}
+}
+
+/***********************************************************
+ *  UpdateHouseInstances()
+ *
+ *  This method is used for writing the parts of the passed
+ *  in houses, whose nodes the last scene graph update
+ *  recomputed, back into the instance buffers. A house that
+ *  is not instanced is moved with the draws of its parts
+ *  instead. Only the run of instances
+ *  between the first and the last moved part of a batch is
+ *  uploaded, and only the batches with a moved part get
+ *  their point light lists found again. The box of a batch
+ *  only grows with the moved parts, so no other instance is
+ *  visited - a looser box only costs a few extra lights.
+ ***********************************************************/
+void SceneManager::UpdateHouseInstances(const std::vector<int>& movedHouses)
+{
+	std::vector<glm::ivec2> movedRuns(m_houseBatches.size(), glm::ivec2(INT_MAX, -1));
+
+	for (int house : movedHouses)
+	{
+		if ((house >= (int)m_houseFirstInstance.size()) || (m_houseFirstInstance[house] < 0))
+		{
+			continue;
+		}
+
+		int variant = m_housePlacements[house].variant;
+		variant = ((2 == variant) || (3 == variant)) ? variant : 1;
+		glm::mat4 houseMatrix = m_sceneGraph.GetWorldMatrix(m_houseNodes[house]);
+
+		const std::vector<HOUSE_PART>& parts = m_houseVariantParts[variant - 1];
+		for (size_t i = 0; i < parts.size(); i++)
+		{
+			HOUSE_BATCH& batch = m_houseBatches[parts[i].batch];
+			int instance = m_housePartInstances[m_houseFirstInstance[house] + i];
+			batch.instances[instance].model = houseMatrix * parts[i].localModel;
+
+			MeshGeometry::MESH_BOUNDS instanceBounds;
+			MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(batch.meshID), batch.instances[instance].model, instanceBounds);
+			MeshGeometry::MergeBounds(batch.bounds, instanceBounds);
+
+			glm::ivec2& movedRun = movedRuns[parts[i].batch];
+			movedRun.x = std::min(movedRun.x, instance);
+			movedRun.y = std::max(movedRun.y, instance);
+		}
+	}
+
+	for (size_t i = 0; i < m_houseBatches.size(); i++)
+	{
+		HOUSE_BATCH& batch = m_houseBatches[i];
+		if (movedRuns[i].y < 0)
+		{
+			continue;
+		}
+
+		batch.pMesh->UpdateInstances(movedRuns[i].x, batch.instances.data() + movedRuns[i].x, movedRuns[i].y - movedRuns[i].x + 1);
+		batch.lightRange = m_objectLightLists.UpdateObject(batch.lightRange, batch.bounds, m_pointLights);
+	}
+}
+
+/***********************************************************
+ *  DestroyHouseBatches()
+ *
+ *  This method is used for freeing the instanced meshes of
+ *  the house batches and forgetting the recorded parts.
+ ***********************************************************/
+void SceneManager::DestroyHouseBatches()
+{
+	for (HOUSE_BATCH& batch : m_houseBatches)
+	{
+		delete batch.pMesh;
+		batch.pMesh = NULL;
+	}
+	m_houseBatches.clear();
+	m_houseVariantParts.clear();
+	m_houseFirstInstance.clear();
+	m_housePartInstances.clear();
+}
+
+/***********************************************************
+ *  CullDrawList()
+ *
+ *  This method is used for finding the draws of the draw
+ *  list whose world space box is in the view frustum. The
+ *  frustum is tested against the object hierarchy, so whole
+ *  branches outside the view are skipped with one test and
+ *  the draws of a branch fully inside it are taken without
+ *  any. The visible draws are then counted per chunk on the
+ *  worker threads, and the visible count of each chunk turns
+ *  into the first packed slot of the chunk, so the draws can
+ *  be written in parallel afterwards.
+ ***********************************************************/
+void SceneManager::CullDrawList()
+{
+	int drawCount = m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>();
+	bool bCull = (true == m_bFrustumCulling) && (true == m_bCullingViewSet);
+
+	m_chunkFirstSlots.assign(WorkerPool::GetChunkCount(drawCount, g_DrawChunkSize), 0);
+	if (true == bCull)
+	{
+		UpdateObjectBVH();
+		m_drawVisible.assign(drawCount, 0);
+		m_objectBVH.QueryFrustum(m_frustumPlanes, m_queryItems);
+		for (int item : m_queryItems)
+		{
+			// the baked draws are culled by their batches
+			if (item < drawCount)
+			{
+				m_drawVisible[item] = 1;
+			}
+		}
+	}
+	else
+	{
+		m_drawVisible.assign(drawCount, 1);
+	}
+
+	m_workerPool.ParallelFor(drawCount, g_DrawChunkSize,
+		[this](int begin, int end)
+		{
+			int visibleCount = 0;
+			for (int slot = begin; slot < end; slot++)
+			{
+				visibleCount += m_drawVisible[slot];
+			}
+
+			m_chunkFirstSlots[begin / g_DrawChunkSize] = visibleCount;
+		});
+
+	// turn the visible count of each chunk into its first slot
+	int firstSlot = 0;
+	for (int& chunkSlot : m_chunkFirstSlots)
+	{
+		int visibleCount = chunkSlot;
+		chunkSlot = firstSlot;
+		firstSlot += visibleCount;
+	}
+
+	m_visibleDrawCount = firstSlot;
+	m_renderStats.drawsCulled = drawCount - firstSlot;
+}
+
+/***********************************************************
+ *  UpdateObjectBVH()
+ *
+ *  This method is used for building the object hierarchy
+ *  again when the draws were added, removed or reordered,
+ *  and otherwise for refitting it to the draws that moved.
+ *  The items are the draws of the draw list, by the slot of
+ *  their transforms, followed by the baked draws, so a pick
+ *  also finds the static objects.
+ ***********************************************************/
+void SceneManager::UpdateObjectBVH()
+{
+	if (false == m_bObjectBVHDirty)
+	{
+		m_objectBVH.Refit();
+		return;
+	}
+	m_bObjectBVHDirty = false;
+
+	int drawCount = m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>();
+	std::vector<MeshGeometry::MESH_BOUNDS> itemBounds(drawCount + m_bakedDraws.size());
+	m_drawList.Each<EntityStore::TRANSFORM_COMPONENT, EntityStore::BOUNDS_COMPONENT>(
+		[&itemBounds](int slot, EntityStore::TRANSFORM_COMPONENT&, EntityStore::BOUNDS_COMPONENT& bounds)
+		{
+			itemBounds[slot] = bounds.worldBounds;
+		});
+	for (size_t i = 0; i < m_bakedDraws.size(); i++)
+	{
+		const DRAW_COMMAND& draw = m_bakedDraws[i];
+		MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(draw.meshID), draw.model, itemBounds[drawCount + i]);
+	}
+
+	m_objectBVH.Build(itemBounds);
+}
+
+/***********************************************************
+ *  PickObject()
+ *
+ *  This method is used for finding the object whose world
+ *  space box the passed in ray enters first, such as the
+ *  object under the center of the view. The boxes are a
+ *  loose fit for turned shapes, so the pick is as coarse as
+ *  the culling.
+ ***********************************************************/
+bool SceneManager::PickObject(glm::vec3 origin, glm::vec3 direction, PICK_RESULT& pick)
+{
+	UpdateObjectBVH();
+
+	float distance = 0.0f;
+	int item = m_objectBVH.Raycast(origin, direction, distance);
+	if (item < 0)
+	{
+		return(false);
+	}
+
+	pick.distance = distance;
+	int drawCount = m_drawList.GetCount<EntityStore::TRANSFORM_COMPONENT>();
+	if (item < drawCount)
+	{
+		EntityStore::ENTITY entity = m_drawList.GetEntity<EntityStore::TRANSFORM_COMPONENT>(item);
+		pick.transformNode = m_drawList.Get<EntityStore::TRANSFORM_COMPONENT>(entity)->transformNode;
+		EntityStore::MESH_REF* pMesh = m_drawList.Get<EntityStore::MESH_REF>(entity);
+		pick.meshID = (NULL != pMesh) ? pMesh->meshID : -1;
+	}
+	else
+	{
+		const DRAW_COMMAND& draw = m_bakedDraws[item - drawCount];
+		pick.transformNode = draw.transformNode;
+		pick.meshID = draw.meshID;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  OpenSceneFile()
+ *
+ *  This method is used for mapping a binary scene file whose
+ *  objects are drawn instead of the objects built in code.
+ *  It must be called before PrepareScene(), and the file
+ *  stays mapped while the scene is in use. A file that is
+ *  going to be rewritten and reloaded is read into memory
+ *  instead, which leaves it free to be written.
+ ***********************************************************/
+bool SceneManager::OpenSceneFile(const char* filename, bool bReadIntoMemory)
+{
+	if (true == bReadIntoMemory)
+	{
+		return(m_sceneFile.Read(filename));
+	}
+
+	return(m_sceneFile.Open(filename));
+}
+
+/***********************************************************
+ *  ReloadSceneFile()
+ *
+ *  This method is used for replacing the open scene file
+ *  with a new version of it, changing only what differs
+ *  between the two. While the nodes keep their parents, the
+ *  moved nodes get their new transforms and the scene graph
+ *  update refreshes the objects below them. The objects are
+ *  matched by their keys: an object of the loaded file that
+ *  is not in the new file is removed and one that is only
+ *  in the new file is added, while every unchanged object
+ *  keeps its entity or its place in the static bake. Nothing
+ *  is loaded again but the file itself.
+ *
+ *  The bake is not merged again: a removed baked object is
+ *  cut out of its merged mesh, and an added static object is
+ *  drawn from the draw list until the bake is rebuilt. Only
+ *  the added objects get new point light lists.
+ *
+ *  When a node was added, removed or given another parent,
+ *  the scene graph and the draw list are built again from
+ *  the new file, which still takes none of the textures or
+ *  meshes to be loaded again.
+ ***********************************************************/
+bool SceneManager::ReloadSceneFile(const char* filename, RELOAD_STATS& stats)
+{
+	stats = { 0, 0, 0, false };
+
+	if (false == m_sceneFile.IsOpen())
+	{
+		return(false);
+	}
+
+	SceneFile sceneFile;
+	if (false == sceneFile.Read(filename))
+	{
+		return(false);
+	}
+
+	const SceneFile::SCENE_NODE* pOldNodes = m_sceneFile.GetNodes();
+	const SceneFile::SCENE_NODE* pNewNodes = sceneFile.GetNodes();
+	int nodeCount = sceneFile.GetNodeCount();
+	bool bSameNodes = (nodeCount == m_sceneFile.GetNodeCount());
+	for (int i = 0; (true == bSameNodes) && (i < nodeCount); i++)
+	{
+		bSameNodes = (pOldNodes[i].parent == pNewNodes[i].parent);
+	}
+
+	if (false == bSameNodes)
+	{
+		stats.objectsRemoved = m_sceneFile.GetObjectCount();
+		stats.objectsAdded = sceneFile.GetObjectCount();
+		stats.bRebuilt = true;
+
+		m_sceneFile.Swap(sceneFile);
+		BuildSceneGraph();
+		RecordDrawList();
+		return(true);
+	}
+
+	// only the moved nodes are recomputed, on the next frame
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if (0 != memcmp(&pOldNodes[i], &pNewNodes[i], sizeof(SceneFile::SCENE_NODE)))
+		{
+			m_sceneGraph.SetLocalTransform(m_sceneFileNodes[i], GetNodeTransform(pNewNodes[i]));
+			stats.nodesMoved++;
+		}
+	}
+	if (stats.nodesMoved > 0)
+	{
+		m_bSceneGraphDirty = true;
+	}
+
+	// the draws of the new file, and how many times each key
+	// is in it without a loaded object to match
+	SCENE_FILE_TAGS tags;
+	ResolveSceneFileTags(sceneFile, tags);
+
+	const SceneFile::SCENE_OBJECT* pObjects = sceneFile.GetObjects();
+	std::vector<DRAW_COMMAND> newDraws;
+	std::unordered_map<uint64_t, int> unmatchedKeys;
+	newDraws.reserve(sceneFile.GetObjectCount());
+	int materialIndex = 0;
+	for (int i = 0; i < sceneFile.GetObjectCount(); i++)
+	{
+		DRAW_COMMAND draw;
+		if (true == MakeSceneFileDraw(pObjects[i], tags, materialIndex, draw))
+		{
+			newDraws.push_back(draw);
+			unmatchedKeys[draw.sourceKey]++;
+		}
+	}
+
+	// the loaded objects whose key is left in the new file are
+	// kept, the others are removed
+	std::vector<EntityStore::ENTITY> removedEntities;
+	m_drawList.Each<EntityStore::SOURCE_REF, EntityStore::LIGHT_LIST_REF>(
+		[this, &unmatchedKeys, &removedEntities](int slot, EntityStore::SOURCE_REF& source, EntityStore::LIGHT_LIST_REF& lights)
+		{
+			std::unordered_map<uint64_t, int>::iterator match = unmatchedKeys.find(source.sourceKey);
+			if ((unmatchedKeys.end() != match) && (match->second > 0))
+			{
+				match->second--;
+			}
+			else
+			{
+				removedEntities.push_back(m_drawList.GetEntity<EntityStore::SOURCE_REF>(slot));
+				m_objectLightLists.RemoveObject(lights.lightRange);
+			}
+		});
+
+	size_t keptCount = 0;
+	for (size_t i = 0; i < m_bakedDraws.size(); i++)
+	{
+		std::unordered_map<uint64_t, int>::iterator match = unmatchedKeys.find(m_bakedDraws[i].sourceKey);
+		if ((unmatchedKeys.end() != match) && (match->second > 0))
+		{
+			match->second--;
+			m_bakedDraws[keptCount] = m_bakedDraws[i];
+			m_bakedObjects[keptCount] = m_bakedObjects[i];
+			keptCount++;
+		}
+		else
+		{
+			m_staticBake.RemoveObject(m_bakedObjects[i]);
+		}
+	}
+	stats.objectsRemoved = (int)(removedEntities.size() + (m_bakedDraws.size() - keptCount));
+	m_bakedDraws.resize(keptCount);
+	m_bakedObjects.resize(keptCount);
+	m_drawList.DestroyEntities(removedEntities);
+
+	// the keys left unmatched are the added objects, which go
+	// where the recording would have put them
+	for (const DRAW_COMMAND& draw : newDraws)
+	{
+		int& unmatchedCount = unmatchedKeys[draw.sourceKey];
+		if (unmatchedCount <= 0)
+		{
+			continue;
+		}
+		unmatchedCount--;
+		stats.objectsAdded++;
+
+		DRAW_COMMAND addedDraw = draw;
+		if ((true == m_bUseStaticBake) && (false == draw.bDynamic))
+		{
+			// the draw list holds it until the next bake
+			addedDraw.bDynamic = true;
+		}
+
+		MeshGeometry::MESH_BOUNDS bounds;
+		MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(addedDraw.meshID), addedDraw.model, bounds);
+		addedDraw.lightRange = m_objectLightLists.AddObject(bounds, m_pointLights);
+		AddDrawEntity(m_drawList, addedDraw);
+	}
+
+	// the new file is kept, the loaded one is closed on return
+	m_sceneFile.Swap(sceneFile);
+
+	if ((stats.objectsAdded > 0) || (stats.objectsRemoved > 0))
+	{
+		m_bDrawListDirty = true;
+		m_bObjectBVHDirty = true;
+		m_bNodeDrawsDirty = true;
+		UploadObjectLights();
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ExportSceneFile()
+ *
+ *  This method is used for writing every object of the
+ *  scene into a binary scene file. The objects are recorded
+ *  again with the houses drawn part by part, together with
+ *  the transform nodes they hang below and the tags of
+ *  their textures and materials.
+ ***********************************************************/
+bool SceneManager::ExportSceneFile(const char* filename)
+{
+	EntityStore sceneDrawList;
+	std::vector<DRAW_COMMAND> sceneDraws;
+	bool bUseHouseInstancing = m_bUseHouseInstancing;
+
+	// record into a separate list, leaving the draw list alone
+	m_drawList.Swap(sceneDrawList);
+	m_bUseHouseInstancing = false;
+	ResetRecordedDraw();
+	m_bRecordingDrawList = true;
+	SubmitSceneObjects();
+	m_bRecordingDrawList = false;
+	m_bUseHouseInstancing = bUseHouseInstancing;
+	m_drawList.Swap(sceneDrawList);
+	GetDrawCommands(sceneDrawList, sceneDraws);
+
+	// keep the nodes the objects hang below and their parents,
+	// in graph order so every parent stays in front
+	std::vector<int> fileNodes(m_sceneGraph.GetNodeCount(), -1);
+	for (const DRAW_COMMAND& draw : sceneDraws)
+	{
+		for (int node = draw.transformNode; (node >= 0) && (fileNodes[node] < 0); node = m_sceneGraph.GetParent(node))
+		{
+			fileNodes[node] = 0;
+		}
+	}
+
+	std::vector<SceneFile::SCENE_NODE> nodes;
+	for (int node = 0; node < m_sceneGraph.GetNodeCount(); node++)
+	{
+		if (fileNodes[node] < 0)
+		{
+			continue;
+		}
+
+		const SceneGraph::TRANSFORM& local = m_sceneGraph.GetLocalTransform(node);
+		int parent = m_sceneGraph.GetParent(node);
+		SceneFile::SCENE_NODE fileNode = {};
+		for (int i = 0; i < 3; i++)
+		{
+			fileNode.scaleXYZ[i] = local.scaleXYZ[i];
+			fileNode.rotationDegrees[i] = local.rotationDegrees[i];
+			fileNode.positionXYZ[i] = local.positionXYZ[i];
+		}
+		fileNode.parent = (parent >= 0) ? fileNodes[parent] : -1;
+
+		fileNodes[node] = (int)nodes.size();
+		nodes.push_back(fileNode);
+	}
+
+	// the tags are shared by the textures and the materials
+	std::vector<std::string> tagNames;
+	auto findTag = [&tagNames](const std::string& name)
+	{
+		for (int tag = 0; tag < (int)tagNames.size(); tag++)
+		{
+			if (tagNames[tag] == name)
+			{
+				return(tag);
+			}
+		}
+		tagNames.push_back(name);
+		return((int)tagNames.size() - 1);
+	};
+
+	// every draw was recorded with its resolved material, so
+	// the file stores it, rather than inheriting it on load
+	std::vector<SceneFile::SCENE_OBJECT> objects;
+	objects.reserve(sceneDraws.size());
+	for (const DRAW_COMMAND& draw : sceneDraws)
+	{
+		SceneFile::SCENE_OBJECT object = {};
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 3; row++)
+			{
+				object.localModel[column][row] = draw.localModel[column][row];
+			}
+		}
+		for (int i = 0; i < 4; i++)
+		{
+			object.color[i] = draw.color[i];
+		}
+		object.UVscale[0] = draw.UVscale.x;
+		object.UVscale[1] = draw.UVscale.y;
+		object.node = (draw.transformNode >= 0) ? fileNodes[draw.transformNode] : -1;
+		object.meshID = (uint32_t)draw.meshID;
+		object.materialTag = (draw.materialIndex >= 0) ? findTag(m_objectMaterials[draw.materialIndex].tag) : -1;
+		object.textureTag = (draw.textureSlot >= 0) ? findTag(m_textures.GetTag(draw.textureSlot)) : -1;
+		object.flags = (true == draw.bDynamic) ? SceneFile::OBJECT_DYNAMIC : 0;
+
+		objects.push_back(object);
+	}
+
+	std::vector<SceneFile::SCENE_TAG> tags(tagNames.size());
+	for (size_t tag = 0; tag < tagNames.size(); tag++)
+	{
+		memset(tags[tag].name, 0, sizeof(tags[tag].name));
+		tagNames[tag].copy(tags[tag].name, sizeof(tags[tag].name) - 1);
+	}
+
+	return(SceneFile::Write(filename, nodes, objects, tags));
+}
+
+/***********************************************************
+ *  SetWorkerThreads()
+ *
+ *  This method is used for starting the worker threads that
+ *  share the per-frame draw list work with the GL thread.
+ *  Only the GL calls stay on the GL thread.
+ ***********************************************************/
+void SceneManager::SetWorkerThreads(int threadCount)
+{
+	m_workerPool.Start(threadCount);
+}
+
+/***********************************************************
+ *  SetWorldStreaming()
+ *
+ *  This method is used for loading a generated city in
+ *  chunks around the camera instead of placing all of it.
+ ***********************************************************/
+void SceneManager::SetWorldStreaming(bool bEnabled, const WorldStreamer::STREAM_SETTINGS& settings)
+{
+	m_bUseWorldStreaming = bEnabled;
+	m_streamSettings = settings;
+}
+
+/***********************************************************
+ *  UpdateWorldStreaming()
+ *
+ *  This method is used for loading and unloading the chunks
+ *  around the camera. The point light lists cover the
+ *  merged meshes of the loaded chunks, so they are found
+ *  again whenever those change.
+ ***********************************************************/
+void SceneManager::UpdateWorldStreaming(glm::vec3 cameraPosition)
+{
+	if (true == m_worldStreamer.Update(cameraPosition))
+	{
+		AssignObjectLights();
+	}
+}
+
+/***********************************************************
+ *  SetCullingView()
+ *
+ *  This method is used for passing in the view and
+ *  projection of the next frame, from which the frustum
+ *  planes of the culling are taken.
+ ***********************************************************/
+void SceneManager::SetCullingView(const glm::mat4& view, const glm::mat4& projection)
+{
+	MeshGeometry::ExtractFrustumPlanes(projection * view, m_frustumPlanes);
+	m_bCullingViewSet = true;
+}
+
+/***********************************************************
+ *  SetHouseTransform()
+ *
+ *  This method is used for moving and rotating a placed
+ *  house. Only the node of the house is changed here, its
+ *  subtree is recomputed before the next frame is drawn.
+ ***********************************************************/
+void SceneManager::SetHouseTransform(int house, glm::vec3 rotationDegrees, glm::vec3 positionXYZ)
+{
+	if ((house < 0) || (house >= (int)m_houseNodes.size()))
+	{
+		return;
+	}
+
+	m_housePlacements[house].rotationDegrees = rotationDegrees;
+	m_housePlacements[house].positionXYZ = positionXYZ;
+
+	SceneGraph::TRANSFORM houseTransform = { glm::vec3(1.0f), rotationDegrees, positionXYZ };
+	m_sceneGraph.SetLocalTransform(m_houseNodes[house], houseTransform);
+	m_bSceneGraphDirty = true;
+}
+
+/***********************************************************
+ *  GetHouseTransform()
+ *
+ *  This method is used for getting the rotation and position
+ *  of a placed house, so it can be moved from where it is.
+ ***********************************************************/
+bool SceneManager::GetHouseTransform(int house, glm::vec3& rotationDegrees, glm::vec3& positionXYZ) const
+{
+	if ((house < 0) || (house >= (int)m_houseNodes.size()))
+	{
+		return(false);
+	}
+
+	rotationDegrees = m_housePlacements[house].rotationDegrees;
+	positionXYZ = m_housePlacements[house].positionXYZ;
+
+	return(true);
+}
+
+/***********************************************************
+ *  IndexNodeDraws()
+ *
+ *  This method is used for listing the draws of the draw
+ *  list and the baked draws by the scene graph node they
+ *  hang below, together with the house of every house node,
+ *  so a scene graph update only visits what hangs below the
+ *  recomputed nodes. The lists are built again after the
+ *  draws are added, removed or rebuilt - the draw list keeps
+ *  its entities when it is sorted.
+ ***********************************************************/
+void SceneManager::IndexNodeDraws()
+{
+	int nodeCount = m_sceneGraph.GetNodeCount();
+
+	// count the draws of every node, and turn the counts into
+	// the first entry of every node
+	m_nodeFirstDraws.assign(nodeCount + 1, 0);
+	m_drawList.Each<EntityStore::TRANSFORM_COMPONENT>(
+		[this](int, EntityStore::TRANSFORM_COMPONENT& transform)
+		{
+			if (transform.transformNode >= 0)
+			{
+				m_nodeFirstDraws[transform.transformNode + 1]++;
+			}
+		});
+	for (int node = 0; node < nodeCount; node++)
+	{
+		m_nodeFirstDraws[node + 1] += m_nodeFirstDraws[node];
+	}
+	m_nodeDrawEntities.resize(m_nodeFirstDraws[nodeCount]);
+	std::vector<int> nextDraws(m_nodeFirstDraws.begin(), m_nodeFirstDraws.end() - 1);
+	m_drawList.Each<EntityStore::TRANSFORM_COMPONENT>(
+		[this, &nextDraws](int slot, EntityStore::TRANSFORM_COMPONENT& transform)
+		{
+			if (transform.transformNode >= 0)
+			{
+				m_nodeDrawEntities[nextDraws[transform.transformNode]++] = m_drawList.GetEntity<EntityStore::TRANSFORM_COMPONENT>(slot);
+			}
+		});
+
+	// the same for the baked draws, by their index
+	m_nodeFirstBakedDraws.assign(nodeCount + 1, 0);
+	for (const DRAW_COMMAND& draw : m_bakedDraws)
+	{
+		if (draw.transformNode >= 0)
+		{
+			m_nodeFirstBakedDraws[draw.transformNode + 1]++;
+		}
+	}
+	for (int node = 0; node < nodeCount; node++)
+	{
+		m_nodeFirstBakedDraws[node + 1] += m_nodeFirstBakedDraws[node];
+	}
+	m_nodeBakedDraws.resize(m_nodeFirstBakedDraws[nodeCount]);
+	nextDraws.assign(m_nodeFirstBakedDraws.begin(), m_nodeFirstBakedDraws.end() - 1);
+	for (int i = 0; i < (int)m_bakedDraws.size(); i++)
+	{
+		if (m_bakedDraws[i].transformNode >= 0)
+		{
+			m_nodeBakedDraws[nextDraws[m_bakedDraws[i].transformNode]++] = i;
+		}
+	}
+
+	m_nodeHouses.assign(nodeCount, -1);
+	for (int house = 0; house < (int)m_houseNodes.size(); house++)
+	{
+		m_nodeHouses[m_houseNodes[house]] = house;
+	}
+
+	m_bNodeDrawsDirty = false;
+}
+
+/***********************************************************
+ *  UpdateSceneGraph()
+ *
+ *  This method is used for recomputing the world matrices of
+ *  the moved nodes, and for refreshing only the objects that
+ *  hang below them - the recorded draws and the house
+ *  instances, whose point light lists are found again on
+ *  their own. The objects are found through the runs of
+ *  nodes the update recomputed, so moving one subtree only
+ *  visits that subtree and the draws below it. A baked draw
+ *  below a moved node is taken out of the merged meshes and
+ *  drawn from the draw list from then on, so the bake is
+ *  never merged again here.
+ ***********************************************************/
+void SceneManager::UpdateSceneGraph()
+{
+	if (false == m_bSceneGraphDirty)
+	{
+		return;
+	}
+	m_bSceneGraphDirty = false;
+
+	m_renderStats.transformsUpdated = m_sceneGraph.UpdateWorldMatrices(m_workerPool);
+	if (true == m_bNodeDrawsDirty)
+	{
+		IndexNodeDraws();
+	}
+
+	// gather what hangs below the recomputed nodes
+	std::vector<int> movedBakedDraws;
+	std::vector<int> movedHouses;
+	m_movedEntities.clear();
+	for (const glm::ivec2& range : m_sceneGraph.GetUpdatedRanges())
+	{
+		for (int position = range.x; position < range.y; position++)
+		{
+			int node = m_sceneGraph.GetOrderedNode(position);
+
+			m_movedEntities.insert(m_movedEntities.end(),
+				m_nodeDrawEntities.begin() + m_nodeFirstDraws[node],
+				m_nodeDrawEntities.begin() + m_nodeFirstDraws[node + 1]);
+			movedBakedDraws.insert(movedBakedDraws.end(),
+				m_nodeBakedDraws.begin() + m_nodeFirstBakedDraws[node],
+				m_nodeBakedDraws.begin() + m_nodeFirstBakedDraws[node + 1]);
+			if (m_nodeHouses[node] >= 0)
+			{
+				movedHouses.push_back(m_nodeHouses[node]);
+			}
+		}
+	}
+
+	m_workerPool.ParallelFor((int)m_movedEntities.size(), g_DrawChunkSize,
+		[this](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				EntityStore::ENTITY entity = m_movedEntities[i];
+				EntityStore::TRANSFORM_COMPONENT* pTransform = m_drawList.Get<EntityStore::TRANSFORM_COMPONENT>(entity);
+				EntityStore::MESH_REF* pMesh = m_drawList.Get<EntityStore::MESH_REF>(entity);
+				EntityStore::BOUNDS_COMPONENT* pBounds = m_drawList.Get<EntityStore::BOUNDS_COMPONENT>(entity);
+
+				pTransform->model = m_sceneGraph.GetWorldMatrix(pTransform->transformNode) * pTransform->localModel;
+				MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(pMesh->meshID), pTransform->model, pBounds->worldBounds);
+			}
+		});
+
+	// the moved boxes are passed on to the object hierarchy,
+	// unless it is going to be built again anyway, and only
+	// the moved draws get new light lists
+	bool bRefit = (false == m_bObjectBVHDirty);
+	for (EntityStore::ENTITY entity : m_movedEntities)
+	{
+		EntityStore::BOUNDS_COMPONENT* pBounds = m_drawList.Get<EntityStore::BOUNDS_COMPONENT>(entity);
+		EntityStore::LIGHT_LIST_REF* pLights = m_drawList.Get<EntityStore::LIGHT_LIST_REF>(entity);
+
+		if (true == bRefit)
+		{
+			m_objectBVH.SetItemBounds(m_drawList.GetSlot<EntityStore::TRANSFORM_COMPONENT>(entity), pBounds->worldBounds);
+		}
+		pLights->lightRange = m_objectLightLists.UpdateObject(pLights->lightRange, pBounds->worldBounds, m_pointLights);
+	}
+
+	if (false == movedBakedDraws.empty())
+	{
+		for (int bakedDraw : movedBakedDraws)
+		{
+			// the draw keeps its resolved material in the draw list
+			DRAW_COMMAND draw = m_bakedDraws[bakedDraw];
+			m_staticBake.RemoveObject(m_bakedObjects[bakedDraw]);
+			m_bakedObjects[bakedDraw] = -1;
+			draw.model = m_sceneGraph.GetWorldMatrix(draw.transformNode) * draw.localModel;
+			draw.bDynamic = true;
+
+			MeshGeometry::MESH_BOUNDS bounds;
+			MeshGeometry::TransformBounds(m_meshBuffer.GetBounds(draw.meshID), draw.model, bounds);
+			draw.lightRange = m_objectLightLists.AddObject(bounds, m_pointLights);
+			AddDrawEntity(m_drawList, draw);
+		}
+
+		// a baked draw only ever moves out once, so the baked
+		// draws are only packed when one does
+		size_t keptCount = 0;
+		for (size_t i = 0; i < m_bakedDraws.size(); i++)
+		{
+			if (m_bakedObjects[i] >= 0)
+			{
+				m_bakedDraws[keptCount] = m_bakedDraws[i];
+				m_bakedObjects[keptCount] = m_bakedObjects[i];
+				keptCount++;
+			}
+		}
+		m_bakedDraws.resize(keptCount);
+		m_bakedObjects.resize(keptCount);
+		m_bDrawListDirty = true;
+		m_bObjectBVHDirty = true;
+		m_bNodeDrawsDirty = true;
+	}
+
+	UpdateHouseInstances(movedHouses);
+
+	UploadObjectLights();
+}
+
+/***********************************************************
+ *  RenderHouseInstances()
+ *
+ *  This method is used for drawing every instanced house.
+ *  Each batch is drawn with one instanced draw call, no
+ *  matter how many houses are instanced.
+ ***********************************************************/
+void SceneManager::RenderHouseInstances()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	m_pShaderUniforms->Set(m_uniforms.useInstancing, true);
+
+	for (const HOUSE_BATCH& batch : m_houseBatches)
+	{
+		if (true == batch.instances.empty())
+		{
+			continue;
+		}
+
+		// the instance color and UV scale come from the instance
+		// buffer, only the texture and material are set here
+		m_pShaderUniforms->Set(m_uniforms.textureLayer, m_textures.GetLayerRef(batch.textureSlot));
+		m_pShaderUniforms->Set(m_uniforms.materialIndex, batch.materialIndex);
+		m_pShaderUniforms->Set(m_uniforms.objectLightRange, batch.lightRange);
+
+		batch.pMesh->Draw();
+		m_renderStats.drawCalls++;
+	}
+
+	m_pShaderUniforms->Set(m_uniforms.useInstancing, false);
+}
+
+/***********************************************************
+ *  RenderGround()
+ *
+ *  This method is called to render the shapes for the Ground oject.
+ ***********************************************************/
+void SceneManager::RenderGround(float Xrotation)
+{
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = m_groundScale;
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = Xrotation;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = m_groundPosition;
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	//SetShaderColor(0.18, 0.34, 0.22, 1.0);
+	SetShaderTexture("Grass");
+	// the texture repeats at the same density on a larger ground
+	SetTextureUVScale(
+		g_GroundUVScale.x * m_groundScale.x / g_GroundScale.x,
+		g_GroundUVScale.y * m_groundScale.z / g_GroundScale.z);
+	SetShaderMaterial("grass");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PLANE);
+	/****************************************************************/
+}
+
+/***********************************************************
+ *  RenderHouse1()
+ *
+ *  This method is called to render the shapes for the House object.
+ * 
+ *  This is the house that is facing toward the camera.
+ ***********************************************************/
+void SceneManager::RenderHouse(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
+{
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+
+	/*** Render Building											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 90.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	SetShaderColor(0.91, 0.85, 0.71, 1.0);
+	SetShaderTexture("Brick");
+	SetTextureUVScale(4.0, 4.0);
+	SetShaderMaterial("stone");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Roof												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = -90.0f + Xrot;
+	YrotationDegrees = 90.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
+	SetShaderTexture("Roof");
+	SetTextureUVScale(1.25, 2.25);
+	SetShaderMaterial("roof");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PRISM);
+	/****************************************************************/
+
+	/*** Render Door												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 0.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f + Xpos, 0.25f + Ypos, 0.39f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	// set the color for the next draw command
+	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+	SetShaderTexture("Wood");
+	SetTextureUVScale(1.5, 2.0);
+	SetShaderMaterial("wood");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Window												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 0.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-0.5f + Xpos, 0.625f + Ypos, 0.39f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.41, 0.83, 0.85, 1.0);
+	SetShaderMaterial("glass");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+		// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Window2												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 0.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.5f + Xpos, 0.625f + Ypos, 0.39f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.41, 0.83, 0.85, 1.0);
+	SetShaderMaterial("glass");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+	}
+
+/***********************************************************
+ *  RenderHouse2()
+ *
+ *  This method is called to render the shapes for the House object.
+ * 
+ *   This is the house that is facing to the left of the camera.
+ ***********************************************************/
+void SceneManager::RenderHouse2(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
+{
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+
+	/*** Render Building											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 0.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	SetShaderColor(0.91, 0.85, 0.71, 1.0);
+	SetShaderTexture("Brick");
+	SetTextureUVScale(4.0, 4.0);
+	SetShaderMaterial("stone");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Roof												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = -90.0f + Xrot;
+	YrotationDegrees = 0.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
+	SetShaderTexture("Roof");
+	SetTextureUVScale(1.25, 2.25);
+	SetShaderMaterial("roof");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PRISM);
+	/****************************************************************/
+
+	/*** Render Door												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 90.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-0.39f + Xpos, 0.25f + Ypos, 0.0f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	// set the color for the next draw command
+	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+	SetShaderTexture("Wood");
+	SetTextureUVScale(1.5, 2.0);
+	SetShaderMaterial("wood");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Window												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 90.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-0.39f + Xpos, 0.625f + Ypos, 0.5f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.41, 0.83, 0.85, 1.0);
+	SetShaderMaterial("glass");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+		// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Window2												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f + Xrot;
+	YrotationDegrees = 90.0f + Yrot;
+	ZrotationDegrees = 0.0f + Zrot;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-0.39f + Xpos, 0.625f + Ypos, -0.5f + Zpos);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.41, 0.83, 0.85, 1.0);
+	SetShaderMaterial("glass");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+	}
+
+
+	/***********************************************************
+ *  RenderHouse3()
+ *
+ *  This method is called to render the shapes for the House object.
+ *
+ *   This is the house that is facing to the right of the camera.
+ ***********************************************************/
+	void SceneManager::RenderHouse3(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos)
+	{
+		// declare the variables for the transformations
+		glm::vec3 scaleXYZ;
+		float XrotationDegrees = 0.0f;
+		float YrotationDegrees = 0.0f;
+		float ZrotationDegrees = 0.0f;
+		glm::vec3 positionXYZ;
+
+
+		/*** Render Building											***/
+		/*** Set needed transformations before drawing the basic mesh.  ***/
+		/*** This same ordering of code should be used for transforming ***/
+		/*** and drawing all the basic 3D shapes.						***/
+		/******************************************************************/
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(1.0f, 1.0f, 2.0f);
+
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = 0.0f + Xrot;
+		YrotationDegrees = 0.0f + Yrot;
+		ZrotationDegrees = 0.0f + Zrot;
+
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.0f + Xpos, 0.5f + Ypos, 0.0f + Zpos);
+
+		// set the transformations into memory to be used on the drawn meshes
+		SetTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ);
+
+		// set the color for the next draw command
+		SetShaderColor(0.91, 0.85, 0.71, 1.0);
+		SetShaderTexture("Brick");
+		SetTextureUVScale(4.0, 4.0);
+		SetShaderMaterial("stone");
+		// draw the mesh with transformation values
+		DrawMesh(MESH_BOX);
+		/****************************************************************/
+
+		/*** Render Roof												***/
+		/*** Set needed transformations before drawing the basic mesh.  ***/
+		/*** This same ordering of code should be used for transforming ***/
+		/*** and drawing all the basic 3D shapes.						***/
+		/******************************************************************/
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(1.0f, 2.05f, 1.0f);
+
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = -90.0f + Xrot;
+		YrotationDegrees = 0.0f + Yrot;
+		ZrotationDegrees = 0.0f + Zrot;
+
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.0f + Xpos, 1.5f + Ypos, 0.0f + Zpos);
+
+		// set the transformations into memory to be used on the drawn meshes
+		SetTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ);
+
+		// set the color for the next draw command
+		//SetShaderColor(0.36, 0.16, 0.11, 1.0);
+		SetShaderTexture("Roof");
+		SetTextureUVScale(1.25, 2.25);
+		SetShaderMaterial("roof");
+		// draw the mesh with transformation values
+		DrawMesh(MESH_PRISM);
+		/****************************************************************/
+
+		/*** Render Door												***/
+		/*** Set needed transformations before drawing the basic mesh.  ***/
+		/*** This same ordering of code should be used for transforming ***/
+		/*** and drawing all the basic 3D shapes.						***/
+		/******************************************************************/
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
+
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = 0.0f + Xrot;
+		YrotationDegrees = 90.0f + Yrot;
+		ZrotationDegrees = 0.0f + Zrot;
+
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.39f + Xpos, 0.25f + Ypos, 0.0f + Zpos);
+
+		// set the transformations into memory to be used on the drawn meshes
+		SetTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ);
+
+
+		// set the color for the next draw command
+		//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+		SetShaderTexture("Wood");
+		SetTextureUVScale(1.5, 2.0);
+		SetShaderMaterial("wood");
+		// draw the mesh with transformation values
+		DrawMesh(MESH_BOX);
+		/****************************************************************/
+
+		/*** Render Window												***/
+		/*** Set needed transformations before drawing the basic mesh.  ***/
+		/*** This same ordering of code should be used for transforming ***/
+		/*** and drawing all the basic 3D shapes.						***/
+		/******************************************************************/
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = 0.0f + Xrot;
+		YrotationDegrees = 90.0f + Yrot;
+		ZrotationDegrees = 0.0f + Zrot;
+
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.39f + Xpos, 0.625f + Ypos, -0.5f + Zpos);
+
+		// set the transformations into memory to be used on the drawn meshes
+		SetTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ);
+
+		SetShaderColor(0.41, 0.83, 0.85, 1.0);
+		SetShaderMaterial("glass");
+		// draw the mesh with transformation values
+		DrawMesh(MESH_BOX);
+		/****************************************************************/
+
+			// draw the mesh with transformation values
+		DrawMesh(MESH_BOX);
+		/****************************************************************/
+
+		/*** Render Window2												***/
+		/*** Set needed transformations before drawing the basic mesh.  ***/
+		/*** This same ordering of code should be used for transforming ***/
+		/*** and drawing all the basic 3D shapes.						***/
+		/******************************************************************/
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(0.375f, 0.375f, 0.25f);
+
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = 0.0f + Xrot;
+		YrotationDegrees = 90.0f + Yrot;
+		ZrotationDegrees = 0.0f + Zrot;
+
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.39f + Xpos, 0.625f + Ypos, 0.5f + Zpos);
+
+		// set the transformations into memory to be used on the drawn meshes
+		SetTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ);
+
+		SetShaderColor(0.41, 0.83, 0.85, 1.0);
+		SetShaderMaterial("glass");
+		// draw the mesh with transformation values
+		DrawMesh(MESH_BOX);
+		/****************************************************************/
+	}
+
+/***********************************************************
+ *  RenderWindmill()
+ *
+ *  This method is called to render the shapes for the House object.
+ * 
+ *  This is the windmill facing left of the camera
+ ***********************************************************/
+void SceneManager::RenderWindmill()
+{
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+
+	/*** Render Building											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 4.0f, 1.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(12.0f, 0.0f, -4.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	SetShaderColor(0.91, 0.85, 0.71, 1.0);
+	SetShaderTexture("Brick");
+	SetTextureUVScale(4.0, 4.0);
+	SetShaderMaterial("stone");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CYLINDER);
+
+	/*** Render Roof											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(1.0f, 2.0f, 1.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(12.0f, 4.0f, -4.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	//SetShaderColor(0.36, 0.16, 0.11, 1.0);
+	SetShaderTexture("Roof");
+	SetTextureUVScale(2.0, 2.0);
+	SetShaderMaterial("roof");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+
+	/*** Render Pole											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.10f, 1.0f, 0.10f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 45.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 90.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(11.35f, 3.0f, -3.35f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// set the color for the next draw command
+	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+	SetShaderTexture("Wood");
+	SetTextureUVScale(1.5, 2.0);
+	SetShaderMaterial("wood");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CYLINDER);
+
+	/*** Render Door												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.25f, 0.50f, 0.25f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 45.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(11.38f, 0.25f, -3.38f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	// the blades are kept out of the static bake so they
+	// can be turned
+	SetObjectDynamic(true);
+
+	/*** Render Blade1												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.05f, 3.0f, 0.35f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 45.0f;
+	YrotationDegrees = 45.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(10.75f, 3.0f, -2.75f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	// set the color for the next draw command
+	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+	SetShaderTexture("Wood");
+	SetTextureUVScale(3.0, 6.0);
+	SetShaderMaterial("wood");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render Blade2												***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.05f, 3.0f, 0.35f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = -45.0f;
+	YrotationDegrees = 45.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(10.75f, 3.0f, -2.75f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	// set the color for the next draw command
+	//SetShaderColor(0.32, 0.10, 0.02, 1.0);
+	SetShaderTexture("Wood");
+	SetTextureUVScale(3.0, 6.0);
+	SetShaderMaterial("wood");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	SetObjectDynamic(false);
+	/****************************************************************/
+}
+
+/***********************************************************
+*  RenderWall()
+*
+*  This method is called to render the shapes for the Wall object.
+***********************************************************/
+void SceneManager::RenderWall()
+{
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+	/*** Render WallBase											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(100.0f, 20.0f, 5.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render WallBump											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render WallBump											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(25.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render WallBump											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(50.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render WallBump											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-25.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	/*** Render WallBump											***/
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 22.0f, 10.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-50.0f, 10.0f, -28.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(0.6, 0.6, 0.6, 1.0);
+	SetShaderMaterial("cement");
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
 }
\ No newline at end of file
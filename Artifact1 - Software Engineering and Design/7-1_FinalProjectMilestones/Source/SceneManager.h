@@ -1,119 +1,614 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.h
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
-
-#include <string>
-#include <vector>
-
-/***********************************************************
- *  SceneManager
- *
- *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
- ***********************************************************/
-class SceneManager
-{
-public:
-	// constructor
-	SceneManager(ShaderManager *pShaderManager);
-	// destructor
-	~SceneManager();
-
-	struct TEXTURE_INFO
-	{
-		std::string tag;
-		uint32_t ID;
-	};
-
-	struct OBJECT_MATERIAL
-	{
-		glm::vec3 diffuseColor;
-		glm::vec3 specularColor;
-		float shininess;
-		std::string tag;
-	};
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
-	std::vector<OBJECT_MATERIAL> m_objectMaterials;
-
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
-	void BindGLTextures();
-	// free the loaded OpenGL textures
-	void DestroyGLTextures();
-	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
-	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
-
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
-		glm::vec3 scaleXYZ,
-		float XrotationDegrees,
-		float YrotationDegrees,
-		float ZrotationDegrees,
-		glm::vec3 positionXYZ,
-		glm::vec3 offset = glm::vec3(0.0f, 0.0f, 0.0f));
-
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
-
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-public:
-
-	// The following methods are for the students to 
-	// customize for their own 3D scene
-	void PrepareScene();
-	void RenderScene();
-
-	// loads textures from image files
-	void LoadSceneTextures();
-	// define all the object materials before rendering
-	void DefineObjectMaterials();
-	// add and define the light sources before rendering
-	void SetupSceneLights();
-
-	void RenderGround(float Xrotation);
-	void RenderHouse(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
-	void RenderHouse2(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
-	void RenderHouse3(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
-	void RenderWindmill();
-	void RenderWall();
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.h
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "BoundingVolumeHierarchy.h"
+#include "CityGenerator.h"
+#include "ClusteredLighting.h"
+#include "EntityStore.h"
+#include "IndirectDrawList.h"
+#include "InstancedMesh.h"
+#include "LightBuffer.h"
+#include "MeshBuffer.h"
+#include "ObjectLightLists.h"
+#include "PipelineStateCache.h"
+#include "SceneFile.h"
+#include "SceneGraph.h"
+#include "WorkerPool.h"
+#include "StaticGeometryBake.h"
+#include "StreamBuffer.h"
+#include "TagRegistry.h"
+#include "TextureArrays.h"
+#include "WorldStreamer.h"
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneManager
+ *
+ *  This class contains the code for preparing and rendering
+ *  3D scenes, including the shader settings.
+ ***********************************************************/
+class SceneManager
+{
+public:
+	// constructor
+	SceneManager(ShaderManager *pShaderManager, ShaderUniforms *pShaderUniforms, PipelineStateCache *pPipelineState);
+	// destructor
+	~SceneManager();
+
+	struct OBJECT_MATERIAL
+	{
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		std::string tag;
+	};
+
+	// placement of one house object in the 3D scene
+	struct HOUSE_PLACEMENT
+	{
+		// 1 = RenderHouse(), 2 = RenderHouse2(), 3 = RenderHouse3()
+		int variant;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+		// true when the house may move, which draws it with
+		// instancing instead of merging it into the static bake
+		bool bDynamic;
+	};
+
+	// the objects built in code that are placed as a whole
+	enum LANDMARK_KIND
+	{
+		LANDMARK_WALL = 0,
+		LANDMARK_WINDMILL
+	};
+
+	// placement of one wall or windmill in the 3D scene,
+	// relative to where it is built in code
+	struct LANDMARK_PLACEMENT
+	{
+		int kind;
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+	};
+
+	// identifiers for the basic shape meshes, the shape IDs
+	// of the mesh geometry
+	enum MESH_ID
+	{
+		MESH_BOX = MeshGeometry::SHAPE_BOX,
+		MESH_PLANE = MeshGeometry::SHAPE_PLANE,
+		MESH_CYLINDER = MeshGeometry::SHAPE_CYLINDER,
+		MESH_CONE = MeshGeometry::SHAPE_CONE,
+		MESH_PRISM = MeshGeometry::SHAPE_PRISM,
+		MESH_PYRAMID4 = MeshGeometry::SHAPE_PYRAMID4,
+		MESH_SPHERE = MeshGeometry::SHAPE_SPHERE,
+		MESH_TAPERED_CYLINDER = MeshGeometry::SHAPE_TAPERED_CYLINDER,
+		MESH_TORUS = MeshGeometry::SHAPE_TORUS,
+		MESH_COUNT = MeshGeometry::SHAPE_COUNT
+	};
+
+	// one recorded draw of a basic shape mesh, with all the
+	// shader values already resolved - the draw list keeps it
+	// as the components of an entity
+	struct DRAW_COMMAND
+	{
+		int meshID;
+		glm::mat4 model;
+		// scene graph node the object hangs below, or -1 when the
+		// model matrix is already in world space
+		int transformNode;
+		// model matrix relative to the scene graph node
+		glm::mat4 localModel;
+		// slot in the texture table, or -1 when drawn with the color
+		int textureSlot;
+		// index into the defined materials, or -1 for none
+		int materialIndex;
+		glm::vec2 UVscale;
+		glm::vec4 color;
+		// offset and count of the object's point light list
+		glm::ivec2 lightRange;
+		// true when the object may move, which keeps it out of
+		// the static bake
+		bool bDynamic;
+		// key of the scene file object the draw was made from,
+		// 0 for an object built in code
+		uint64_t sourceKey;
+	};
+
+	// per-frame counters of the draw submission
+	struct RENDER_STATS
+	{
+		int drawCalls;
+		int stateChanges;
+		int stateChangesAvoided;
+		int transformsUpdated;
+		int drawsCulled;
+		// indirect draws drawn one by one instead, since the
+		// ring buffer could not hold their per-draw values
+		int streamFallbacks;
+	};
+
+	// counters of the last scene file reload
+	struct RELOAD_STATS
+	{
+		int nodesMoved;
+		int objectsAdded;
+		int objectsRemoved;
+		// true when the nodes changed and the scene was built
+		// again from the new file
+		bool bRebuilt;
+	};
+
+	// the object found by a pick
+	struct PICK_RESULT
+	{
+		// distance along the ray to where it enters the box
+		float distance;
+		// scene graph node the object hangs below, or -1
+		int transformNode;
+		int meshID;
+	};
+
+	// what the tags of a scene file resolve to, by tag index
+	struct SCENE_FILE_TAGS
+	{
+		std::vector<int> textureSlots;
+		std::vector<int> materialIndices;
+		std::vector<uint32_t> tagHashes;
+	};
+
+	// handles of the uniforms that are set while rendering
+	struct SCENE_UNIFORMS
+	{
+		UniformHandle<glm::mat4> model;
+		UniformHandle<glm::vec4> objectColor;
+		UniformHandle<int> textureLayer;
+		UniformHandle<bool> useLighting;
+		UniformHandle<bool> useInstancing;
+		UniformHandle<glm::vec2> UVscale;
+		UniformHandle<int> materialIndex;
+		UniformHandle<glm::ivec2> objectLightRange;
+		UniformHandle<int> pointLightCount;
+		UniformHandle<bool> useIndirectDraw;
+		UniformHandle<int> drawData;
+		UniformHandle<int> drawDataFirst;
+		UniformHandle<glm::vec3> directionalLightDirection;
+		UniformHandle<glm::vec3> directionalLightAmbient;
+		UniformHandle<glm::vec3> directionalLightDiffuse;
+		UniformHandle<glm::vec3> directionalLightSpecular;
+		UniformHandle<bool> directionalLightActive;
+	};
+
+	// one part of a house variant, as RenderHouse(),
+	// RenderHouse2() or RenderHouse3() records it below no node
+	struct HOUSE_PART
+	{
+		// instanced draw batch the part is drawn in
+		int batch;
+		// model matrix relative to the node of the house
+		glm::mat4 localModel;
+		glm::vec4 color;
+		glm::vec2 UVscale;
+	};
+
+	// the parts of every instanced house sharing a mesh, a
+	// texture and a material, drawn with one instanced call
+	struct HOUSE_BATCH
+	{
+		int meshID;
+		// slot in the texture table, or -1 when drawn with the color
+		int textureSlot;
+		int materialIndex;
+		InstancedMesh* pMesh;
+		// values of every instance, kept so the parts of a moved
+		// house can be written back on their own
+		std::vector<InstancedMesh::INSTANCE_DATA> instances;
+		// world space box around all the instances
+		MeshGeometry::MESH_BOUNDS bounds;
+		// offset and count of the batch's point light list
+		glm::ivec2 lightRange;
+	};
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to the uniform location table of the shader program
+	ShaderUniforms* m_pShaderUniforms;
+	// handles of the uniforms set while rendering
+	SCENE_UNIFORMS m_uniforms;
+	// pointer to the cache of the current pipeline state
+	PipelineStateCache* m_pPipelineState;
+	// draw the scene geometry as lines instead of filled
+	bool m_bWireframe;
+	// every basic shape mesh packed into shared buffers
+	MeshBuffer m_meshBuffer;
+	// loaded textures, packed into texture arrays by size and format
+	TextureArrays m_textures;
+	// defined object materials
+	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// index of every defined material by tag
+	TagRegistry m_materialTags;
+	// uniform buffer holding the table of all defined materials
+	GLuint m_materialBuffer;
+	// point lights of the scene, kept in a uniform buffer
+	LightBuffer m_pointLights;
+	// froxel grid that limits each fragment to the nearby lights
+	ClusteredLighting m_clusteredLighting;
+	// point lights reaching each drawn object, found once
+	ObjectLightLists m_objectLightLists;
+	// houses placed in the 3D scene
+	std::vector<HOUSE_PLACEMENT> m_housePlacements;
+	// walls and windmills placed in the 3D scene
+	std::vector<LANDMARK_PLACEMENT> m_landmarkPlacements;
+	// true when the placements come from a generated city
+	bool m_bGeneratedCity;
+	// street lights of the generated city
+	std::vector<glm::vec3> m_cityLightPositions;
+	// size and position of the ground plane
+	glm::vec3 m_groundScale;
+	glm::vec3 m_groundPosition;
+	// transform hierarchy of the placed objects
+	SceneGraph m_sceneGraph;
+	// root node of each placed house
+	std::vector<int> m_houseNodes;
+	// node each wall or windmill is built below
+	std::vector<int> m_landmarkNodes;
+	// node the recorded objects hang below, -1 for world space
+	int m_transformParent;
+	// scene file whose objects replace the ones built in code
+	SceneFile m_sceneFile;
+	// scene graph node of every node of the scene file
+	std::vector<int> m_sceneFileNodes;
+	// true when a node moved since the last frame
+	bool m_bSceneGraphDirty;
+	// draws of the draw list hanging below each scene graph
+	// node, from its first entry up to the first entry of the
+	// next node, and the same for the baked draws
+	std::vector<int> m_nodeFirstDraws;
+	std::vector<EntityStore::ENTITY> m_nodeDrawEntities;
+	std::vector<int> m_nodeFirstBakedDraws;
+	std::vector<int> m_nodeBakedDraws;
+	// placed house of each scene graph node, -1 for none
+	std::vector<int> m_nodeHouses;
+	// true when the draws changed since they were listed by node
+	bool m_bNodeDrawsDirty;
+	// draws of the draw list below the nodes of the last update
+	std::vector<EntityStore::ENTITY> m_movedEntities;
+	// the parts of each house variant, by variant - 1
+	std::vector<std::vector<HOUSE_PART>> m_houseVariantParts;
+	// instanced draw batches of the house parts
+	std::vector<HOUSE_BATCH> m_houseBatches;
+	// where the part instances of each placed house start in
+	// m_housePartInstances, -1 for a house that is not instanced
+	std::vector<int> m_houseFirstInstance;
+	// instance of every part of the instanced houses in its
+	// batch, in the part order of the house variant
+	std::vector<int> m_housePartInstances;
+	// draw the houses that may move with instancing, and every
+	// house when the static bake is off
+	bool m_bUseHouseInstancing;
+	// draw list recorded once when the scene is prepared, one
+	// entity per draw with its values in component arrays
+	EntityStore m_drawList;
+	// draw command that collects the shader values while recording
+	DRAW_COMMAND m_recordedDraw;
+	// true while the scene objects are recorded instead of drawn
+	bool m_bRecordingDrawList;
+	// replay the recorded draw list instead of rebuilding every object
+	bool m_bUseDrawList;
+	// true when the draw list must be sorted before the next replay
+	bool m_bDrawListDirty;
+	// sorted draw list written into indirect draw commands
+	IndirectDrawList m_indirectDrawList;
+	// submit the draw list with multi-draw indirect calls
+	bool m_bUseIndirectDraw;
+	// true when the indirect commands must be rebuilt
+	bool m_bIndirectDrawListDirty;
+	// ring buffer the per-draw values are written into every frame
+	StreamBuffer m_drawDataStream;
+	// texture buffer view of the per-draw value ring buffer
+	GLuint m_drawDataTexture;
+	// draws one frame region of the ring holds, and the most
+	// it can hold within one texture buffer
+	int m_drawDataCapacity;
+	int m_maxDrawDataCapacity;
+	// static objects merged into one mesh per appearance
+	StaticGeometryBake m_staticBake;
+	// draw the static objects from the bake
+	bool m_bUseStaticBake;
+	// point light list of each merged mesh of the bake
+	std::vector<glm::ivec2> m_bakeLightRanges;
+	// static draws merged into the bake, kept to rebuild it,
+	// and the index of each one among the merged objects
+	std::vector<DRAW_COMMAND> m_bakedDraws;
+	std::vector<int> m_bakedObjects;
+	// threads the per-frame draw list work is split across
+	WorkerPool m_workerPool;
+	// skip the draws outside the view frustum
+	bool m_bFrustumCulling;
+	// true once a view has been passed in for the culling
+	bool m_bCullingViewSet;
+	// planes of the view frustum of this frame
+	glm::vec4 m_frustumPlanes[6];
+	// hierarchy over the world boxes of the draws - the draws
+	// of the draw list by transform slot, then the baked draws
+	BoundingVolumeHierarchy m_objectBVH;
+	// true when the draws were added, removed or reordered
+	// since the hierarchy was built
+	bool m_bObjectBVHDirty;
+	// items found by the last hierarchy query
+	std::vector<int> m_queryItems;
+	// visibility of every draw of the draw list this frame, by
+	// slot of its transform component
+	std::vector<unsigned char> m_drawVisible;
+	// first packed slot of the visible draws of each chunk
+	std::vector<int> m_chunkFirstSlots;
+	// visible draws of the draw list this frame
+	int m_visibleDrawCount;
+	// chunks of the generated city loaded around the camera
+	WorldStreamer m_worldStreamer;
+	// stream the generated city instead of placing all of it
+	bool m_bUseWorldStreaming;
+	WorldStreamer::STREAM_SETTINGS m_streamSettings;
+	// point light list of each merged mesh of the loaded
+	// chunks, in the order of the loaded chunks
+	std::vector<glm::ivec2> m_streamLightRanges;
+	// decode the images of textures that are not cooked
+	bool m_bAllowSourceAssets;
+	// counters of the current frame
+	RENDER_STATS m_renderStats;
+
+	// load texture images and convert to OpenGL texture data
+	bool CreateGLTexture(const char* filename, std::string tag);
+	// upload the loaded textures and bind the texture arrays
+	void BindGLTextures();
+	// free the loaded OpenGL textures
+	void DestroyGLTextures();
+	// find a loaded texture by tag
+	int FindTextureSlot(TagID tag);
+	// find a defined material by tag
+	bool FindMaterial(TagID tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(TagID tag);
+
+	// build the model matrix from the transformation values
+	glm::mat4 ComposeTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the transformation values 
+	// into the transform buffer
+	void SetTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ,
+		glm::vec3 offset = glm::vec3(0.0f, 0.0f, 0.0f));
+
+	// set the color values into the shader
+	void SetShaderColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+
+	// set the texture data into the shader
+	void SetShaderTexture(
+		TagID textureTag);
+
+	// set the UV scale for the texture mapping
+	void SetTextureUVScale(
+		float u, float v);
+
+	// set the object material into the shader
+	void SetShaderMaterial(
+		TagID materialTag);
+
+	// mark the next drawn objects as moving or not moving
+	void SetObjectDynamic(bool bDynamic);
+
+	// draw the basic shape mesh, or record it into the draw list
+	void DrawMesh(int meshID);
+	// record the scene objects into the draw list
+	void RecordDrawList();
+	// start a recording from the default shader values
+	void ResetRecordedDraw();
+	// record the objects of the scene file into the draw list
+	void RecordSceneFileObjects();
+	// look up the textures and materials of the scene file tags
+	void ResolveSceneFileTags(const SceneFile& sceneFile, SCENE_FILE_TAGS& tags);
+	// make the draw of a scene file object, false when its
+	// mesh is unknown, passing on the material it ends up with
+	bool MakeSceneFileDraw(
+		const SceneFile::SCENE_OBJECT& object,
+		const SCENE_FILE_TAGS& tags,
+		int& materialIndex,
+		DRAW_COMMAND& draw);
+	// draw the recorded draw list
+	void ReplayDrawList();
+	// draw the draws of the draw list left by the last culling
+	void ReplayVisibleDraws();
+	// build the key that orders the draw command submission
+	uint64_t MakeSortKey(
+		const EntityStore::MESH_REF& mesh,
+		const EntityStore::TEXTURE_REF& texture,
+		const EntityStore::MATERIAL_REF& material) const;
+	// add a recorded draw to the draw list as an entity
+	void AddDrawEntity(EntityStore& drawList, const DRAW_COMMAND& draw);
+	// get the draws of a draw list back in their stored order
+	void GetDrawCommands(EntityStore& drawList, std::vector<DRAW_COMMAND>& draws);
+	// sort the draw list by the draw command keys
+	void SortDrawList();
+	// draw or record all the scene objects that are not instanced
+	void SubmitSceneObjects();
+	// write the sorted draw list into the indirect draw commands
+	void BuildIndirectDrawList();
+	// draw the draw list with one indirect call per texture
+	void SubmitIndirectDrawList();
+	// create the ring buffer for the per-draw values of the
+	// passed in number of draws per frame
+	void CreateDrawDataStream(int drawCount);
+	// find the point lights reaching every drawn object
+	void AssignObjectLights();
+	// upload the light lists changed since the last upload, or
+	// assign all of them again once they are mostly unused
+	void UploadObjectLights();
+	// make the pipeline state of a render pass current
+	void ApplyPassState(const PIPELINE_STATE& state);
+	// merge the static draws of the draw list into the bake
+	void BakeStaticGeometry();
+	// draw the merged static meshes
+	void RenderStaticBake();
+	// merge the baked draws again after they moved
+	void RebuildStaticBake();
+	// add the house nodes to the transform hierarchy
+	void BuildSceneGraph();
+	// true when the house is drawn instanced instead of being
+	// recorded part by part
+	bool IsHouseInstanced(int house) const;
+	// place the parts of every instanced house into the
+	// instance buffers
+	void FillHouseInstances();
+	// write the parts of the moved houses into the instance
+	// buffers again
+	void UpdateHouseInstances(const std::vector<int>& movedHouses);
+	// free the instanced meshes of the house batches
+	void DestroyHouseBatches();
+	// list the draws and the house hanging below every node
+	void IndexNodeDraws();
+	// recompute the moved nodes and refresh the objects below them
+	void UpdateSceneGraph();
+	// find the visible draws of the draw list
+	void CullDrawList();
+	// build the object hierarchy again after the draws changed,
+	// or refit it to the moved draws
+	void UpdateObjectBVH();
+	// hand the generated city to the world streamer, one
+	// template per house variant and landmark kind
+	void PrepareWorldStreaming();
+	// draw the merged meshes of the loaded chunks
+	void RenderStreamedChunks();
+	// set the shader values of one merged mesh
+	void SetBakeBatchState(const StaticGeometryBake::BAKE_KEY& key, glm::ivec2 lightRange);
+
+public:
+
+	// The following methods are for the students to 
+	// customize for their own 3D scene
+	void PrepareScene();
+	void RenderScene();
+
+	// get the counters of the last rendered frame
+	const RENDER_STATS& GetRenderStats() const { return(m_renderStats); }
+	// get the counters of the per-draw value ring buffer
+	const StreamBuffer::STREAM_STATS& GetStreamStats() const { return(m_drawDataStream.GetFrameCounters()); }
+	// get the counters of the last light cluster assignment
+	const ClusteredLighting::CLUSTER_STATS& GetClusterStats() const { return(m_clusteredLighting.GetStats()); }
+	// get the counters of the per-object light assignment
+	const ObjectLightLists::LIGHT_LIST_STATS& GetObjectLightStats() const { return(m_objectLightLists.GetStats()); }
+
+	// assign the point lights to the clusters of the current view
+	void UpdateLightClusters(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane,
+		glm::ivec2 viewportSize);
+	// use the clustered light lookup instead of the whole light list
+	void SetClusteredLighting(bool bEnabled);
+	// use the per-object light lists instead of the whole light list
+	void SetObjectLightLists(bool bEnabled);
+	// submit the draw list with multi-draw indirect when supported
+	void SetIndirectDraw(bool bEnabled);
+	// draw the static objects from merged pre-transformed meshes
+	void SetStaticBake(bool bEnabled);
+	// draw the scene geometry as lines instead of filled
+	void SetWireframe(bool bEnabled) { m_bWireframe = bEnabled; }
+	// decode the image of a texture that is not cooked or is
+	// older than its image, must be called before PrepareScene()
+	void SetAllowSourceAssets(bool bAllowed) { m_bAllowSourceAssets = bAllowed; }
+	// map a scene file to use instead of the objects built in
+	// code, or read it into memory when it is going to be
+	// rewritten and reloaded, must be called before PrepareScene()
+	bool OpenSceneFile(const char* filename, bool bReadIntoMemory);
+	// load a new version of the open scene file, applying only
+	// what changed since the loaded version
+	bool ReloadSceneFile(const char* filename, RELOAD_STATS& stats);
+	// load the textures whose files changed again, and get how
+	// many were reloaded
+	int ReloadChangedTextures() { return(m_textures.ReloadChanged()); }
+	// write the objects of the scene into a scene file
+	bool ExportSceneFile(const char* filename);
+	// place the objects of a generated city instead of the
+	// ones placed in code, must be called before PrepareScene()
+	void GenerateCity(const CityGenerator& city);
+	// load the generated city in chunks around the camera,
+	// must be called before PrepareScene()
+	void SetWorldStreaming(bool bEnabled, const WorldStreamer::STREAM_SETTINGS& settings);
+	// load and unload the chunks around the camera position
+	// of the next frame
+	void UpdateWorldStreaming(glm::vec3 cameraPosition);
+	// get the counters of the streamed chunks
+	const WorldStreamer::STREAM_STATS& GetWorldStreamStats() const { return(m_worldStreamer.GetStats()); }
+	// start the threads for the per-frame work, 0 for one per core
+	void SetWorkerThreads(int threadCount);
+	// pass in the view of the next frame for the frustum culling
+	void SetCullingView(const glm::mat4& view, const glm::mat4& projection);
+	// skip the draws outside the view frustum
+	void SetFrustumCulling(bool bEnabled) { m_bFrustumCulling = bEnabled; }
+	// find the object whose box a ray enters first, false when
+	// the ray misses every object
+	bool PickObject(glm::vec3 origin, glm::vec3 direction, PICK_RESULT& pick);
+	// get the counters of the object hierarchy
+	const BoundingVolumeHierarchy::BVH_STATS& GetObjectBVHStats() const { return(m_objectBVH.GetStats()); }
+	// move a placed house, only its own nodes are recomputed
+	void SetHouseTransform(int house, glm::vec3 rotationDegrees, glm::vec3 positionXYZ);
+	// get where a placed house stands, false when there is no
+	// such house
+	bool GetHouseTransform(int house, glm::vec3& rotationDegrees, glm::vec3& positionXYZ) const;
+	int GetHouseCount() const { return((int)m_housePlacements.size()); }
+
+	// pack the basic shape meshes into the shared mesh buffer
+	void LoadSceneMeshes();
+
+	// loads textures from image files
+	void LoadSceneTextures();
+	// define all the object materials before rendering
+	void DefineObjectMaterials();
+	// upload the defined materials into the material buffer
+	void UploadMaterialBuffer();
+	// add and define the light sources before rendering
+	void SetupSceneLights();
+	// define where the houses are placed in the scene
+	void DefineHousePlacements();
+	// define where the wall and the windmill are placed
+	void DefineLandmarkPlacements();
+	// record the parts of every house variant and create the
+	// instanced meshes of their batches
+	void PrepareHouseInstances();
+	// draw every instanced house with one call per batch
+	void RenderHouseInstances();
+
+	void RenderGround(float Xrotation);
+	void RenderHouse(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
+	void RenderHouse2(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
+	void RenderHouse3(float Xrot, float Yrot, float Zrot, float Xpos, float Ypos, float Zpos);
+	void RenderWindmill();
+	void RenderWall();
 };
\ No newline at end of file
@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.cpp
+// ============
+// set shader uniform values through pre-resolved location handles
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderUniforms.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <iostream>
+
+/***********************************************************
+ *  ShaderUniforms()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderUniforms::ShaderUniforms()
+{
+	m_programID = 0;
+	m_uploadStats.uploadsIssued = 0;
+	m_uploadStats.uploadsSkipped = 0;
+}
+
+/***********************************************************
+ *  ~ShaderUniforms()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderUniforms::~ShaderUniforms()
+{
+	m_names.clear();
+	m_locations.clear();
+	m_shadowValues.clear();
+}
+
+/***********************************************************
+ *  RegisterName()
+ *
+ *  This method is used for adding a uniform name to the
+ *  location table. A name that is already registered gets
+ *  its existing slot back. When the locations have already
+ *  been resolved, the new location is looked up right away.
+ ***********************************************************/
+int ShaderUniforms::RegisterName(const char* name)
+{
+	for (int slot = 0; slot < (int)m_names.size(); slot++)
+	{
+		if (m_names[slot].compare(name) == 0)
+		{
+			return(slot);
+		}
+	}
+
+	GLint location = -1;
+	if (0 != m_programID)
+	{
+		location = glGetUniformLocation(m_programID, name);
+	}
+
+	SHADOW_VALUE shadow;
+	shadow.bValid = false;
+	memset(shadow.data, 0, sizeof(shadow.data));
+
+	m_names.push_back(name);
+	m_locations.push_back(location);
+	m_shadowValues.push_back(shadow);
+
+	return((int)m_names.size() - 1);
+}
+
+/***********************************************************
+ *  ResolveLocations()
+ *
+ *  This method is used for looking up the locations of all
+ *  the registered uniforms. It must be called after the
+ *  shaders are loaded and the program is put in use.
+ ***********************************************************/
+void ShaderUniforms::ResolveLocations()
+{
+	GLint currentProgram = 0;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+	m_programID = (GLuint)currentProgram;
+
+	for (int slot = 0; slot < (int)m_names.size(); slot++)
+	{
+		m_locations[slot] = glGetUniformLocation(m_programID, m_names[slot].c_str());
+		if (-1 == m_locations[slot])
+		{
+			std::cout << "Uniform not found in shader program: " << m_names[slot] << std::endl;
+		}
+	}
+
+	// the program may have changed, so the shadow values
+	// no longer describe what is set in the shaders
+	InvalidateShadowValues();
+}
+
+/***********************************************************
+ *  BindUniformBlock()
+ *
+ *  This method is used for connecting the named uniform block
+ *  of the shader program to a uniform buffer binding point.
+ *  It must be called after ResolveLocations().
+ ***********************************************************/
+bool ShaderUniforms::BindUniformBlock(const char* blockName, GLuint bindingPoint)
+{
+	GLuint blockIndex = GL_INVALID_INDEX;
+
+	if (0 == m_programID)
+	{
+		return(false);
+	}
+
+	blockIndex = glGetUniformBlockIndex(m_programID, blockName);
+	if (GL_INVALID_INDEX == blockIndex)
+	{
+		std::cout << "Uniform block not found in shader program: " << blockName << std::endl;
+		return(false);
+	}
+
+	glUniformBlockBinding(m_programID, blockIndex, bindingPoint);
+
+	return(true);
+}
+
+/***********************************************************
+ *  InvalidateShadowValues()
+ *
+ *  This method is used for forgetting all the shadow values,
+ *  so the next value set into each uniform is uploaded.
+ ***********************************************************/
+void ShaderUniforms::InvalidateShadowValues()
+{
+	for (SHADOW_VALUE& shadow : m_shadowValues)
+	{
+		shadow.bValid = false;
+	}
+}
+
+/***********************************************************
+ *  ResetFrameCounters()
+ *
+ *  This method is used for resetting the upload counters at
+ *  the start of a frame.
+ ***********************************************************/
+void ShaderUniforms::ResetFrameCounters()
+{
+	m_uploadStats.uploadsIssued = 0;
+	m_uploadStats.uploadsSkipped = 0;
+}
+
+/***********************************************************
+ *  IsUnchanged()
+ *
+ *  This method is used for comparing the passed in value
+ *  with the shadow copy of the slot. The shadow copy is
+ *  updated and the upload counters are advanced. Slots
+ *  without a location are always reported as unchanged,
+ *  since there is nothing to upload.
+ ***********************************************************/
+bool ShaderUniforms::IsUnchanged(int slot, const void* value, size_t size)
+{
+	if (-1 == GetLocation(slot))
+	{
+		return(true);
+	}
+
+	SHADOW_VALUE& shadow = m_shadowValues[slot];
+	if ((true == shadow.bValid) && (memcmp(shadow.data, value, size) == 0))
+	{
+		m_uploadStats.uploadsSkipped++;
+		return(true);
+	}
+
+	memcpy(shadow.data, value, size);
+	shadow.bValid = true;
+	m_uploadStats.uploadsIssued++;
+
+	return(false);
+}
+
+/***********************************************************
+ *  GetLocation()
+ *
+ *  This method is used for getting the resolved location
+ *  for the passed in handle slot.
+ ***********************************************************/
+GLint ShaderUniforms::GetLocation(int slot) const
+{
+	if ((slot < 0) || (slot >= (int)m_locations.size()))
+	{
+		return(-1);
+	}
+
+	return(m_locations[slot]);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  These methods are used for setting the passed in value
+ *  into the uniform of the handle. The upload is skipped
+ *  when the value matches the shadow copy, or when the
+ *  uniform was not found in the program.
+ ***********************************************************/
+void ShaderUniforms::Set(UniformHandle<bool> handle, bool value)
+{
+	// booleans are uploaded and compared as integers
+	int intValue = (int)value;
+	if (false == IsUnchanged(handle.slot, &intValue, sizeof(intValue)))
+	{
+		glUniform1i(GetLocation(handle.slot), intValue);
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<int> handle, int value)
+{
+	if (false == IsUnchanged(handle.slot, &value, sizeof(value)))
+	{
+		glUniform1i(GetLocation(handle.slot), value);
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<float> handle, float value)
+{
+	if (false == IsUnchanged(handle.slot, &value, sizeof(value)))
+	{
+		glUniform1f(GetLocation(handle.slot), value);
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<glm::vec2> handle, const glm::vec2& value)
+{
+	if (false == IsUnchanged(handle.slot, glm::value_ptr(value), sizeof(glm::vec2)))
+	{
+		glUniform2fv(GetLocation(handle.slot), 1, glm::value_ptr(value));
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<glm::ivec2> handle, const glm::ivec2& value)
+{
+	if (false == IsUnchanged(handle.slot, glm::value_ptr(value), sizeof(glm::ivec2)))
+	{
+		glUniform2iv(GetLocation(handle.slot), 1, glm::value_ptr(value));
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<glm::vec3> handle, const glm::vec3& value)
+{
+	if (false == IsUnchanged(handle.slot, glm::value_ptr(value), sizeof(glm::vec3)))
+	{
+		glUniform3fv(GetLocation(handle.slot), 1, glm::value_ptr(value));
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<glm::vec4> handle, const glm::vec4& value)
+{
+	if (false == IsUnchanged(handle.slot, glm::value_ptr(value), sizeof(glm::vec4)))
+	{
+		glUniform4fv(GetLocation(handle.slot), 1, glm::value_ptr(value));
+	}
+}
+
+void ShaderUniforms::Set(UniformHandle<glm::mat4> handle, const glm::mat4& value)
+{
+	if (false == IsUnchanged(handle.slot, glm::value_ptr(value), sizeof(glm::mat4)))
+	{
+		glUniformMatrix4fv(GetLocation(handle.slot), 1, GL_FALSE, glm::value_ptr(value));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.h
+// ============
+// set shader uniform values through pre-resolved location handles
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  UniformHandle
+ *
+ *  Typed handle to a uniform registered with ShaderUniforms.
+ *  The type picks the matching glUniform* call at compile
+ *  time, so a value can only be set with the right type.
+ ***********************************************************/
+template <typename T>
+struct UniformHandle
+{
+	// index into the ShaderUniforms location table
+	int slot = -1;
+};
+
+/***********************************************************
+ *  ShaderUniforms
+ *
+ *  This class keeps a table of uniform locations for the
+ *  shader program loaded by the ShaderManager. Uniform names
+ *  are registered once and looked up in the driver once in
+ *  ResolveLocations(), after LoadShaders(). Values are then
+ *  set through the returned handles, without any per-draw
+ *  string lookups.
+ *
+ *  A shadow copy of the last value set into each uniform is
+ *  kept on the CPU, and a glUniform* call is skipped when
+ *  the new value equals the shadow copy.
+ ***********************************************************/
+class ShaderUniforms
+{
+public:
+	// counters of the uniform uploads since the last reset
+	struct UPLOAD_STATS
+	{
+		int uploadsIssued;
+		int uploadsSkipped;
+	};
+
+	// constructor
+	ShaderUniforms();
+	// destructor
+	~ShaderUniforms();
+
+	// register a uniform by name and get its typed handle
+	template <typename T>
+	UniformHandle<T> Register(const char* name)
+	{
+		UniformHandle<T> handle;
+		handle.slot = RegisterName(name);
+		return(handle);
+	}
+
+	// look up the locations of all registered uniforms in the
+	// shader program that is currently in use
+	void ResolveLocations();
+
+	// connect a uniform block of the program to a buffer binding point
+	bool BindUniformBlock(const char* blockName, GLuint bindingPoint);
+
+	// set the uniform values into the shader program
+	void Set(UniformHandle<bool> handle, bool value);
+	void Set(UniformHandle<int> handle, int value);
+	void Set(UniformHandle<float> handle, float value);
+	void Set(UniformHandle<glm::vec2> handle, const glm::vec2& value);
+	void Set(UniformHandle<glm::ivec2> handle, const glm::ivec2& value);
+	void Set(UniformHandle<glm::vec3> handle, const glm::vec3& value);
+	void Set(UniformHandle<glm::vec4> handle, const glm::vec4& value);
+	void Set(UniformHandle<glm::mat4> handle, const glm::mat4& value);
+
+	// forget the shadow values, e.g. after the uniforms were
+	// changed without going through this class
+	void InvalidateShadowValues();
+
+	// reset the upload counters at the start of a frame
+	void ResetFrameCounters();
+	// get the upload counters of the current frame
+	const UPLOAD_STATS& GetFrameCounters() const { return(m_uploadStats); }
+
+private:
+	// the last value set into a uniform
+	struct SHADOW_VALUE
+	{
+		bool bValid;
+		// large enough for a mat4, smaller types use the front
+		float data[16];
+	};
+
+	// shader program the locations were resolved in
+	GLuint m_programID;
+	// registered uniform names
+	std::vector<std::string> m_names;
+	// resolved uniform locations, -1 when not found
+	std::vector<GLint> m_locations;
+	// shadow copies of the uniform values, one per slot
+	std::vector<SHADOW_VALUE> m_shadowValues;
+	// upload counters of the current frame
+	UPLOAD_STATS m_uploadStats;
+
+	// add the uniform name to the table and get its slot
+	int RegisterName(const char* name);
+	// get the resolved location for the handle slot
+	GLint GetLocation(int slot) const;
+	// compare the value with the shadow copy of the slot and
+	// update the copy - true means the upload can be skipped
+	bool IsUnchanged(int slot, const void* value, size_t size);
+};
\ No newline at end of file
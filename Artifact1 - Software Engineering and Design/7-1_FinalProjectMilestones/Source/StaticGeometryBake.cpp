@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticgeometrybake.cpp
+// ============
+// merge static objects into pre-transformed meshes, one per appearance
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticGeometryBake.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  StaticGeometryBake()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StaticGeometryBake::StaticGeometryBake()
+{
+	m_nObjects = 0;
+}
+
+/***********************************************************
+ *  ~StaticGeometryBake()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StaticGeometryBake::~StaticGeometryBake()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the objects from the
+ *  bake, including the merged meshes already uploaded.
+ ***********************************************************/
+void StaticGeometryBake::Clear()
+{
+	m_keys.clear();
+	m_batchData.clear();
+	m_meshBuffer.Destroy();
+	m_objects.clear();
+	m_nObjects = 0;
+}
+
+/***********************************************************
+ *  FindBatch()
+ *
+ *  This method is used for finding the batch that merges the
+ *  objects of the passed in key. A new batch is added when
+ *  no object with the key has been merged yet.
+ ***********************************************************/
+int StaticGeometryBake::FindBatch(const BAKE_KEY& key)
+{
+	for (int batch = 0; batch < (int)m_keys.size(); batch++)
+	{
+		const BAKE_KEY& batchKey = m_keys[batch];
+		if ((batchKey.textureSlot == key.textureSlot) &&
+			(batchKey.materialIndex == key.materialIndex) &&
+			(batchKey.color == key.color))
+		{
+			return(batch);
+		}
+	}
+
+	m_keys.push_back(key);
+	m_batchData.push_back(MeshGeometry::MESH_DATA());
+
+	return((int)m_keys.size() - 1);
+}
+
+/***********************************************************
+ *  AddObject()
+ *
+ *  This method is used for merging the passed in mesh into
+ *  the batch of its key. The positions are moved into world
+ *  space by the model matrix and the texture coordinates are
+ *  multiplied by the UV scale, which gives the same result
+ *  as the repeated texture wrapping. The returned index picks
+ *  the object for RemoveObject().
+ *
+ *  The normals are copied unchanged, since the shaders light
+ *  every object with the normal of the untransformed mesh.
+ ***********************************************************/
+int StaticGeometryBake::AddObject(
+	const MeshGeometry::MESH_DATA& mesh,
+	const glm::mat4& model,
+	const glm::vec2& UVscale,
+	const BAKE_KEY& key)
+{
+	BAKE_KEY batchKey = key;
+
+	// the color of a textured object is never used, so it
+	// must not split the batch
+	if (batchKey.textureSlot >= 0)
+	{
+		batchKey.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	}
+
+	int batch = FindBatch(batchKey);
+	MeshGeometry::MESH_DATA& batchData = m_batchData[batch];
+	GLuint firstVertex = (GLuint)batchData.vertices.size();
+
+	BAKE_OBJECT object = { batch, (GLuint)batchData.indices.size(), (GLsizei)mesh.indices.size() };
+	m_objects.push_back(object);
+
+	for (const MeshGeometry::VERTEX& vertex : mesh.vertices)
+	{
+		MeshGeometry::VERTEX bakedVertex = vertex;
+		glm::vec4 position = model * glm::vec4(vertex.position, 1.0f);
+
+		bakedVertex.position = glm::vec3(position.x, position.y, position.z);
+		bakedVertex.textureCoordinate = vertex.textureCoordinate * UVscale;
+		batchData.vertices.push_back(bakedVertex);
+	}
+	for (GLuint index : mesh.indices)
+	{
+		batchData.indices.push_back(firstVertex + index);
+	}
+
+	m_nObjects++;
+
+	return((int)m_objects.size() - 1);
+}
+
+/***********************************************************
+ *  RemoveObject()
+ *
+ *  This method is used for taking one merged object out of
+ *  the drawing, such as a baked object that started moving.
+ *  Its indices are turned into degenerate triangles, which
+ *  draw nothing, so only the indices of the object are
+ *  written again and the batch is not merged anew. The box
+ *  of the batch keeps covering the removed object until the
+ *  bake is rebuilt.
+ ***********************************************************/
+void StaticGeometryBake::RemoveObject(int object)
+{
+	if ((object < 0) || (object >= (int)m_objects.size()) || (0 == m_objects[object].indexCount))
+	{
+		return;
+	}
+
+	BAKE_OBJECT& bakeObject = m_objects[object];
+	if (false == m_batchData.empty())
+	{
+		// not uploaded yet, the merged indices are still here
+		std::vector<GLuint>& indices = m_batchData[bakeObject.batch].indices;
+		std::fill(
+			indices.begin() + bakeObject.firstIndex,
+			indices.begin() + bakeObject.firstIndex + bakeObject.indexCount,
+			0);
+	}
+	else
+	{
+		m_meshBuffer.CollapseIndices(bakeObject.batch, bakeObject.firstIndex, bakeObject.indexCount);
+	}
+
+	bakeObject.indexCount = 0;
+	m_nObjects--;
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for packing the merged meshes into
+ *  the shared mesh buffer. The batch index is also the mesh
+ *  ID of the merged mesh. The merged vertex data is freed
+ *  once it is uploaded.
+ ***********************************************************/
+void StaticGeometryBake::Upload()
+{
+	for (const MeshGeometry::MESH_DATA& batchData : m_batchData)
+	{
+		m_meshBuffer.AddMesh(batchData);
+	}
+	m_meshBuffer.Upload();
+
+	m_batchData.clear();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the merged meshes.
+ ***********************************************************/
+void StaticGeometryBake::Destroy()
+{
+	Clear();
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticgeometrybake.h
+// ============
+// merge static objects into pre-transformed meshes, one per appearance
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshBuffer.h"
+
+#include <vector>
+
+/***********************************************************
+ *  StaticGeometryBake
+ *
+ *  This class merges the meshes of objects that never move
+ *  into one mesh per appearance - texture, material and, for
+ *  objects drawn with a color, the color. The vertices are
+ *  moved into world space and the texture UV scale is
+ *  applied to the texture coordinates, so each merged mesh
+ *  is drawn with an identity model matrix by a single call.
+ ***********************************************************/
+class StaticGeometryBake
+{
+public:
+	// constructor
+	StaticGeometryBake();
+	// destructor
+	~StaticGeometryBake();
+
+	// shared appearance of the objects merged into one mesh
+	struct BAKE_KEY
+	{
+		// texture slot, -1 when drawn with the color
+		int textureSlot;
+		// material index, -1 when no material is set
+		int materialIndex;
+		// color, only used when there is no texture
+		glm::vec4 color;
+	};
+
+	// remove all the objects from the bake
+	void Clear();
+	// merge a mesh with its model matrix into the mesh of its
+	// key, and get the index of the merged object
+	int AddObject(
+		const MeshGeometry::MESH_DATA& mesh,
+		const glm::mat4& model,
+		const glm::vec2& UVscale,
+		const BAKE_KEY& key);
+	// stop drawing a merged object, leaving the others as they are
+	void RemoveObject(int object);
+	// upload the merged meshes into the shared mesh buffer
+	void Upload();
+	// free the merged meshes
+	void Destroy();
+
+	// make the merged mesh buffer current
+	void Bind() const { m_meshBuffer.Bind(); }
+	// draw one merged mesh, the mesh buffer must be bound
+	void DrawBatch(int batch) const { m_meshBuffer.DrawMesh(batch); }
+
+	// get the merged meshes, one per key
+	int GetBatchCount() const { return((int)m_keys.size()); }
+	const BAKE_KEY& GetBatchKey(int batch) const { return(m_keys[batch]); }
+	// get the world space box around a merged mesh
+	const MeshGeometry::MESH_BOUNDS& GetBatchBounds(int batch) const { return(m_meshBuffer.GetBounds(batch)); }
+	// number of objects merged by the bake
+	int GetObjectCount() const { return(m_nObjects); }
+
+private:
+	// where the indices of a merged object are in its batch
+	struct BAKE_OBJECT
+	{
+		int batch;
+		GLuint firstIndex;
+		// 0 once the object is removed
+		GLsizei indexCount;
+	};
+
+	// key and merged vertex data of every batch
+	std::vector<BAKE_KEY> m_keys;
+	std::vector<MeshGeometry::MESH_DATA> m_batchData;
+	// merged meshes in shared buffers, mesh ID = batch index
+	MeshBuffer m_meshBuffer;
+	// every merged object, in the order they were added
+	std::vector<BAKE_OBJECT> m_objects;
+	// number of objects merged by the bake
+	int m_nObjects;
+
+	// find the batch of the key, adding it when it is new
+	int FindBatch(const BAKE_KEY& key);
+};
\ No newline at end of file
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+// streambuffer.cpp
+// ============
+// ring buffer for data written by the CPU every frame
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StreamBuffer.h"
+
+// declaration of global variables
+namespace
+{
+	// longest single wait on a region fence, in nanoseconds
+	const GLuint64 g_FenceTimeout = 1000000000;
+
+	/***********************************************************
+	 *  IsBufferStorageSupported()
+	 *
+	 *  This function is used for checking whether the current
+	 *  OpenGL context provides immutable buffer storage, which
+	 *  is core from version 4.4.
+	 ***********************************************************/
+	bool IsBufferStorageSupported()
+	{
+		GLint majorVersion = 0;
+		GLint minorVersion = 0;
+
+		glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+		glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+		return((majorVersion > 4) || ((4 == majorVersion) && (minorVersion >= 4)));
+	}
+}
+
+/***********************************************************
+ *  StreamBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StreamBuffer::StreamBuffer()
+{
+	m_buffer = 0;
+	m_pMapped = NULL;
+	m_frameSize = 0;
+	m_frameCount = 0;
+	m_frameIndex = 0;
+	m_writeOffset = 0;
+	m_flushOffset = 0;
+	m_stats = { 0, 0 };
+}
+
+/***********************************************************
+ *  ~StreamBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StreamBuffer::~StreamBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the buffer with one
+ *  region of frameSize bytes for every frame in flight.
+ ***********************************************************/
+void StreamBuffer::Create(GLsizeiptr frameSize, int frameCount)
+{
+	Destroy();
+
+	m_frameSize = frameSize;
+	m_frameCount = frameCount;
+	m_frameIndex = 0;
+	m_writeOffset = 0;
+	m_flushOffset = 0;
+	m_fences.assign(m_frameCount, (GLsync)0);
+
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+	if (true == IsBufferStorageSupported())
+	{
+		// coherent mapping makes the writes visible to the GPU
+		// without any explicit flush
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_COPY_WRITE_BUFFER, m_frameSize * m_frameCount, NULL, flags);
+		m_pMapped = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, m_frameSize * m_frameCount, flags);
+	}
+	else
+	{
+		glBufferData(GL_COPY_WRITE_BUFFER, m_frameSize * m_frameCount, NULL, GL_STREAM_DRAW);
+		m_staging.resize(m_frameSize * m_frameCount);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for unmapping and freeing the buffer
+ *  together with the fences of the regions.
+ ***********************************************************/
+void StreamBuffer::Destroy()
+{
+	for (GLsync& fence : m_fences)
+	{
+		if (0 != fence)
+		{
+			glDeleteSync(fence);
+			fence = 0;
+		}
+	}
+	m_fences.clear();
+
+	if (0 != m_buffer)
+	{
+		if (NULL != m_pMapped)
+		{
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			m_pMapped = NULL;
+		}
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+	}
+	m_staging.clear();
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for moving on to the region of the
+ *  next frame. When the GPU may still be reading the region
+ *  from an earlier frame, this waits on the region's fence.
+ ***********************************************************/
+void StreamBuffer::BeginFrame()
+{
+	if (0 == m_buffer)
+	{
+		return;
+	}
+
+	m_frameIndex = (m_frameIndex + 1) % m_frameCount;
+
+	GLsync& fence = m_fences[m_frameIndex];
+	if (0 != fence)
+	{
+		GLenum waitResult = glClientWaitSync(fence, 0, 0);
+		if ((GL_ALREADY_SIGNALED != waitResult) && (GL_CONDITION_SATISFIED != waitResult))
+		{
+			// the GPU is behind by a whole ring of frames
+			m_stats.fenceWaits++;
+			do
+			{
+				waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceTimeout);
+			} while (GL_TIMEOUT_EXPIRED == waitResult);
+		}
+		glDeleteSync(fence);
+		fence = 0;
+	}
+
+	m_writeOffset = m_frameIndex * m_frameSize;
+	m_flushOffset = m_writeOffset;
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for reserving bytes in the region of
+ *  the current frame. The offset of the reserved bytes in
+ *  the buffer is returned through the offset parameter, and
+ *  is a multiple of the passed in alignment. NULL is
+ *  returned when the region has no room left.
+ ***********************************************************/
+void* StreamBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset)
+{
+	if (0 == m_buffer)
+	{
+		return(NULL);
+	}
+
+	GLintptr alignedOffset = ((m_writeOffset + alignment - 1) / alignment) * alignment;
+	if (alignedOffset + size > (m_frameIndex + 1) * m_frameSize)
+	{
+		return(NULL);
+	}
+
+	offset = alignedOffset;
+	m_writeOffset = alignedOffset + size;
+	m_stats.bytesWritten += (int)size;
+
+	if (NULL != m_pMapped)
+	{
+		return(m_pMapped + alignedOffset);
+	}
+
+	return(m_staging.data() + alignedOffset);
+}
+
+/***********************************************************
+ *  Flush()
+ *
+ *  This method is used for making the data written since the
+ *  last flush visible to the GPU. The coherent mapping needs
+ *  nothing, the CPU copy is uploaded with glBufferSubData.
+ ***********************************************************/
+void StreamBuffer::Flush()
+{
+	if ((NULL == m_pMapped) && (m_writeOffset > m_flushOffset))
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, m_flushOffset,
+			m_writeOffset - m_flushOffset,
+			m_staging.data() + m_flushOffset);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	m_flushOffset = m_writeOffset;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for placing a fence behind the draws
+ *  of the current frame, so the region is not written again
+ *  before the GPU has finished reading it.
+ ***********************************************************/
+void StreamBuffer::EndFrame()
+{
+	if (0 == m_buffer)
+	{
+		return;
+	}
+
+	m_fences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/***********************************************************
+ *  ResetFrameCounters()
+ *
+ *  This method is used for resetting the counters at the
+ *  start of a frame.
+ ***********************************************************/
+void StreamBuffer::ResetFrameCounters()
+{
+	m_stats.bytesWritten = 0;
+	m_stats.fenceWaits = 0;
+}
\ No newline at end of file
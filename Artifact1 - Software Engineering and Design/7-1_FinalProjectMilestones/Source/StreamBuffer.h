@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// streambuffer.h
+// ============
+// ring buffer for data written by the CPU every frame
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  StreamBuffer
+ *
+ *  This class keeps a buffer split into one region per
+ *  frame in flight. Each frame writes into its own region,
+ *  and a fence placed at the end of the frame tells when the
+ *  GPU is done reading the region, so it can be written
+ *  again without stalling on a buffer upload.
+ *
+ *  With OpenGL 4.4 the buffer is created with glBufferStorage
+ *  and stays persistently mapped, so the data is written
+ *  straight into buffer memory. Older contexts write into a
+ *  CPU copy that Flush() uploads with glBufferSubData.
+ ***********************************************************/
+class StreamBuffer
+{
+public:
+	// constructor
+	StreamBuffer();
+	// destructor
+	~StreamBuffer();
+
+	// counters since the last reset
+	struct STREAM_STATS
+	{
+		int bytesWritten;
+		int fenceWaits;
+	};
+
+	// create the buffer with frameCount regions of frameSize bytes
+	void Create(GLsizeiptr frameSize, int frameCount);
+	// unmap and free the buffer
+	void Destroy();
+
+	// wait until the region of the new frame is free to write
+	void BeginFrame();
+	// reserve bytes in the region of the frame, NULL when full
+	void* Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset);
+	// make the data written so far visible to the GPU
+	void Flush();
+	// fence the region once all the draws reading it are issued
+	void EndFrame();
+
+	// buffer object holding all the regions
+	GLuint GetBuffer() const { return(m_buffer); }
+	// true when the buffer is persistently mapped
+	bool IsPersistent() const { return(NULL != m_pMapped); }
+
+	// reset the counters at the start of a frame
+	void ResetFrameCounters();
+	// get the counters of the current frame
+	const STREAM_STATS& GetFrameCounters() const { return(m_stats); }
+
+private:
+	// buffer object holding all the regions
+	GLuint m_buffer;
+	// persistently mapped memory of the buffer, NULL when the
+	// buffer is updated from the CPU copy instead
+	unsigned char* m_pMapped;
+	// CPU copy of the buffer when it is not mapped
+	std::vector<unsigned char> m_staging;
+	// size of one region and the number of regions
+	GLsizeiptr m_frameSize;
+	int m_frameCount;
+	// region written by the current frame
+	int m_frameIndex;
+	// next free byte and first byte not yet flushed, both
+	// relative to the start of the buffer
+	GLintptr m_writeOffset;
+	GLintptr m_flushOffset;
+	// fence of every region, 0 when the region is free
+	std::vector<GLsync> m_fences;
+	// counters of the current frame
+	STREAM_STATS m_stats;
+};
\ No newline at end of file
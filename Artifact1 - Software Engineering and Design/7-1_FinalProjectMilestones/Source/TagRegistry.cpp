@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.cpp
+// ============
+// hashed IDs for the texture and material tags, and their lookup table
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TagRegistry.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// slots of a new table
+	const uint32_t g_InitialSlots = 64;
+	// the table stops growing to move tags to their first
+	// slot at this size, and only grows for its load after
+	const uint32_t g_MaxSlotsForProbing = 1 << 16;
+}
+
+/***********************************************************
+ *  TagRegistry()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TagRegistry::TagRegistry()
+{
+	m_tagCount = 0;
+	m_longestProbe = 0;
+	m_mask = 0;
+	Resize(g_InitialSlots);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every registered tag.
+ ***********************************************************/
+void TagRegistry::Clear()
+{
+	m_tagCount = 0;
+	Resize(g_InitialSlots);
+}
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for mapping a tag to an index. The
+ *  table is grown when it is a quarter full, and while the
+ *  new tag could not take its first slot, so the lookups
+ *  stay at a single slot.
+ ***********************************************************/
+bool TagRegistry::Add(TagID tag, int index)
+{
+	if (-1 != Find(tag))
+	{
+		return(false);
+	}
+
+	TAG_SLOT tagSlot;
+	tagSlot.hash = tag.GetHash();
+	tagSlot.index = index;
+#ifdef _DEBUG
+	tagSlot.name = tag.GetName();
+#endif
+
+	if ((uint32_t)(m_tagCount + 1) * 4 > (uint32_t)m_slots.size())
+	{
+		Resize((uint32_t)m_slots.size() * 2);
+	}
+
+	uint32_t probe = Insert(tagSlot);
+	m_tagCount++;
+	if (probe > m_longestProbe)
+	{
+		m_longestProbe = probe;
+	}
+
+	// try larger tables until every tag sits in its first slot
+	while ((m_longestProbe > 0) && ((uint32_t)m_slots.size() < g_MaxSlotsForProbing))
+	{
+		Resize((uint32_t)m_slots.size() * 2);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Insert()
+ *
+ *  This method is used for putting a slot into the first
+ *  free slot from its hash on.
+ ***********************************************************/
+uint32_t TagRegistry::Insert(const TAG_SLOT& tagSlot)
+{
+	uint32_t probe = 0;
+	while (0 != m_slots[(tagSlot.hash + probe) & m_mask].hash)
+	{
+		probe++;
+	}
+
+	m_slots[(tagSlot.hash + probe) & m_mask] = tagSlot;
+	return(probe);
+}
+
+/***********************************************************
+ *  Resize()
+ *
+ *  This method is used for rebuilding the table with a new
+ *  number of slots, which must be a power of two.
+ ***********************************************************/
+void TagRegistry::Resize(uint32_t slotCount)
+{
+	std::vector<TAG_SLOT> oldSlots;
+	oldSlots.swap(m_slots);
+
+	TAG_SLOT emptySlot;
+	emptySlot.hash = 0;
+	emptySlot.index = -1;
+	m_slots.assign(slotCount, emptySlot);
+	m_mask = slotCount - 1;
+	m_longestProbe = 0;
+
+	for (const TAG_SLOT& tagSlot : oldSlots)
+	{
+		if (0 == tagSlot.hash)
+		{
+			continue;
+		}
+
+		uint32_t probe = Insert(tagSlot);
+		if (probe > m_longestProbe)
+		{
+			m_longestProbe = probe;
+		}
+	}
+}
+
+#ifdef _DEBUG
+/***********************************************************
+ *  CheckName()
+ *
+ *  This method is used for reporting a registered tag that
+ *  shares its hash with a different tag.
+ ***********************************************************/
+void TagRegistry::CheckName(const TAG_SLOT& slot, TagID tag) const
+{
+	if (slot.name.compare(tag.GetName()) != 0)
+	{
+		std::cout << "Tag " << tag.GetName() << " has the same hash as tag " << slot.name << std::endl;
+	}
+}
+#endif
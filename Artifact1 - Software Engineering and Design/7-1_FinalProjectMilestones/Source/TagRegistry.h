@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.h
+// ============
+// hashed IDs for the texture and material tags, and their lookup table
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TagID
+ *
+ *  This class is the 32-bit FNV-1a hash of a texture or
+ *  material tag. The hash is constexpr, so a TagID made from
+ *  a string literal is computed by the compiler and passing
+ *  a tag costs no allocation - a TagID variable declared
+ *  constexpr is always computed at compile time. A hash of 0
+ *  is moved to 1, so 0 can mark an empty registry slot.
+ *
+ *  Debug builds also keep the tag text, so the registry can
+ *  report two tags sharing a hash.
+ ***********************************************************/
+class TagID
+{
+public:
+	constexpr TagID()
+		: m_hash(0)
+#ifdef _DEBUG
+		, m_pName("")
+#endif
+	{
+	}
+
+	// the tag text is only read while the ID is made, except
+	// in debug builds where it must outlive the ID
+	constexpr TagID(const char* tag)
+		: m_hash(Hash(tag))
+#ifdef _DEBUG
+		, m_pName(tag)
+#endif
+	{
+	}
+
+	TagID(const std::string& tag)
+		: TagID(tag.c_str())
+	{
+	}
+
+	constexpr uint32_t GetHash() const { return(m_hash); }
+#ifdef _DEBUG
+	const char* GetName() const { return(m_pName); }
+#endif
+
+	constexpr bool operator==(const TagID& other) const { return(m_hash == other.m_hash); }
+	constexpr bool operator!=(const TagID& other) const { return(m_hash != other.m_hash); }
+
+	// 32-bit FNV-1a hash of a tag, never 0
+	static constexpr uint32_t Hash(const char* tag)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char* pChar = tag; '\0' != *pChar; pChar++)
+		{
+			hash = (hash ^ (uint8_t)*pChar) * 16777619u;
+		}
+		return((0 == hash) ? 1 : hash);
+	}
+
+private:
+	uint32_t m_hash;
+#ifdef _DEBUG
+	const char* m_pName;
+#endif
+};
+
+/***********************************************************
+ *  TagRegistry
+ *
+ *  This class maps tag IDs to indices - texture slots or
+ *  material indices - in an open-addressing table. The table
+ *  size is a power of two and a tag starts at the slot given
+ *  by the low bits of its hash, moving to the next slot when
+ *  that one is taken. The table grows while any tag is out
+ *  of its first slot, up to a size limit, so a lookup almost
+ *  always reads a single slot and compares one integer.
+ *
+ *  Debug builds keep the text of the registered tags and
+ *  report a tag whose hash matches a different tag, on
+ *  registering and on lookup.
+ ***********************************************************/
+class TagRegistry
+{
+public:
+	// constructor
+	TagRegistry();
+
+	// remove every tag
+	void Clear();
+	// map a tag to an index, false when the tag is already
+	// registered, which keeps its first index
+	bool Add(TagID tag, int index);
+	// get the index of a tag, -1 when not registered
+	int Find(TagID tag) const
+	{
+		uint32_t hash = tag.GetHash();
+		for (uint32_t probe = 0; probe <= m_longestProbe; probe++)
+		{
+			const TAG_SLOT& slot = m_slots[(hash + probe) & m_mask];
+			if (slot.hash == hash)
+			{
+#ifdef _DEBUG
+				CheckName(slot, tag);
+#endif
+				return(slot.index);
+			}
+		}
+		return(-1);
+	}
+
+	int GetTagCount() const { return(m_tagCount); }
+
+private:
+	// one table slot, an empty slot has a hash of 0
+	struct TAG_SLOT
+	{
+		uint32_t hash;
+		int index;
+#ifdef _DEBUG
+		std::string name;
+#endif
+	};
+
+	std::vector<TAG_SLOT> m_slots;
+	// table size minus one
+	uint32_t m_mask;
+	// most slots any tag is away from its first slot
+	uint32_t m_longestProbe;
+	int m_tagCount;
+
+	// put a slot into the table without growing it, and get
+	// how far it landed from its first slot
+	uint32_t Insert(const TAG_SLOT& tagSlot);
+	// rebuild the table with a new size
+	void Resize(uint32_t slotCount);
+#ifdef _DEBUG
+	// report a slot holding a different tag with the same hash
+	void CheckName(const TAG_SLOT& slot, TagID tag) const;
+#endif
+};
@@ -0,0 +1,428 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.cpp
+// ============
+// load textures into 2D texture arrays, one array per size and format
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureArrays.h"
+#include "CookedAssets.h"
+
+#include "stb_image.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// the bucket goes in the high bits of a layer reference,
+	// the layer in the low bits
+	const int g_LayerRefBucketShift = 16;
+}
+
+/***********************************************************
+ *  TextureArrays()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureArrays::TextureArrays()
+{
+}
+
+/***********************************************************
+ *  ~TextureArrays()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureArrays::~TextureArrays()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  FindBucket()
+ *
+ *  This method is used for finding the bucket that holds the
+ *  images of the passed in size and format. A new bucket is
+ *  added when no image of the size and format is loaded yet,
+ *  and -1 is returned when every bucket is already taken.
+ ***********************************************************/
+int TextureArrays::FindBucket(int width, int height, int colorChannels)
+{
+	for (int bucket = 0; bucket < (int)m_buckets.size(); bucket++)
+	{
+		const TEXTURE_BUCKET& textureBucket = m_buckets[bucket];
+		if ((textureBucket.width == width) &&
+			(textureBucket.height == height) &&
+			(textureBucket.colorChannels == colorChannels))
+		{
+			return(bucket);
+		}
+	}
+
+	if ((int)m_buckets.size() >= MAX_BUCKETS)
+	{
+		return(-1);
+	}
+
+	TEXTURE_BUCKET textureBucket;
+	textureBucket.width = width;
+	textureBucket.height = height;
+	textureBucket.colorChannels = colorChannels;
+	textureBucket.levelCount = CookedAssets::GetLevelCount(width, height);
+	textureBucket.textureID = 0;
+	m_buckets.push_back(textureBucket);
+
+	return((int)m_buckets.size() - 1);
+}
+
+/***********************************************************
+ *  AddLayer()
+ *
+ *  This method is used for adding an image and its mipmap
+ *  chain as the next layer of the bucket for its size and
+ *  format. The image data is moved out of the passed in
+ *  vector and kept in memory until Upload() creates the
+ *  texture arrays.
+ ***********************************************************/
+bool TextureArrays::AddLayer(
+	const char* filename,
+	bool bCooked,
+	const std::string& tag,
+	int width,
+	int height,
+	int colorChannels,
+	std::vector<unsigned char>& levels)
+{
+	GLint maxLayers = 0;
+
+	if ((3 != colorChannels) && (4 != colorChannels))
+	{
+		std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+		return(false);
+	}
+
+	int bucket = FindBucket(width, height, colorChannels);
+	if (bucket < 0)
+	{
+		std::cout << "No texture bucket left for image:" << filename << std::endl;
+		return(false);
+	}
+
+	TEXTURE_BUCKET& textureBucket = m_buckets[bucket];
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+	if ((int)textureBucket.layers.size() >= maxLayers)
+	{
+		std::cout << "Texture bucket is full for image:" << filename << std::endl;
+		return(false);
+	}
+
+	textureBucket.layers.push_back(std::vector<unsigned char>());
+	textureBucket.layers.back().swap(levels);
+
+	TEXTURE_ENTRY entry;
+	entry.tag = tag;
+	entry.bucket = bucket;
+	entry.layer = (int)textureBucket.layers.size() - 1;
+	entry.filename = filename;
+	entry.fileStamp = CookedAssets::GetFileStamp(filename);
+	entry.bCooked = bCooked;
+	m_textureTags.Add(TagID(entry.tag), (int)m_textures.size());
+	m_textures.push_back(entry);
+
+	return(true);
+}
+
+/***********************************************************
+ *  DecodeImage()
+ *
+ *  This method is used for reading an image file and
+ *  building its mipmap chain.
+ ***********************************************************/
+bool TextureArrays::DecodeImage(
+	const char* filename,
+	int& width,
+	int& height,
+	int& colorChannels,
+	std::vector<unsigned char>& levels)
+{
+	// indicate to always flip images vertically when loaded
+	stbi_set_flip_vertically_on_load(true);
+
+	// try to parse the image data from the specified image file
+	unsigned char* image = stbi_load(
+		filename,
+		&width,
+		&height,
+		&colorChannels,
+		0);
+
+	if (NULL == image)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return(false);
+	}
+
+	std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+
+	// the mipmaps are built the same way the cook tool builds
+	// them, so cooked and source textures look the same
+	levels.assign(image, image + (size_t)width * height * colorChannels);
+	stbi_image_free(image);
+	CookedAssets::BuildMipChain(width, height, colorChannels, levels);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading an image file, building
+ *  its mipmap chain and adding it as the next layer of the
+ *  bucket for its size and format.
+ ***********************************************************/
+bool TextureArrays::Load(const char* filename, const std::string& tag)
+{
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+	std::vector<unsigned char> levels;
+
+	if (false == DecodeImage(filename, width, height, colorChannels, levels))
+	{
+		return(false);
+	}
+
+	return(AddLayer(filename, false, tag, width, height, colorChannels, levels));
+}
+
+/***********************************************************
+ *  LoadCooked()
+ *
+ *  This method is used for reading a texture made by the
+ *  cook tool and adding it as the next layer of the bucket
+ *  for its size and format. The file already holds the
+ *  flipped pixels and every mipmap level, so nothing is
+ *  decoded. The texture is reloaded from the cooked file
+ *  when the cook tool writes it again. False is returned,
+ *  without a message, when there is no usable cooked file.
+ ***********************************************************/
+bool TextureArrays::LoadCooked(const char* filename, const std::string& tag)
+{
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+	std::vector<unsigned char> levels;
+
+	if (false == CookedAssets::ReadTexture(filename, width, height, colorChannels, levels))
+	{
+		return(false);
+	}
+
+	std::cout << "Successfully loaded cooked image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+
+	return(AddLayer(filename, true, tag, width, height, colorChannels, levels));
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for creating a texture array for
+ *  every bucket and copying in the loaded images, with all
+ *  their mipmap levels, as its layers. The image data is
+ *  freed once it is uploaded.
+ ***********************************************************/
+void TextureArrays::Upload()
+{
+	// the rows of RGB images are not padded to four bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (TEXTURE_BUCKET& textureBucket : m_buckets)
+	{
+		GLint internalFormat = GL_RGB8;
+		GLenum format = GL_RGB;
+		if (4 == textureBucket.colorChannels)
+		{
+			internalFormat = GL_RGBA8;
+			format = GL_RGBA;
+		}
+
+		if (0 == textureBucket.textureID)
+		{
+			glGenTextures(1, &textureBucket.textureID);
+		}
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureBucket.textureID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// the mipmaps for mapping textures to lower resolutions
+		// were built when the images were loaded or cooked
+		size_t levelOffset = 0;
+		for (int level = 0; level < textureBucket.levelCount; level++)
+		{
+			int levelWidth = (textureBucket.width >> level > 0) ? (textureBucket.width >> level) : 1;
+			int levelHeight = (textureBucket.height >> level > 0) ? (textureBucket.height >> level) : 1;
+
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat,
+				levelWidth, levelHeight,
+				(GLsizei)textureBucket.layers.size(),
+				0, format, GL_UNSIGNED_BYTE, NULL);
+			for (int layer = 0; layer < (int)textureBucket.layers.size(); layer++)
+			{
+				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level,
+					0, 0, layer,
+					levelWidth, levelHeight, 1,
+					format, GL_UNSIGNED_BYTE,
+					textureBucket.layers[layer].data() + levelOffset);
+			}
+
+			levelOffset += CookedAssets::GetLevelSize(textureBucket.width, textureBucket.height, textureBucket.colorChannels, level);
+		}
+
+		textureBucket.layers.clear();
+		textureBucket.layers.shrink_to_fit();
+	}
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+/***********************************************************
+ *  ReloadChanged()
+ *
+ *  This method is used for loading every texture whose file
+ *  was written since it was loaded again, straight into its
+ *  layer of the uploaded texture array. A cooked texture is
+ *  read again from the cooked file, which the build step
+ *  writes when the image is saved, so only a texture loaded
+ *  from its image is decoded again. The other layers
+ *  and the layer references stay as they are. A texture
+ *  whose new image has a different size or format would
+ *  need another bucket, so it is left alone until the next
+ *  start.
+ ***********************************************************/
+int TextureArrays::ReloadChanged()
+{
+	int reloadedCount = 0;
+
+	for (TEXTURE_ENTRY& entry : m_textures)
+	{
+		CookedAssets::FILE_STAMP fileStamp = CookedAssets::GetFileStamp(entry.filename.c_str());
+		if ((0 == fileStamp.writeTime) || (true == CookedAssets::IsSameStamp(fileStamp, entry.fileStamp)))
+		{
+			continue;
+		}
+
+		int width = 0;
+		int height = 0;
+		int colorChannels = 0;
+		std::vector<unsigned char> levels;
+		bool bRead = (true == entry.bCooked) ?
+			CookedAssets::ReadTexture(entry.filename.c_str(), width, height, colorChannels, levels) :
+			DecodeImage(entry.filename.c_str(), width, height, colorChannels, levels);
+		if (false == bRead)
+		{
+			// the file may still be being written, so it is
+			// tried again on the next call
+			continue;
+		}
+		entry.fileStamp = fileStamp;
+
+		const TEXTURE_BUCKET& textureBucket = m_buckets[entry.bucket];
+		if ((textureBucket.width != width) ||
+			(textureBucket.height != height) ||
+			(textureBucket.colorChannels != colorChannels) ||
+			(0 == textureBucket.textureID))
+		{
+			std::cout << "Image changed size or format, restart to reload it:" << entry.filename << std::endl;
+			continue;
+		}
+
+		GLenum format = (4 == colorChannels) ? GL_RGBA : GL_RGB;
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureBucket.textureID);
+
+		size_t levelOffset = 0;
+		for (int level = 0; level < textureBucket.levelCount; level++)
+		{
+			int levelWidth = (width >> level > 0) ? (width >> level) : 1;
+			int levelHeight = (height >> level > 0) ? (height >> level) : 1;
+
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level,
+				0, 0, entry.layer,
+				levelWidth, levelHeight, 1,
+				format, GL_UNSIGNED_BYTE,
+				levels.data() + levelOffset);
+
+			levelOffset += CookedAssets::GetLevelSize(width, height, colorChannels, level);
+		}
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		reloadedCount++;
+	}
+
+	return(reloadedCount);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the texture arrays.
+ ***********************************************************/
+void TextureArrays::Destroy()
+{
+	for (TEXTURE_BUCKET& textureBucket : m_buckets)
+	{
+		if (0 != textureBucket.textureID)
+		{
+			glDeleteTextures(1, &textureBucket.textureID);
+			textureBucket.textureID = 0;
+		}
+	}
+	m_buckets.clear();
+	m_textures.clear();
+	m_textureTags.Clear();
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for binding every bucket to its own
+ *  texture unit, starting from the passed in unit. The
+ *  bucket index is the offset from the first unit.
+ ***********************************************************/
+void TextureArrays::Bind(int firstTextureUnit) const
+{
+	for (int bucket = 0; bucket < (int)m_buckets.size(); bucket++)
+	{
+		glActiveTexture(GL_TEXTURE0 + firstTextureUnit + bucket);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_buckets[bucket].textureID);
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  GetLayerRef()
+ *
+ *  This method is used for getting the layer reference the
+ *  shaders use to sample a texture - the bucket in the high
+ *  bits and the layer in the low bits. -1 is returned for an
+ *  index that is not a loaded texture, which the shaders
+ *  treat as no texture.
+ ***********************************************************/
+int TextureArrays::GetLayerRef(int texture) const
+{
+	if ((texture < 0) || (texture >= (int)m_textures.size()))
+	{
+		return(-1);
+	}
+
+	const TEXTURE_ENTRY& entry = m_textures[texture];
+	return((entry.bucket << g_LayerRefBucketShift) | entry.layer);
+}
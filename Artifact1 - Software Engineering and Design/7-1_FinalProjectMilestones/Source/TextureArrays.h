@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.h
+// ============
+// load textures into 2D texture arrays, one array per size and format
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include "CookedAssets.h"
+#include "TagRegistry.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureArrays
+ *
+ *  This class loads the scene textures into buckets - one
+ *  GL_TEXTURE_2D_ARRAY per image size and format - and gives
+ *  every texture a layer reference that the shaders use to
+ *  pick its bucket and layer. All the buckets stay bound at
+ *  the same time, so a draw selects its texture with a plain
+ *  integer instead of a texture binding, and draws with
+ *  different textures can share one draw call.
+ *
+ *  The number of buckets must not exceed the
+ *  MAX_TEXTURE_BUCKETS define in the fragment shader.
+ ***********************************************************/
+class TextureArrays
+{
+public:
+	// constructor
+	TextureArrays();
+	// destructor
+	~TextureArrays();
+
+	// most buckets, each one takes a texture unit
+	static const int MAX_BUCKETS = 8;
+
+	// load an image file into the bucket of its size and format
+	bool Load(const char* filename, const std::string& tag);
+	// load a texture made by the cook tool, already decoded
+	// and with its mipmaps
+	bool LoadCooked(const char* filename, const std::string& tag);
+	// create the texture arrays from the loaded images
+	void Upload();
+	// load the textures whose files changed since they were
+	// loaded into their layers again, and get how many were
+	int ReloadChanged();
+	// free the texture arrays
+	void Destroy();
+
+	// bind the buckets to consecutive texture units
+	void Bind(int firstTextureUnit) const;
+
+	// get the index of the texture with the tag, -1 when not loaded
+	int FindTexture(TagID tag) const { return(m_textureTags.Find(tag)); }
+	// get the layer reference of a texture, -1 for no texture
+	int GetLayerRef(int texture) const;
+	// get the tag a texture was loaded with
+	const std::string& GetTag(int texture) const { return(m_textures[texture].tag); }
+
+	// number of loaded textures and of buckets holding them
+	int GetTextureCount() const { return((int)m_textures.size()); }
+	int GetBucketCount() const { return((int)m_buckets.size()); }
+
+private:
+	// one texture array holding every image of a size and format
+	struct TEXTURE_BUCKET
+	{
+		int width;
+		int height;
+		int colorChannels;
+		int levelCount;
+		// image data of every layer, all the mipmap levels of a
+		// layer one after the other, freed once uploaded
+		std::vector<std::vector<unsigned char>> layers;
+		GLuint textureID;
+	};
+
+	// where a loaded texture lives
+	struct TEXTURE_ENTRY
+	{
+		std::string tag;
+		int bucket;
+		int layer;
+		// file the texture is reloaded from, and its last write
+		// time and size
+		std::string filename;
+		CookedAssets::FILE_STAMP fileStamp;
+		// the file is a cooked texture rather than an image
+		bool bCooked;
+	};
+
+	std::vector<TEXTURE_BUCKET> m_buckets;
+	std::vector<TEXTURE_ENTRY> m_textures;
+	// index of every loaded texture by tag
+	TagRegistry m_textureTags;
+
+	// find the bucket of a size and format, adding it when new
+	int FindBucket(int width, int height, int colorChannels);
+	// read an image file and build its mipmap chain
+	static bool DecodeImage(
+		const char* filename,
+		int& width,
+		int& height,
+		int& colorChannels,
+		std::vector<unsigned char>& levels);
+	// add an image and its mipmaps as the next layer of its bucket
+	bool AddLayer(
+		const char* filename,
+		bool bCooked,
+		const std::string& tag,
+		int width,
+		int height,
+		int colorChannels,
+		std::vector<unsigned char>& levels);
+};
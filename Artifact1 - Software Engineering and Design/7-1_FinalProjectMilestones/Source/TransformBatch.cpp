@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbatch.cpp
+// ============
+// compose the model matrices of many objects at once from separate
+// position, rotation and scale arrays
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformBatch.h"
+
+#include <cmath>
+
+// SSE2 is always there on x64, other targets use the scalar path
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define TRANSFORM_BATCH_SSE 1
+#include <emmintrin.h>
+#else
+#define TRANSFORM_BATCH_SSE 0
+#endif
+
+// declaration of global variables
+namespace
+{
+	const float g_DegreesToRadians = 3.14159265358979f / 180.0f;
+
+#if TRANSFORM_BATCH_SSE
+	/***********************************************************
+	 *  SinCos4()
+	 *
+	 *  This function is used for computing the sine and cosine
+	 *  of four angles in radians. The angles are reduced to a
+	 *  quarter turn around 0, where short polynomials are
+	 *  accurate to about 1e-7, and the quarter picks the signs
+	 *  and whether sine and cosine are swapped.
+	 ***********************************************************/
+	void SinCos4(__m128 angle, __m128& sine, __m128& cosine)
+	{
+		// nearest quarter turn, with pi / 2 split in two parts
+		// so the reduced angle keeps its precision
+		__m128i quarter = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(0.636619772f)));
+		__m128 quarterF = _mm_cvtepi32_ps(quarter);
+		__m128 x = _mm_sub_ps(angle, _mm_mul_ps(quarterF, _mm_set1_ps(1.57079637f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(quarterF, _mm_set1_ps(-4.37113883e-8f)));
+
+		__m128 x2 = _mm_mul_ps(x, x);
+
+		// sin(x) = x - x^3/3! + x^5/5! - x^7/7!
+		__m128 sinX = _mm_set1_ps(-1.98412698e-4f);
+		sinX = _mm_add_ps(_mm_mul_ps(sinX, x2), _mm_set1_ps(8.33333333e-3f));
+		sinX = _mm_add_ps(_mm_mul_ps(sinX, x2), _mm_set1_ps(-1.66666667e-1f));
+		sinX = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinX, x2), x), x);
+
+		// cos(x) = 1 - x^2/2! + x^4/4! - x^6/6! + x^8/8!
+		__m128 cosX = _mm_set1_ps(2.48015873e-5f);
+		cosX = _mm_add_ps(_mm_mul_ps(cosX, x2), _mm_set1_ps(-1.38888889e-3f));
+		cosX = _mm_add_ps(_mm_mul_ps(cosX, x2), _mm_set1_ps(4.16666667e-2f));
+		cosX = _mm_add_ps(_mm_mul_ps(cosX, x2), _mm_set1_ps(-0.5f));
+		cosX = _mm_add_ps(_mm_mul_ps(cosX, x2), _mm_set1_ps(1.0f));
+
+		// odd quarters swap sine and cosine, and the sign bits
+		// come from bit 1 of the quarter for the sine and of the
+		// next quarter for the cosine
+		__m128i one = _mm_set1_epi32(1);
+		__m128i two = _mm_set1_epi32(2);
+		__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quarter, one), one));
+		__m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quarter, two), 30));
+		__m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quarter, one), two), 30));
+
+		sine = _mm_or_ps(_mm_and_ps(swap, cosX), _mm_andnot_ps(swap, sinX));
+		cosine = _mm_or_ps(_mm_and_ps(swap, sinX), _mm_andnot_ps(swap, cosX));
+		sine = _mm_xor_ps(sine, sineSign);
+		cosine = _mm_xor_ps(cosine, cosineSign);
+	}
+
+	/***********************************************************
+	 *  StoreColumn4()
+	 *
+	 *  This function is used for writing one column of four
+	 *  matrices. The registers hold the same row of the four
+	 *  objects, so they are transposed into one column each.
+	 ***********************************************************/
+	void StoreColumn4(glm::mat4* pMatrices, int column, __m128 x, __m128 y, __m128 z, __m128 w)
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(&pMatrices[0][column][0], x);
+		_mm_storeu_ps(&pMatrices[1][column][0], y);
+		_mm_storeu_ps(&pMatrices[2][column][0], z);
+		_mm_storeu_ps(&pMatrices[3][column][0], w);
+	}
+#endif
+}
+
+/***********************************************************
+ *  TransformBatch()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformBatch::TransformBatch()
+{
+}
+
+/***********************************************************
+ *  ~TransformBatch()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransformBatch::~TransformBatch()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the objects. The
+ *  arrays keep their memory for the next batch.
+ ***********************************************************/
+void TransformBatch::Clear()
+{
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_rotationX.clear();
+	m_rotationY.clear();
+	m_rotationZ.clear();
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for the passed in
+ *  number of objects in every array.
+ ***********************************************************/
+void TransformBatch::Reserve(int count)
+{
+	m_positionX.reserve(count);
+	m_positionY.reserve(count);
+	m_positionZ.reserve(count);
+	m_rotationX.reserve(count);
+	m_rotationY.reserve(count);
+	m_rotationZ.reserve(count);
+	m_scaleX.reserve(count);
+	m_scaleY.reserve(count);
+	m_scaleZ.reserve(count);
+}
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for appending an object to the batch.
+ ***********************************************************/
+int TransformBatch::Add(const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ)
+{
+	m_positionX.push_back(positionXYZ.x);
+	m_positionY.push_back(positionXYZ.y);
+	m_positionZ.push_back(positionXYZ.z);
+	m_rotationX.push_back(rotationDegrees.x);
+	m_rotationY.push_back(rotationDegrees.y);
+	m_rotationZ.push_back(rotationDegrees.z);
+	m_scaleX.push_back(scaleXYZ.x);
+	m_scaleY.push_back(scaleXYZ.y);
+	m_scaleZ.push_back(scaleXYZ.z);
+
+	return((int)m_positionX.size() - 1);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  This method is used for changing the transformation
+ *  values of an object already in the batch.
+ ***********************************************************/
+void TransformBatch::Set(int index, const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ)
+{
+	if ((index < 0) || (index >= GetCount()))
+	{
+		return;
+	}
+
+	m_positionX[index] = positionXYZ.x;
+	m_positionY[index] = positionXYZ.y;
+	m_positionZ[index] = positionXYZ.z;
+	m_rotationX[index] = rotationDegrees.x;
+	m_rotationY[index] = rotationDegrees.y;
+	m_rotationZ[index] = rotationDegrees.z;
+	m_scaleX[index] = scaleXYZ.x;
+	m_scaleY[index] = scaleXYZ.y;
+	m_scaleZ[index] = scaleXYZ.z;
+}
+
+/***********************************************************
+ *  ComposeMatrix()
+ *
+ *  This method is used for composing the model matrix of a
+ *  single object. The rotation matrices are multiplied out
+ *  by hand, so the matrix is written directly instead of
+ *  multiplying five full matrices together.
+ ***********************************************************/
+glm::mat4 TransformBatch::ComposeMatrix(const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ)
+{
+	float sx = std::sin(rotationDegrees.x * g_DegreesToRadians);
+	float cx = std::cos(rotationDegrees.x * g_DegreesToRadians);
+	float sy = std::sin(rotationDegrees.y * g_DegreesToRadians);
+	float cy = std::cos(rotationDegrees.y * g_DegreesToRadians);
+	float sz = std::sin(rotationDegrees.z * g_DegreesToRadians);
+	float cz = std::cos(rotationDegrees.z * g_DegreesToRadians);
+
+	glm::mat4 model;
+	model[0] = glm::vec4(cy * cz, cy * sz, -sy, 0.0f) * scaleXYZ.x;
+	model[1] = glm::vec4(sx * sy * cz - cx * sz, sx * sy * sz + cx * cz, sx * cy, 0.0f) * scaleXYZ.y;
+	model[2] = glm::vec4(cx * sy * cz + sx * sz, cx * sy * sz - sx * cz, cx * cy, 0.0f) * scaleXYZ.z;
+	model[3] = glm::vec4(positionXYZ, 1.0f);
+
+	return(model);
+}
+
+/***********************************************************
+ *  ComputeMatrices()
+ *
+ *  This method is used for writing the model matrix of every
+ *  object into the passed in array, which must hold one
+ *  matrix per object. The columns are those of
+ *  ComposeMatrix() - R = Rz * Ry * Rx scaled per column,
+ *  with the position in the last column.
+ ***********************************************************/
+void TransformBatch::ComputeMatrices(glm::mat4* pMatrices) const
+{
+	ComputeMatrices(pMatrices, 0, GetCount());
+}
+
+/***********************************************************
+ *  ComputeMatrices()
+ *
+ *  This method is used for writing the model matrices of a
+ *  range of the objects, so the batch can be split across
+ *  threads. The matrix of an object goes to its own index
+ *  of the passed in array.
+ ***********************************************************/
+void TransformBatch::ComputeMatrices(glm::mat4* pMatrices, int begin, int end) const
+{
+	int i = begin;
+
+#if TRANSFORM_BATCH_SSE
+	const __m128 toRadians = _mm_set1_ps(g_DegreesToRadians);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 sx, cx, sy, cy, sz, cz;
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(&m_rotationX[i]), toRadians), sx, cx);
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(&m_rotationY[i]), toRadians), sy, cy);
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(&m_rotationZ[i]), toRadians), sz, cz);
+
+		__m128 scaleX = _mm_loadu_ps(&m_scaleX[i]);
+		__m128 scaleY = _mm_loadu_ps(&m_scaleY[i]);
+		__m128 scaleZ = _mm_loadu_ps(&m_scaleZ[i]);
+		__m128 sxsy = _mm_mul_ps(sx, sy);
+		__m128 cxsy = _mm_mul_ps(cx, sy);
+
+		// first column
+		__m128 m00 = _mm_mul_ps(_mm_mul_ps(cy, cz), scaleX);
+		__m128 m01 = _mm_mul_ps(_mm_mul_ps(cy, sz), scaleX);
+		__m128 m02 = _mm_mul_ps(_mm_sub_ps(zero, sy), scaleX);
+		StoreColumn4(&pMatrices[i], 0, m00, m01, m02, zero);
+
+		// second column
+		__m128 m10 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sxsy, cz), _mm_mul_ps(cx, sz)), scaleY);
+		__m128 m11 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sxsy, sz), _mm_mul_ps(cx, cz)), scaleY);
+		__m128 m12 = _mm_mul_ps(_mm_mul_ps(sx, cy), scaleY);
+		StoreColumn4(&pMatrices[i], 1, m10, m11, m12, zero);
+
+		// third column
+		__m128 m20 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cxsy, cz), _mm_mul_ps(sx, sz)), scaleZ);
+		__m128 m21 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cxsy, sz), _mm_mul_ps(sx, cz)), scaleZ);
+		__m128 m22 = _mm_mul_ps(_mm_mul_ps(cx, cy), scaleZ);
+		StoreColumn4(&pMatrices[i], 2, m20, m21, m22, zero);
+
+		// position column
+		StoreColumn4(
+			&pMatrices[i],
+			3,
+			_mm_loadu_ps(&m_positionX[i]),
+			_mm_loadu_ps(&m_positionY[i]),
+			_mm_loadu_ps(&m_positionZ[i]),
+			one);
+	}
+#endif
+
+	// the objects left over from the groups of four
+	for (; i < end; i++)
+	{
+		pMatrices[i] = ComposeMatrix(
+			glm::vec3(m_scaleX[i], m_scaleY[i], m_scaleZ[i]),
+			glm::vec3(m_rotationX[i], m_rotationY[i], m_rotationZ[i]),
+			glm::vec3(m_positionX[i], m_positionY[i], m_positionZ[i]));
+	}
+}
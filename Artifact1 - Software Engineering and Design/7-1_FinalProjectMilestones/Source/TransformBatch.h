@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbatch.h
+// ============
+// compose the model matrices of many objects at once from separate
+// position, rotation and scale arrays
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  TransformBatch
+ *
+ *  This class keeps the scale, rotation and position of many
+ *  objects as structure of arrays - one contiguous float
+ *  array per component - and turns them into column-major
+ *  model matrices. With SSE2 the matrices of four objects
+ *  are composed at a time, so every load fills a register
+ *  with the same component of four objects.
+ *
+ *  The matrices match the ones built by the glm calls in
+ *  SceneManager::ComposeTransformations() - scale, then the
+ *  X, Y and Z rotations in degrees, then the position.
+ ***********************************************************/
+class TransformBatch
+{
+public:
+	// constructor
+	TransformBatch();
+	// destructor
+	~TransformBatch();
+
+	// remove all the objects
+	void Clear();
+	// make room for a number of objects
+	void Reserve(int count);
+	// append an object and get its index
+	int Add(const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ);
+	// change the transformation values of an object
+	void Set(int index, const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ);
+	// number of objects in the batch
+	int GetCount() const { return((int)m_positionX.size()); }
+
+	// write the model matrix of every object, in order
+	void ComputeMatrices(glm::mat4* pMatrices) const;
+	// write the model matrices of the objects from begin up
+	// to, not including, end, each at its own index
+	void ComputeMatrices(glm::mat4* pMatrices, int begin, int end) const;
+
+	// compose the model matrix of a single object
+	static glm::mat4 ComposeMatrix(const glm::vec3& scaleXYZ, const glm::vec3& rotationDegrees, const glm::vec3& positionXYZ);
+
+private:
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+	std::vector<float> m_rotationX;
+	std::vector<float> m_rotationY;
+	std::vector<float> m_rotationZ;
+	std::vector<float> m_scaleX;
+	std::vector<float> m_scaleY;
+	std::vector<float> m_scaleZ;
+};
@@ -1,46 +1,68 @@
-///////////////////////////////////////////////////////////////////////////////
-// viewmanager.h
-// ============
-// manage the viewing of 3D objects within the viewport - camera, projection
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "camera.h"
-
-// GLFW library
-#include "GLFW/glfw3.h" 
-
-class ViewManager
-{
-public:
-	// constructor
-	ViewManager(
-		ShaderManager* pShaderManager);
-	// destructor
-	~ViewManager();
-
-	// mouse position callback for mouse interaction with the 3D scene
-	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
-	// mouse wheel scrolling callback for mouse interaction with the 3D scene
-	static void Mouse_Wheel_Callback(GLFWwindow* window, double x, double yScrollDistance);
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// active OpenGL display window
-	GLFWwindow* m_pWindow;
-
-	// process keyboard events for interaction with the 3D scene
-	void ProcessKeyboardEvents();
-
-public:
-	// create the initial OpenGL display window
-	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
-	
-	// prepare the conversion from 3D object display to 2D scene display
-	void PrepareSceneView();
+///////////////////////////////////////////////////////////////////////////////
+// viewmanager.h
+// ============
+// manage the viewing of 3D objects within the viewport - camera, projection
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "camera.h"
+
+// GLFW library
+#include "GLFW/glfw3.h" 
+
+class ViewManager
+{
+public:
+	// constructor
+	ViewManager(
+		ShaderManager* pShaderManager,
+		ShaderUniforms* pShaderUniforms);
+	// destructor
+	~ViewManager();
+
+	// mouse position callback for mouse interaction with the 3D scene
+	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
+	// mouse wheel scrolling callback for mouse interaction with the 3D scene
+	static void Mouse_Wheel_Callback(GLFWwindow* window, double x, double yScrollDistance);
+	// framebuffer size callback for keeping the viewport size
+	static void Framebuffer_Size_Callback(GLFWwindow* window, int width, int height);
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to the uniform location table of the shader program
+	ShaderUniforms* m_pShaderUniforms;
+	// handles of the uniforms set for every frame
+	UniformHandle<glm::mat4> m_viewUniform;
+	UniformHandle<glm::mat4> m_projectionUniform;
+	UniformHandle<glm::vec3> m_viewPositionUniform;
+	// active OpenGL display window
+	GLFWwindow* m_pWindow;
+	// matrices and clip planes set by the last PrepareSceneView()
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	float m_nearPlane;
+	float m_farPlane;
+
+	// process keyboard events for interaction with the 3D scene
+	void ProcessKeyboardEvents();
+
+public:
+	// create the initial OpenGL display window
+	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
+	
+	// prepare the conversion from 3D object display to 2D scene display
+	void PrepareSceneView();
+
+	// get the view setup of the current frame
+	const glm::mat4& GetViewMatrix() const { return(m_viewMatrix); }
+	const glm::mat4& GetProjectionMatrix() const { return(m_projectionMatrix); }
+	float GetNearPlane() const { return(m_nearPlane); }
+	float GetFarPlane() const { return(m_farPlane); }
+	glm::ivec2 GetViewportSize() const;
 };
\ No newline at end of file
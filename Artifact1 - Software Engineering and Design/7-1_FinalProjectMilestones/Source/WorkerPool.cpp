@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+// workerpool.cpp
+// ============
+// split per-frame CPU work into chunks processed on worker threads
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WorkerPool.h"
+
+/***********************************************************
+ *  WorkerPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+WorkerPool::WorkerPool()
+{
+	m_bStop = false;
+	m_pTask = NULL;
+	m_count = 0;
+	m_chunkSize = 1;
+	m_chunkCount = 0;
+	m_generation = 0;
+	m_nextChunk = 0;
+	m_chunksDone = 0;
+	m_activeWorkers = 0;
+}
+
+/***********************************************************
+ *  ~WorkerPool()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+WorkerPool::~WorkerPool()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the worker threads. The
+ *  calling thread works on the chunks as well, so with the
+ *  default count every hardware thread has one thread.
+ ***********************************************************/
+void WorkerPool::Start(int threadCount)
+{
+	Stop();
+
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+
+	m_bStop = false;
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_threads.push_back(std::thread(&WorkerPool::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for stopping the worker threads and
+ *  waiting for them to exit.
+ ***********************************************************/
+void WorkerPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+	}
+	m_wakeWorkers.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+	m_threads.clear();
+}
+
+/***********************************************************
+ *  RunChunks()
+ *
+ *  This method is used for taking chunks of the current
+ *  range until they are all taken.
+ ***********************************************************/
+void WorkerPool::RunChunks(const CHUNK_TASK& task, int count, int chunkSize, int chunkCount)
+{
+	int chunk = m_nextChunk.fetch_add(1);
+	while (chunk < chunkCount)
+	{
+		int begin = chunk * chunkSize;
+		int end = (begin + chunkSize < count) ? (begin + chunkSize) : count;
+		task(begin, end);
+
+		m_chunksDone.fetch_add(1);
+		chunk = m_nextChunk.fetch_add(1);
+	}
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for running a worker thread. The
+ *  worker sleeps until a new range is posted, takes its
+ *  chunks along with the other threads and then reports back
+ *  to the caller.
+ ***********************************************************/
+void WorkerPool::WorkerLoop()
+{
+	unsigned int seenGeneration = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		seenGeneration = m_generation;
+	}
+
+	while (true)
+	{
+		const CHUNK_TASK* pTask = NULL;
+		int count = 0;
+		int chunkSize = 1;
+		int chunkCount = 0;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeWorkers.wait(lock, [&]() { return((true == m_bStop) || (seenGeneration != m_generation)); });
+			if (true == m_bStop)
+			{
+				return;
+			}
+
+			// the range is copied under the lock, and the caller
+			// waits for the active workers before posting another
+			seenGeneration = m_generation;
+			pTask = m_pTask;
+			count = m_count;
+			chunkSize = m_chunkSize;
+			chunkCount = m_chunkCount;
+			m_activeWorkers++;
+		}
+
+		// a worker waking after the caller has returned finds
+		// no task and no chunks left
+		if (NULL != pTask)
+		{
+			RunChunks(*pTask, count, chunkSize, chunkCount);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_activeWorkers--;
+		}
+		m_workDone.notify_all();
+	}
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running the passed in task over
+ *  the items from 0 up to count, in chunks of chunkSize
+ *  items. The calling thread works on the chunks too, and
+ *  the method returns once every chunk is done.
+ ***********************************************************/
+void WorkerPool::ParallelFor(int count, int chunkSize, const CHUNK_TASK& task)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+	if (chunkSize < 1)
+	{
+		chunkSize = 1;
+	}
+
+	int chunkCount = GetChunkCount(count, chunkSize);
+
+	// a single chunk is not worth waking the workers for
+	if ((true == m_threads.empty()) || (1 == chunkCount))
+	{
+		for (int begin = 0; begin < count; begin += chunkSize)
+		{
+			task(begin, (begin + chunkSize < count) ? (begin + chunkSize) : count);
+		}
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		// a worker still leaving the last range must be gone
+		// before the counters are reset
+		m_workDone.wait(lock, [&]() { return(0 == m_activeWorkers); });
+
+		m_pTask = &task;
+		m_count = count;
+		m_chunkSize = chunkSize;
+		m_chunkCount = chunkCount;
+		m_nextChunk = 0;
+		m_chunksDone = 0;
+		m_generation++;
+	}
+	m_wakeWorkers.notify_all();
+
+	RunChunks(task, count, chunkSize, chunkCount);
+
+	// the task must outlive every worker that picked it up
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_workDone.wait(lock, [&]() { return((m_chunksDone.load() == chunkCount) && (0 == m_activeWorkers)); });
+		m_pTask = NULL;
+	}
+}
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// workerpool.h
+// ============
+// split per-frame CPU work into chunks processed on worker threads
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  WorkerPool
+ *
+ *  This class keeps a set of worker threads waiting for
+ *  work. ParallelFor() cuts a range of items into chunks of
+ *  a fixed size and the workers, together with the calling
+ *  thread, take chunks until none are left. The call only
+ *  returns once every chunk is done, so the caller can use
+ *  the results right away.
+ *
+ *  The chunks are always cut the same way for the same
+ *  count and chunk size, so the index of a chunk can be
+ *  found from its first item, and a second pass over the
+ *  same range sees the same chunks.
+ ***********************************************************/
+class WorkerPool
+{
+public:
+	// work on the items from begin up to, not including, end
+	typedef std::function<void(int begin, int end)> CHUNK_TASK;
+
+	// constructor
+	WorkerPool();
+	// destructor
+	~WorkerPool();
+
+	// start the worker threads, 0 for one less than the
+	// hardware threads so the calling thread has a core
+	void Start(int threadCount);
+	// stop and join the worker threads
+	void Stop();
+
+	// threads working on a ParallelFor(), the caller included
+	int GetThreadCount() const { return((int)m_threads.size() + 1); }
+
+	// run the task over the range in chunks and wait for it
+	void ParallelFor(int count, int chunkSize, const CHUNK_TASK& task);
+
+	// number of chunks ParallelFor() cuts a range into
+	static int GetChunkCount(int count, int chunkSize) { return((count + chunkSize - 1) / chunkSize); }
+
+private:
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	// signals the workers that a new range is ready, or to stop
+	std::condition_variable m_wakeWorkers;
+	// signals the caller that the workers are done
+	std::condition_variable m_workDone;
+	bool m_bStop;
+
+	// the range being worked on
+	const CHUNK_TASK* m_pTask;
+	int m_count;
+	int m_chunkSize;
+	int m_chunkCount;
+	// counts up with every range, so a worker sees new work
+	unsigned int m_generation;
+	std::atomic<int> m_nextChunk;
+	std::atomic<int> m_chunksDone;
+	// workers that picked up the current range
+	int m_activeWorkers;
+
+	// take chunks of the current range until none are left
+	void RunChunks(const CHUNK_TASK& task, int count, int chunkSize, int chunkCount);
+	// wait for ranges and work on them
+	void WorkerLoop();
+};
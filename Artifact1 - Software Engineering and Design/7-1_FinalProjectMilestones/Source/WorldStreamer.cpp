@@ -0,0 +1,557 @@
+///////////////////////////////////////////////////////////////////////////////
+// worldstreamer.cpp
+// ============
+// load and unload fixed size chunks of a large world around the camera
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WorldStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+/***********************************************************
+ *  WorldStreamer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+WorldStreamer::WorldStreamer()
+{
+	m_settings = GetDefaultSettings();
+	m_stats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	m_bStop = false;
+}
+
+/***********************************************************
+ *  ~WorldStreamer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+WorldStreamer::~WorldStreamer()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  GetDefaultSettings()
+ *
+ *  This method is used for getting the settings of chunks
+ *  a little over two city blocks wide, loaded within three
+ *  chunks of the camera and kept up to four, in at most
+ *  64 MB.
+ ***********************************************************/
+WorldStreamer::STREAM_SETTINGS WorldStreamer::GetDefaultSettings()
+{
+	STREAM_SETTINGS settings;
+	settings.chunkSize = 32.0f;
+	settings.loadRadius = 96.0f;
+	settings.unloadRadius = 128.0f;
+	settings.budgetBytes = 64 * 1024 * 1024;
+	settings.loaderThreads = 2;
+	settings.maxUploadsPerUpdate = 2;
+
+	return(settings);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for stopping the loader threads and
+ *  removing every chunk, item, template and mesh.
+ ***********************************************************/
+void WorldStreamer::Clear()
+{
+	Stop();
+
+	m_meshes.clear();
+	m_templates.clear();
+	m_templateBytes.clear();
+	m_items.clear();
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for stopping the loader threads and
+ *  freeing the merged meshes of every chunk. It must be
+ *  called on the thread owning the OpenGL context.
+ ***********************************************************/
+void WorldStreamer::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+	}
+	m_wakeLoaders.notify_all();
+
+	for (std::thread& loader : m_loaders)
+	{
+		loader.join();
+	}
+	m_loaders.clear();
+	m_bStop = false;
+
+	for (std::pair<int, StaticGeometryBake*>& merged : m_mergedChunks)
+	{
+		delete merged.second;
+	}
+	m_mergedChunks.clear();
+	m_queuedChunks.clear();
+
+	for (STREAM_CHUNK& chunk : m_chunks)
+	{
+		if (NULL != chunk.pBake)
+		{
+			delete chunk.pBake;
+		}
+	}
+	m_chunks.clear();
+	m_loadedChunks.clear();
+	m_stats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+}
+
+/***********************************************************
+ *  SetMesh()
+ *
+ *  This method is used for keeping a copy of a basic shape
+ *  mesh, which the loader threads read while merging.
+ ***********************************************************/
+void WorldStreamer::SetMesh(int meshID, const MeshGeometry::MESH_DATA& mesh)
+{
+	if (meshID >= (int)m_meshes.size())
+	{
+		m_meshes.resize(meshID + 1);
+	}
+	m_meshes[meshID] = mesh;
+}
+
+/***********************************************************
+ *  AddTemplate()
+ *
+ *  This method is used for adding a template without any
+ *  parts. The index counts up from 0.
+ ***********************************************************/
+int WorldStreamer::AddTemplate()
+{
+	m_templates.push_back(std::vector<TEMPLATE_PART>());
+	return((int)m_templates.size() - 1);
+}
+
+/***********************************************************
+ *  AddTemplatePart()
+ *
+ *  This method is used for adding one mesh to a template.
+ ***********************************************************/
+void WorldStreamer::AddTemplatePart(
+	int templateIndex,
+	int meshID,
+	const glm::mat4& localModel,
+	const glm::vec2& UVscale,
+	const StaticGeometryBake::BAKE_KEY& key)
+{
+	TEMPLATE_PART part;
+	part.meshID = meshID;
+	part.localModel = localModel;
+	part.UVscale = UVscale;
+	part.key = key;
+	m_templates[templateIndex].push_back(part);
+}
+
+/***********************************************************
+ *  AddItem()
+ *
+ *  This method is used for placing a template in the world.
+ ***********************************************************/
+void WorldStreamer::AddItem(int templateIndex, const glm::mat4& model)
+{
+	STREAM_ITEM item;
+	item.templateIndex = templateIndex;
+	item.model = model;
+	m_items.push_back(item);
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for laying the chunk grid over the
+ *  positions of the items, sorting the items by chunk so
+ *  the items of a chunk are one run, and starting the
+ *  loader threads. The bytes of every chunk are counted
+ *  from its templates here, so the budget is kept without
+ *  merging a chunk first.
+ ***********************************************************/
+void WorldStreamer::Start(const STREAM_SETTINGS& settings)
+{
+	Stop();
+
+	m_settings = settings;
+	if ((true == m_items.empty()) || (m_settings.chunkSize <= 0.0f))
+	{
+		return;
+	}
+
+	m_templateBytes.assign(m_templates.size(), 0);
+	for (size_t i = 0; i < m_templates.size(); i++)
+	{
+		for (const TEMPLATE_PART& part : m_templates[i])
+		{
+			const MeshGeometry::MESH_DATA& mesh = m_meshes[part.meshID];
+			m_templateBytes[i] += mesh.vertices.size() * sizeof(MeshGeometry::VERTEX) + mesh.indices.size() * sizeof(GLuint);
+		}
+	}
+
+	glm::vec2 minPoint(m_items[0].model[3].x, m_items[0].model[3].z);
+	glm::vec2 maxPoint = minPoint;
+	for (const STREAM_ITEM& item : m_items)
+	{
+		glm::vec2 position(item.model[3].x, item.model[3].z);
+		minPoint = glm::min(minPoint, position);
+		maxPoint = glm::max(maxPoint, position);
+	}
+
+	float chunkSize = m_settings.chunkSize;
+	int chunksX = (int)std::floor((maxPoint.x - minPoint.x) / chunkSize) + 1;
+	int chunksZ = (int)std::floor((maxPoint.y - minPoint.y) / chunkSize) + 1;
+
+	STREAM_CHUNK emptyChunk;
+	emptyChunk.firstItem = 0;
+	emptyChunk.itemCount = 0;
+	emptyChunk.bytes = 0;
+	emptyChunk.state = CHUNK_UNLOADED;
+	emptyChunk.pBake = NULL;
+	m_chunks.assign((size_t)chunksX * chunksZ, emptyChunk);
+	for (int chunkZ = 0; chunkZ < chunksZ; chunkZ++)
+	{
+		for (int chunkX = 0; chunkX < chunksX; chunkX++)
+		{
+			STREAM_CHUNK& chunk = m_chunks[chunkZ * chunksX + chunkX];
+			chunk.minPoint = minPoint + glm::vec2(chunkX * chunkSize, chunkZ * chunkSize);
+			chunk.maxPoint = chunk.minPoint + glm::vec2(chunkSize, chunkSize);
+		}
+	}
+
+	// count the items of every chunk, then move each item into
+	// the run of its chunk
+	std::vector<int> itemChunks(m_items.size());
+	for (size_t i = 0; i < m_items.size(); i++)
+	{
+		const STREAM_ITEM& item = m_items[i];
+		int chunkX = std::min((int)((item.model[3].x - minPoint.x) / chunkSize), chunksX - 1);
+		int chunkZ = std::min((int)((item.model[3].z - minPoint.y) / chunkSize), chunksZ - 1);
+		itemChunks[i] = chunkZ * chunksX + chunkX;
+
+		STREAM_CHUNK& chunk = m_chunks[itemChunks[i]];
+		chunk.itemCount++;
+		chunk.bytes += m_templateBytes[item.templateIndex];
+	}
+
+	int firstItem = 0;
+	for (STREAM_CHUNK& chunk : m_chunks)
+	{
+		chunk.firstItem = firstItem;
+		firstItem += chunk.itemCount;
+		if (chunk.itemCount > 0)
+		{
+			m_stats.chunks++;
+		}
+		if (chunk.bytes > m_settings.budgetBytes)
+		{
+			m_stats.chunksOverBudget++;
+		}
+	}
+
+	std::vector<STREAM_ITEM> sortedItems(m_items.size());
+	std::vector<int> nextItems(m_chunks.size());
+	for (size_t chunk = 0; chunk < m_chunks.size(); chunk++)
+	{
+		nextItems[chunk] = m_chunks[chunk].firstItem;
+	}
+	for (size_t i = 0; i < m_items.size(); i++)
+	{
+		sortedItems[nextItems[itemChunks[i]]++] = m_items[i];
+	}
+	m_items.swap(sortedItems);
+
+	int loaderThreads = (m_settings.loaderThreads > 0) ? m_settings.loaderThreads : 1;
+	for (int i = 0; i < loaderThreads; i++)
+	{
+		m_loaders.push_back(std::thread(&WorldStreamer::LoaderLoop, this));
+	}
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for bringing the loaded chunks up to
+ *  date with the camera position, once per frame on the
+ *  thread owning the OpenGL context. The merged chunks are
+ *  uploaded first, a few per call so a burst of them does
+ *  not stall a frame. The chunks outside the unload radius
+ *  are then freed, and the unloaded chunks inside the load
+ *  radius are queued nearest first, evicting chunks well
+ *  farther away while the budget is short.
+ ***********************************************************/
+bool WorldStreamer::Update(glm::vec3 cameraPosition)
+{
+	if (false == IsStarted())
+	{
+		return(false);
+	}
+
+	bool bChanged = false;
+
+	std::vector<std::pair<int, StaticGeometryBake*>> mergedChunks;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		int uploads = std::min((int)m_mergedChunks.size(), m_settings.maxUploadsPerUpdate);
+		mergedChunks.assign(m_mergedChunks.begin(), m_mergedChunks.begin() + uploads);
+		m_mergedChunks.erase(m_mergedChunks.begin(), m_mergedChunks.begin() + uploads);
+
+		// the queued chunks the camera moved away from are dropped
+		// before a loader takes them
+		for (std::deque<int>::iterator it = m_queuedChunks.begin(); it != m_queuedChunks.end();)
+		{
+			if (GetChunkDistance(*it, cameraPosition) > m_settings.unloadRadius)
+			{
+				m_chunks[*it].state = CHUNK_UNLOADED;
+				m_stats.residentBytes -= m_chunks[*it].bytes;
+				m_stats.chunksLoading--;
+				it = m_queuedChunks.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	for (const std::pair<int, StaticGeometryBake*>& merged : mergedChunks)
+	{
+		if (true == FinishChunk(merged.first, merged.second, cameraPosition))
+		{
+			bChanged = true;
+		}
+	}
+
+	int loadedIndex = 0;
+	while (loadedIndex < (int)m_loadedChunks.size())
+	{
+		int chunk = m_loadedChunks[loadedIndex];
+		if (GetChunkDistance(chunk, cameraPosition) > m_settings.unloadRadius)
+		{
+			UnloadChunk(chunk);
+			m_stats.unloads++;
+			bChanged = true;
+		}
+		else
+		{
+			loadedIndex++;
+		}
+	}
+
+	std::vector<std::pair<float, int>> wantedChunks;
+	for (int chunk = 0; chunk < (int)m_chunks.size(); chunk++)
+	{
+		if ((0 == m_chunks[chunk].itemCount) || (CHUNK_UNLOADED != m_chunks[chunk].state))
+		{
+			continue;
+		}
+
+		float distance = GetChunkDistance(chunk, cameraPosition);
+		if (distance <= m_settings.loadRadius)
+		{
+			wantedChunks.push_back(std::make_pair(distance, chunk));
+		}
+	}
+	std::sort(wantedChunks.begin(), wantedChunks.end());
+
+	bool bQueued = false;
+	for (const std::pair<float, int>& wanted : wantedChunks)
+	{
+		STREAM_CHUNK& chunk = m_chunks[wanted.second];
+
+		// a chunk larger than the whole budget is never loaded,
+		// and must not hold back the chunks behind it
+		if (chunk.bytes > m_settings.budgetBytes)
+		{
+			continue;
+		}
+
+		// only a chunk farther away than this one by the gap
+		// between the radii is evicted, so the two can not keep
+		// evicting each other while the camera moves back and forth
+		while (m_stats.residentBytes + chunk.bytes > m_settings.budgetBytes)
+		{
+			int farthestChunk = -1;
+			float farthestDistance = wanted.first + (m_settings.unloadRadius - m_settings.loadRadius);
+			for (int loadedChunk : m_loadedChunks)
+			{
+				float distance = GetChunkDistance(loadedChunk, cameraPosition);
+				if (distance > farthestDistance)
+				{
+					farthestChunk = loadedChunk;
+					farthestDistance = distance;
+				}
+			}
+
+			if (-1 == farthestChunk)
+			{
+				break;
+			}
+
+			UnloadChunk(farthestChunk);
+			m_stats.evictions++;
+			bChanged = true;
+		}
+
+		// the farther chunks wait until the nearer ones fit
+		if (m_stats.residentBytes + chunk.bytes > m_settings.budgetBytes)
+		{
+			break;
+		}
+
+		chunk.state = CHUNK_LOADING;
+		m_stats.residentBytes += chunk.bytes;
+		m_stats.chunksLoading++;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queuedChunks.push_back(wanted.second);
+		}
+		bQueued = true;
+	}
+
+	if (true == bQueued)
+	{
+		m_wakeLoaders.notify_all();
+	}
+
+	m_stats.chunksLoaded = (int)m_loadedChunks.size();
+	return(bChanged);
+}
+
+/***********************************************************
+ *  GetChunkDistance()
+ *
+ *  This method is used for getting the distance on the XZ
+ *  plane from the camera to the nearest point of a chunk,
+ *  0 when the camera is above it.
+ ***********************************************************/
+float WorldStreamer::GetChunkDistance(int chunk, glm::vec3 cameraPosition) const
+{
+	const STREAM_CHUNK& streamChunk = m_chunks[chunk];
+	glm::vec2 camera(cameraPosition.x, cameraPosition.z);
+	glm::vec2 offset = glm::max(glm::max(streamChunk.minPoint - camera, camera - streamChunk.maxPoint), glm::vec2(0.0f, 0.0f));
+	return(glm::length(offset));
+}
+
+/***********************************************************
+ *  MergeChunk()
+ *
+ *  This method is used for merging every part of every item
+ *  of a chunk into a new static bake, on a loader thread.
+ *  Only the CPU side of the bake is filled here.
+ ***********************************************************/
+StaticGeometryBake* WorldStreamer::MergeChunk(int chunk) const
+{
+	const STREAM_CHUNK& streamChunk = m_chunks[chunk];
+	StaticGeometryBake* pBake = new StaticGeometryBake();
+
+	for (int i = streamChunk.firstItem; i < streamChunk.firstItem + streamChunk.itemCount; i++)
+	{
+		const STREAM_ITEM& item = m_items[i];
+		for (const TEMPLATE_PART& part : m_templates[item.templateIndex])
+		{
+			pBake->AddObject(m_meshes[part.meshID], item.model * part.localModel, part.UVscale, part.key);
+		}
+	}
+
+	return(pBake);
+}
+
+/***********************************************************
+ *  FinishChunk()
+ *
+ *  This method is used for uploading the merged meshes of a
+ *  chunk and adding it to the loaded chunks. A chunk the
+ *  camera moved away from while it was merged is freed
+ *  instead, and false is returned.
+ ***********************************************************/
+bool WorldStreamer::FinishChunk(int chunk, StaticGeometryBake* pBake, glm::vec3 cameraPosition)
+{
+	STREAM_CHUNK& streamChunk = m_chunks[chunk];
+	m_stats.chunksLoading--;
+
+	if (GetChunkDistance(chunk, cameraPosition) > m_settings.unloadRadius)
+	{
+		delete pBake;
+		streamChunk.state = CHUNK_UNLOADED;
+		m_stats.residentBytes -= streamChunk.bytes;
+		return(false);
+	}
+
+	pBake->Upload();
+
+	streamChunk.bounds = pBake->GetBatchBounds(0);
+	for (int batch = 1; batch < pBake->GetBatchCount(); batch++)
+	{
+		MeshGeometry::MergeBounds(streamChunk.bounds, pBake->GetBatchBounds(batch));
+	}
+
+	streamChunk.state = CHUNK_LOADED;
+	streamChunk.pBake = pBake;
+	m_loadedChunks.push_back(chunk);
+	m_stats.loads++;
+	return(true);
+}
+
+/***********************************************************
+ *  UnloadChunk()
+ *
+ *  This method is used for freeing the merged meshes of a
+ *  loaded chunk and returning its bytes to the budget.
+ ***********************************************************/
+void WorldStreamer::UnloadChunk(int chunk)
+{
+	STREAM_CHUNK& streamChunk = m_chunks[chunk];
+
+	delete streamChunk.pBake;
+	streamChunk.pBake = NULL;
+	streamChunk.state = CHUNK_UNLOADED;
+	m_stats.residentBytes -= streamChunk.bytes;
+
+	m_loadedChunks.erase(std::find(m_loadedChunks.begin(), m_loadedChunks.end(), chunk));
+}
+
+/***********************************************************
+ *  LoaderLoop()
+ *
+ *  This method is used for running a loader thread. The
+ *  loader sleeps until a chunk is queued, merges it and
+ *  hands the result back to be uploaded.
+ ***********************************************************/
+void WorldStreamer::LoaderLoop()
+{
+	while (true)
+	{
+		int chunk = -1;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeLoaders.wait(lock, [&]() { return((true == m_bStop) || (false == m_queuedChunks.empty())); });
+			if (true == m_bStop)
+			{
+				return;
+			}
+
+			chunk = m_queuedChunks.front();
+			m_queuedChunks.pop_front();
+		}
+
+		StaticGeometryBake* pBake = MergeChunk(chunk);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_mergedChunks.push_back(std::make_pair(chunk, pBake));
+		}
+	}
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// worldstreamer.h
+// ============
+// load and unload fixed size chunks of a large world around the camera
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "StaticGeometryBake.h"
+
+#include <glm/glm.hpp>
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/***********************************************************
+ *  WorldStreamer
+ *
+ *  This class cuts the XZ plane into square chunks and keeps
+ *  only the chunks near the camera in memory. Every placed
+ *  item is a template - the parts of a house, windmill or
+ *  wall - and the model matrix of its placement, and goes
+ *  into the chunk holding its position.
+ *
+ *  A chunk is loaded on a loader thread, which merges the
+ *  parts of all its items into a static bake of its own,
+ *  and the merged meshes are uploaded on the calling thread
+ *  by Update(), a few chunks per call, since only the thread
+ *  owning the OpenGL context may create buffers.
+ *
+ *  The chunks are loaded nearest first while they fit into
+ *  the memory budget, making room by evicting loaded chunks
+ *  that are farther away. A chunk is loaded inside the load
+ *  radius but only unloaded outside the larger unload
+ *  radius, and only evicted for a chunk nearer by at least
+ *  the gap between the two, so a camera moving along a
+ *  chunk border does not load and unload the same chunks
+ *  over and over.
+ *
+ *  The templates and items must all be added before Start(),
+ *  after which the loader threads read them unlocked.
+ ***********************************************************/
+class WorldStreamer
+{
+public:
+	// how the world is cut into chunks and how many are kept
+	struct STREAM_SETTINGS
+	{
+		// length of the side of a chunk
+		float chunkSize;
+		// distance from the camera to the nearest point of a
+		// chunk under which it is loaded
+		float loadRadius;
+		// distance over which a loaded chunk is unloaded, more
+		// than the load radius
+		float unloadRadius;
+		// most bytes of merged vertex and index data kept by the
+		// loaded and loading chunks
+		size_t budgetBytes;
+		int loaderThreads;
+		// most chunks uploaded by one Update()
+		int maxUploadsPerUpdate;
+	};
+
+	// counters of the chunks, the loads, unloads and evictions
+	// counting up from Start()
+	struct STREAM_STATS
+	{
+		int chunks;
+		// chunks larger than the whole budget, never loaded
+		int chunksOverBudget;
+		int chunksLoaded;
+		int chunksLoading;
+		int loads;
+		int unloads;
+		int evictions;
+		size_t residentBytes;
+	};
+
+	// constructor
+	WorldStreamer();
+	// destructor
+	~WorldStreamer();
+
+	// settings of chunks about a city block in size, changed
+	// from the command line
+	static STREAM_SETTINGS GetDefaultSettings();
+
+	// stop the loader threads and remove every chunk, item
+	// and template
+	void Clear();
+	// keep a copy of a basic shape mesh the templates use
+	void SetMesh(int meshID, const MeshGeometry::MESH_DATA& mesh);
+	// add an empty template and get its index
+	int AddTemplate();
+	// add a part to a template, its model matrix relative to
+	// the placement of the items
+	void AddTemplatePart(
+		int templateIndex,
+		int meshID,
+		const glm::mat4& localModel,
+		const glm::vec2& UVscale,
+		const StaticGeometryBake::BAKE_KEY& key);
+	// place a template, the translation of the model matrix
+	// picking its chunk
+	void AddItem(int templateIndex, const glm::mat4& model);
+
+	// cut the items into chunks and start the loader threads
+	void Start(const STREAM_SETTINGS& settings);
+	// load and unload the chunks around the camera, and get
+	// whether the loaded chunks changed
+	bool Update(glm::vec3 cameraPosition);
+	bool IsStarted() const { return(false == m_loaders.empty()); }
+
+	// the chunks that are drawn, in the order they were loaded
+	const std::vector<int>& GetLoadedChunks() const { return(m_loadedChunks); }
+	const StaticGeometryBake& GetChunkBake(int chunk) const { return(*m_chunks[chunk].pBake); }
+	// world space box around the merged meshes of a loaded chunk
+	const MeshGeometry::MESH_BOUNDS& GetChunkBounds(int chunk) const { return(m_chunks[chunk].bounds); }
+	const STREAM_STATS& GetStats() const { return(m_stats); }
+
+private:
+	enum CHUNK_STATE
+	{
+		CHUNK_UNLOADED = 0,
+		// queued or being merged on a loader thread
+		CHUNK_LOADING,
+		CHUNK_LOADED
+	};
+
+	// one part of a template
+	struct TEMPLATE_PART
+	{
+		int meshID;
+		glm::mat4 localModel;
+		glm::vec2 UVscale;
+		StaticGeometryBake::BAKE_KEY key;
+	};
+
+	struct STREAM_ITEM
+	{
+		int templateIndex;
+		glm::mat4 model;
+	};
+
+	struct STREAM_CHUNK
+	{
+		// corners of the chunk on the XZ plane
+		glm::vec2 minPoint;
+		glm::vec2 maxPoint;
+		// run of the items of the chunk in the item order
+		int firstItem;
+		int itemCount;
+		// bytes of the merged meshes, known before the merge
+		size_t bytes;
+		// only changed on the calling thread
+		int state;
+		// merged meshes while the chunk is loaded, NULL otherwise
+		StaticGeometryBake* pBake;
+		MeshGeometry::MESH_BOUNDS bounds;
+	};
+
+	STREAM_SETTINGS m_settings;
+	std::vector<MeshGeometry::MESH_DATA> m_meshes;
+	// parts of every template, and the bytes they merge into
+	std::vector<std::vector<TEMPLATE_PART>> m_templates;
+	std::vector<size_t> m_templateBytes;
+	// items in the order they were added, then sorted by chunk
+	std::vector<STREAM_ITEM> m_items;
+	// chunks of the grid, row by row along X
+	std::vector<STREAM_CHUNK> m_chunks;
+	std::vector<int> m_loadedChunks;
+	STREAM_STATS m_stats;
+
+	std::vector<std::thread> m_loaders;
+	std::mutex m_mutex;
+	// signals the loaders that a chunk is queued, or to stop
+	std::condition_variable m_wakeLoaders;
+	bool m_bStop;
+	// chunks waiting for a loader
+	std::deque<int> m_queuedChunks;
+	// merged chunks waiting to be uploaded
+	std::vector<std::pair<int, StaticGeometryBake*>> m_mergedChunks;
+
+	// stop the loader threads and free every chunk
+	void Stop();
+	// distance on the XZ plane from the camera to a chunk
+	float GetChunkDistance(int chunk, glm::vec3 cameraPosition) const;
+	// merge the items of a chunk into a new static bake
+	StaticGeometryBake* MergeChunk(int chunk) const;
+	// upload a merged chunk, or drop it when the camera moved
+	// away while it was merged
+	bool FinishChunk(int chunk, StaticGeometryBake* pBake, glm::vec3 cameraPosition);
+	// free the merged meshes of a loaded chunk
+	void UnloadChunk(int chunk);
+	// wait for queued chunks and merge them
+	void LoaderLoop();
+};
@@ -1,228 +1,365 @@
-#version 330 core
-out vec4 fragmentColor;
-
-in vec3 fragmentPosition;
-in vec3 fragmentVertexNormal;
-in vec2 fragmentTextureCoordinate;
-
-struct Material {
-    vec3 diffuseColor;
-    vec3 specularColor;
-    float shininess;
-}; 
-
-struct DirectionalLight {
-    vec3 direction;
-	
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct PointLight {
-    vec3 position;
-    
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-  
-    float constant;
-    float linear;
-    float quadratic;
-  
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;       
-
-    bool bActive;
-};
-
-#define TOTAL_POINT_LIGHTS 5
-
-uniform bool bUseTexture=false;
-uniform bool bUseLighting=false;
-uniform vec4 objectColor = vec4(1.0f);
-uniform vec3 viewPosition;
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
-uniform SpotLight spotLight;
-uniform Material material;
-uniform sampler2D objectTexture;
-uniform vec2 UVscale = vec2(1.0f, 1.0f);
-
-// the scaled texture coordinate to use in calculations
-vec2 fragmentTextureCoordinateScaled = fragmentTextureCoordinate * UVscale;
-
-// function prototypes
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-
-void main()
-{   
-    if(bUseLighting == true)
-    {
-        vec3 phongResult = vec3(0.0f);
-        // properties
-        vec3 norm = normalize(fragmentVertexNormal);
-        vec3 viewDir = normalize(viewPosition - fragmentPosition);
-    
-        // == =====================================================
-        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
-        // For each phase, a calculate function is defined that calculates the corresponding color
-        // per light source. In the main() function we take all the calculated colors and sum them 
-        // up for this fragment's final color.
-        // == =====================================================
-        // phase 1: directional lighting
-        if(directionalLight.bActive == true)
-        {
-            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir);
-        }
-        // phase 2: point lights
-        for(int i = 0; i < TOTAL_POINT_LIGHTS; i++)
-        {
-	    if(pointLights[i].bActive == true)
-            {
-                phongResult += CalcPointLight(pointLights[i], norm, fragmentPosition, viewDir);   
-            }
-        } 
-        // phase 3: spot light
-        if(spotLight.bActive == true)
-        {
-            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir);    
-        }
-    
-        if(bUseTexture == true)
-        {
-            fragmentColor = vec4(phongResult, (texture(objectTexture, fragmentTextureCoordinateScaled)).a);
-        }
-        else
-        {
-            fragmentColor = vec4(phongResult, objectColor.a);
-        }
-    }
-    else
-    {
-        if(bUseTexture == true)
-        {
-            fragmentColor = texture(objectTexture, fragmentTextureCoordinateScaled);
-        }
-        else
-        {
-            fragmentColor = objectColor;
-        }
-    }
-}
-
-// calculates the color when using a directional light.
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDirection = normalize(-light.direction);
-    // diffuse shading
-    float diff = max(dot(normal, lightDirection), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDirection, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a point light.
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular= vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    // Calculate specular component
-    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-   
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a spot light.
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // attenuation
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
-    // spotlight intensity
-    float theta = dot(lightDir, normalize(-light.direction)); 
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    ambient *= attenuation * intensity;
-    diffuse *= attenuation * intensity;
-    specular *= attenuation * intensity;
-    return (ambient + diffuse + specular);
-}
+#version 330 core
+out vec4 fragmentColor;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in vec4 fragmentObjectColor;
+flat in vec2 fragmentUVscale;
+flat in int fragmentMaterialIndex;
+flat in int fragmentTextureLayer;
+flat in ivec2 fragmentLightRange;
+in float fragmentViewDepth;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+}; 
+
+struct DirectionalLight {
+    vec3 direction;
+	
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+// one entry of the point light list - std140 layout, the
+// range of the light is packed into the w of the position
+struct PointLight {
+    vec4 position;
+    
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+};
+
+struct SpotLight {
+    vec3 position;
+    vec3 direction;
+    float cutOff;
+    float outerCutOff;
+  
+    float constant;
+    float linear;
+    float quadratic;
+  
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;       
+
+    bool bActive;
+};
+
+#define MAX_MATERIALS 64
+// size of the light cluster grid - tiles across, tiles down
+// and depth slices
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
+
+// one entry of the material table - std140 layout, the
+// shininess is packed into the w of the specular color
+struct MaterialData {
+    vec4 diffuseColor;
+    vec4 specularColorShininess;
+};
+
+layout (std140) uniform MaterialBlock {
+    MaterialData materials[MAX_MATERIALS];
+};
+
+uniform bool bUseLighting=false;
+uniform vec3 viewPosition;
+uniform DirectionalLight directionalLight;
+uniform int pointLightCount = 0;
+uniform SpotLight spotLight;
+
+// the scene textures, one texture array per image size and
+// format - must match TextureArrays::MAX_BUCKETS
+#define MAX_TEXTURE_BUCKETS 8
+uniform sampler2DArray textureBuckets[MAX_TEXTURE_BUCKETS];
+
+// clustered lighting - the whole point light list as four
+// texels per light, the index list offset and light count of
+// every cluster, and the packed light indices
+uniform bool bUseClusteredLighting = false;
+uniform samplerBuffer pointLightData;
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterLightIndices;
+uniform vec2 clusterTileSize = vec2(1.0f);
+uniform vec2 clusterDepthScaleBias = vec2(0.0f);
+
+// per-object light lists - the indices of the point lights
+// reaching each drawn object, found once on the CPU. The
+// offset and count of this object's list come in with the
+// fragment, a negative count means the object has no list.
+uniform bool bUseObjectLightLists = false;
+uniform usamplerBuffer objectLightIndices;
+
+// the material of this draw, read from the material table in main()
+Material material;
+
+// the scaled texture coordinate to use in calculations
+vec2 fragmentTextureCoordinateScaled = fragmentTextureCoordinate * fragmentUVscale;
+
+// whether this draw is textured, and its texture color,
+// sampled once in main()
+bool bUseTexture;
+vec4 textureColor;
+
+// function prototypes
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+int FindLightCluster();
+PointLight FetchPointLight(int index);
+vec4 SampleObjectTexture();
+
+void main()
+{   
+    MaterialData materialData = materials[clamp(fragmentMaterialIndex, 0, MAX_MATERIALS - 1)];
+    material.diffuseColor = materialData.diffuseColor.rgb;
+    material.specularColor = materialData.specularColorShininess.rgb;
+    material.shininess = materialData.specularColorShininess.w;
+
+    // a negative layer reference means the draw uses its color
+    bUseTexture = (fragmentTextureLayer >= 0);
+    textureColor = vec4(1.0f);
+    if(bUseTexture == true)
+    {
+        textureColor = SampleObjectTexture();
+    }
+
+    if(bUseLighting == true)
+    {
+        vec3 phongResult = vec3(0.0f);
+        // properties
+        vec3 norm = normalize(fragmentVertexNormal);
+        vec3 viewDir = normalize(viewPosition - fragmentPosition);
+    
+        // == =====================================================
+        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
+        // For each phase, a calculate function is defined that calculates the corresponding color
+        // per light source. In the main() function we take all the calculated colors and sum them 
+        // up for this fragment's final color.
+        // == =====================================================
+        // phase 1: directional lighting
+        if(directionalLight.bActive == true)
+        {
+            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir);
+        }
+        // phase 2: point lights
+        if(bUseClusteredLighting == true)
+        {
+            // only the lights that reach into this fragment's cluster
+            uvec2 clusterLights = texelFetch(clusterGrid, FindLightCluster()).xy;
+            for(uint i = 0u; i < clusterLights.y; i++)
+            {
+                int lightIndex = int(texelFetch(clusterLightIndices, int(clusterLights.x + i)).r);
+                phongResult += CalcPointLight(FetchPointLight(lightIndex), norm, fragmentPosition, viewDir);
+            }
+        }
+        else if((bUseObjectLightLists == true) && (fragmentLightRange.y >= 0))
+        {
+            // only the lights that reach into this object's bounds
+            for(int i = 0; i < fragmentLightRange.y; i++)
+            {
+                int lightIndex = int(texelFetch(objectLightIndices, fragmentLightRange.x + i).r);
+                phongResult += CalcPointLight(FetchPointLight(lightIndex), norm, fragmentPosition, viewDir);
+            }
+        }
+        else
+        {
+            // every active light of the list
+            for(int i = 0; i < pointLightCount; i++)
+            {
+                phongResult += CalcPointLight(FetchPointLight(i), norm, fragmentPosition, viewDir);
+            }
+        }
+        // phase 3: spot light
+        if(spotLight.bActive == true)
+        {
+            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir);    
+        }
+    
+        if(bUseTexture == true)
+        {
+            fragmentColor = vec4(phongResult, textureColor.a);
+        }
+        else
+        {
+            fragmentColor = vec4(phongResult, fragmentObjectColor.a);
+        }
+    }
+    else
+    {
+        if(bUseTexture == true)
+        {
+            fragmentColor = textureColor;
+        }
+        else
+        {
+            fragmentColor = fragmentObjectColor;
+        }
+    }
+}
+
+// calculates the color when using a directional light.
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular = vec3(0.0f);
+
+    vec3 lightDirection = normalize(-light.direction);
+    // diffuse shading
+    float diff = max(dot(normal, lightDirection), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDirection, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient * vec3(textureColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(textureColor);
+        specular = light.specular * spec * material.specularColor * vec3(textureColor);
+    }
+    else
+    {
+        ambient = light.ambient * vec3(fragmentObjectColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(fragmentObjectColor);
+        specular = light.specular * spec * material.specularColor * vec3(fragmentObjectColor);
+    }
+    
+    return (ambient + diffuse + specular);
+}
+
+// calculates the color when using a point light.
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular= vec3(0.0f);
+
+    vec3 lightDir = normalize(light.position.xyz - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    // Calculate specular component
+    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // fade the light out smoothly to zero at its range
+    float distanceRatio = length(light.position.xyz - fragPos) / max(light.position.w, 0.0001);
+    float falloff = clamp(1.0 - pow(distanceRatio, 4.0), 0.0, 1.0);
+    float attenuation = falloff * falloff;
+   
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient.rgb * vec3(textureColor);
+        diffuse = light.diffuse.rgb * diff * material.diffuseColor * vec3(textureColor);
+        specular = light.specular.rgb * specularComponent * material.specularColor;
+    }
+    else
+    {
+        ambient = light.ambient.rgb * vec3(fragmentObjectColor);
+        diffuse = light.diffuse.rgb * diff * material.diffuseColor * vec3(fragmentObjectColor);
+        specular = light.specular.rgb * specularComponent * material.specularColor;
+    }
+    
+    return (ambient + diffuse + specular) * attenuation;
+}
+
+// calculates the color when using a spot light.
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular = vec3(0.0f);
+
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
+    // spotlight intensity
+    float theta = dot(lightDir, normalize(-light.direction)); 
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient * vec3(textureColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(textureColor);
+        specular = light.specular * spec * material.specularColor * vec3(textureColor);
+    }
+    else
+    {
+        ambient = light.ambient * vec3(fragmentObjectColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(fragmentObjectColor);
+        specular = light.specular * spec * material.specularColor * vec3(fragmentObjectColor);
+    }
+    
+    ambient *= attenuation * intensity;
+    diffuse *= attenuation * intensity;
+    specular *= attenuation * intensity;
+    return (ambient + diffuse + specular);
+}
+
+
+// finds the light cluster that holds this fragment.
+int FindLightCluster()
+{
+    ivec2 tile = ivec2(gl_FragCoord.xy / clusterTileSize);
+    int slice = int(log(max(fragmentViewDepth, 0.0001)) * clusterDepthScaleBias.x + clusterDepthScaleBias.y);
+
+    tile = clamp(tile, ivec2(0), ivec2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1));
+    slice = clamp(slice, 0, CLUSTER_GRID_Z - 1);
+
+    return tile.x + CLUSTER_GRID_X * (tile.y + CLUSTER_GRID_Y * slice);
+}
+
+// reads a light of the point light list from the texture buffer.
+PointLight FetchPointLight(int index)
+{
+    PointLight light;
+    light.position = texelFetch(pointLightData, index * 4);
+    light.ambient = texelFetch(pointLightData, index * 4 + 1);
+    light.diffuse = texelFetch(pointLightData, index * 4 + 2);
+    light.specular = texelFetch(pointLightData, index * 4 + 3);
+    return light;
+}
+
+// samples the texture of this draw. The layer reference
+// holds the texture array in the high bits and the layer in
+// the low bits. Sampler arrays only take constant indices in
+// GLSL 3.30, so the texture array is picked by a switch, with
+// the gradients taken outside of it.
+vec4 SampleObjectTexture()
+{
+    int bucket = fragmentTextureLayer >> 16;
+    vec3 coordinate = vec3(fragmentTextureCoordinateScaled, float(fragmentTextureLayer & 0xFFFF));
+    vec2 dx = dFdx(fragmentTextureCoordinateScaled);
+    vec2 dy = dFdy(fragmentTextureCoordinateScaled);
+
+    switch(bucket)
+    {
+        case 0: return textureGrad(textureBuckets[0], coordinate, dx, dy);
+        case 1: return textureGrad(textureBuckets[1], coordinate, dx, dy);
+        case 2: return textureGrad(textureBuckets[2], coordinate, dx, dy);
+        case 3: return textureGrad(textureBuckets[3], coordinate, dx, dy);
+        case 4: return textureGrad(textureBuckets[4], coordinate, dx, dy);
+        case 5: return textureGrad(textureBuckets[5], coordinate, dx, dy);
+        case 6: return textureGrad(textureBuckets[6], coordinate, dx, dy);
+        case 7: return textureGrad(textureBuckets[7], coordinate, dx, dy);
+    }
+    return vec4(1.0f);
+}
\ No newline at end of file
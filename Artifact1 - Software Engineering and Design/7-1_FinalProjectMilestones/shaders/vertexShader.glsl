@@ -1,20 +1,79 @@
-#version 330 core
-layout (location = 0) in vec3 inVertexPosition;
-layout (location = 1) in vec3 inVertexNormal;
-layout (location = 2) in vec2 inTextureCoordinate;
-
-out vec3 fragmentPosition;
-out vec3 fragmentVertexNormal;
-out vec2 fragmentTextureCoordinate;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-   fragmentPosition = vec3(model * vec4(inVertexPosition, 1.0));
-   gl_Position = projection * view * model * vec4(inVertexPosition, 1.0f);
-   fragmentVertexNormal = inVertexNormal;
-   fragmentTextureCoordinate = inTextureCoordinate;
+#version 330 core
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+// per-instance attributes, only read when bUseInstancing is true
+layout (location = 3) in mat4 inInstanceModel;
+layout (location = 7) in vec4 inInstanceColor;
+layout (location = 8) in vec2 inInstanceUVscale;
+// per-draw ID, only read when bUseIndirectDraw is true
+layout (location = 9) in uint inDrawID;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+flat out vec4 fragmentObjectColor;
+flat out vec2 fragmentUVscale;
+flat out int fragmentMaterialIndex;
+flat out int fragmentTextureLayer;
+flat out ivec2 fragmentLightRange;
+out float fragmentViewDepth;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform bool bUseInstancing = false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+uniform int materialIndex = 0;
+// texture array and layer of the draw, -1 when drawn with the color
+uniform int textureLayer = -1;
+// offset and count of the object's point light list, a
+// negative count when the object has no list
+uniform ivec2 objectLightRange = ivec2(0, -1);
+uniform bool bUseIndirectDraw = false;
+// per-draw values of the indirect draws - seven texels per
+// draw: the model matrix columns, the color, the UV scale with
+// the material index and the texture layer, and the point
+// light list. The draws of this frame start at draw
+// drawDataFirst of the ring buffer.
+uniform samplerBuffer drawData;
+uniform int drawDataFirst = 0;
+
+void main()
+{
+   mat4 modelMatrix = model;
+   fragmentObjectColor = objectColor;
+   fragmentUVscale = UVscale;
+   fragmentMaterialIndex = materialIndex;
+   fragmentTextureLayer = textureLayer;
+   fragmentLightRange = objectLightRange;
+   if(bUseInstancing == true)
+   {
+      modelMatrix = inInstanceModel;
+      fragmentObjectColor = inInstanceColor;
+      fragmentUVscale = inInstanceUVscale;
+   }
+   else if(bUseIndirectDraw == true)
+   {
+      int texel = (drawDataFirst + int(inDrawID)) * 7;
+      modelMatrix = mat4(
+         texelFetch(drawData, texel),
+         texelFetch(drawData, texel + 1),
+         texelFetch(drawData, texel + 2),
+         texelFetch(drawData, texel + 3));
+      fragmentObjectColor = texelFetch(drawData, texel + 4);
+      vec4 UVscaleMaterialLayer = texelFetch(drawData, texel + 5);
+      fragmentUVscale = UVscaleMaterialLayer.xy;
+      fragmentMaterialIndex = int(UVscaleMaterialLayer.z);
+      fragmentTextureLayer = int(UVscaleMaterialLayer.w);
+      fragmentLightRange = ivec2(texelFetch(drawData, texel + 6).xy);
+   }
+
+   fragmentPosition = vec3(modelMatrix * vec4(inVertexPosition, 1.0));
+   // distance along the view direction, used to find the light cluster
+   fragmentViewDepth = -(view * vec4(fragmentPosition, 1.0)).z;
+   gl_Position = projection * view * modelMatrix * vec4(inVertexPosition, 1.0f);
+   fragmentVertexNormal = inVertexNormal;
+   fragmentTextureCoordinate = inTextureCoordinate;
 }
\ No newline at end of file